@@ -0,0 +1,135 @@
+#ifndef ALIAS_TABLE_H
+#define ALIAS_TABLE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace rogue
+{
+    namespace utilities
+    {
+        // Walker's alias method (Vose's construction) over a fixed discrete distribution.
+        // Each sample costs one random number, one table lookup, and a compare with no
+        // transcendental math or rejection loop. The low 32 bits of the random number pick the
+        // column and the high 32 bits decide between the column and its alias.
+        class AliasTable
+        {
+        public:
+            explicit AliasTable(const std::vector<double>& weights) :
+                m_columns(weights.size())
+            {
+                if(weights.empty() || weights.size() > std::numeric_limits<uint32_t>::max())
+                {
+                    throw std::invalid_argument{ "Alias table needs between 1 and 2^32 - 1 weights." };
+                }
+
+                double total{ 0 };
+                for(const double weight : weights)
+                {
+                    total += weight;
+                }
+
+                const uint64_t size{ weights.size() };
+                std::vector<double> scaled(size);
+                std::vector<uint32_t> small{};
+                std::vector<uint32_t> large{};
+                for(uint64_t index{ 0 }; index < size; ++index)
+                {
+                    scaled[index] = weights[index] / total * size;
+                    (scaled[index] < 1.0 ? small : large).push_back(static_cast<uint32_t>(index));
+                }
+
+                while(!small.empty() && !large.empty())
+                {
+                    const uint32_t less{ small.back() };
+                    small.pop_back();
+                    const uint32_t more{ large.back() };
+                    m_columns[less] = { threshold(scaled[less]), more };
+                    scaled[more] -= 1.0 - scaled[less];
+                    if(scaled[more] < 1.0)
+                    {
+                        large.pop_back();
+                        small.push_back(more);
+                    }
+                }
+
+                // Leftovers are 1 up to rounding error and always keep their own column.
+                for(const std::vector<uint32_t>* remaining : { &small, &large })
+                {
+                    for(const uint32_t index : *remaining)
+                    {
+                        m_columns[index] = { std::numeric_limits<uint32_t>::max(), index };
+                    }
+                }
+            }
+
+            uint64_t size() const { return m_columns.size(); }
+
+            uint64_t sample(const uint64_t random) const
+            {
+                const uint64_t index{ ((random & 0xFFFFFFFF) * m_columns.size()) >> 32 };
+                const Column& column{ m_columns[index] };
+                return static_cast<uint32_t>(random >> 32) < column.threshold ? index : column.alias;
+            }
+
+            template<typename Engine>
+            void fill(std::span<uint64_t> output, Engine& engine) const
+            {
+                for(uint64_t& value : output)
+                {
+                    value = sample(engine());
+                }
+            }
+
+            // Zipfian over ranks 1..elements returned as indexes 0..elements - 1. Tables are built
+            // once per parameter set and shared by all workers.
+            static std::shared_ptr<const AliasTable> zipfian(
+                const uint64_t elements,
+                const double exponent)
+            {
+                static std::mutex mutex{};
+                static std::map<std::pair<uint64_t, double>, std::shared_ptr<const AliasTable>> cache{};
+
+                std::scoped_lock lock{ mutex };
+                std::shared_ptr<const AliasTable>& table{ cache[{ elements, exponent }] };
+                if(!table)
+                {
+                    std::vector<double> weights(elements);
+                    for(uint64_t rank{ 1 }; rank <= elements; ++rank)
+                    {
+                        weights[rank - 1] = std::pow(static_cast<double>(rank), -exponent);
+                    }
+                    table = std::make_shared<const AliasTable>(weights);
+                }
+                return table;
+            }
+
+        private:
+            // Interleaved so a sample touches a single cache line.
+            struct Column
+            {
+                uint32_t threshold;
+                uint32_t alias;
+            };
+
+            static uint32_t threshold(const double probability)
+            {
+                return static_cast<uint32_t>(std::min(
+                    probability * 4294967296.0, static_cast<double>(std::numeric_limits<uint32_t>::max())));
+            }
+
+            std::vector<Column> m_columns;
+        };
+    }
+}
+
+#endif //ALIAS_TABLE_H
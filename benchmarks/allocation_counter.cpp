@@ -0,0 +1,115 @@
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#include "benchmarks/allocation_counter.h"
+
+namespace
+{
+    // Each thread adds to its own cache line. Threads beyond SLOT_COUNT share slots, which
+    // only costs contention, never counts.
+    constexpr uint64_t SLOT_COUNT{ 256 };
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> count{ 0 };
+    };
+    std::array<Slot, SLOT_COUNT> slots{};
+    std::atomic<uint64_t> nextSlot{ 0 };
+    thread_local uint64_t threadCount{ 0 };
+
+    void count()
+    {
+        thread_local Slot& slot{ slots[nextSlot.fetch_add(1, std::memory_order_relaxed) % SLOT_COUNT] };
+        slot.count.fetch_add(1, std::memory_order_relaxed);
+        ++threadCount;
+    }
+
+    void* allocate(const std::size_t size)
+    {
+        count();
+        if(void* pointer{ std::malloc(size == 0 ? 1 : size) })
+        {
+            return pointer;
+        }
+        throw std::bad_alloc{};
+    }
+
+    void* allocate(const std::size_t size, const std::align_val_t alignment)
+    {
+        count();
+        const std::size_t align{ static_cast<std::size_t>(alignment) };
+        // aligned_alloc needs a multiple of the alignment.
+        if(void* pointer{ std::aligned_alloc(align, ((size == 0 ? 1 : size) + align - 1) / align * align) })
+        {
+            return pointer;
+        }
+        throw std::bad_alloc{};
+    }
+}
+
+uint64_t rogue::benchmarks::allocations()
+{
+    uint64_t total{ 0 };
+    for(const Slot& slot : slots)
+    {
+        total += slot.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t rogue::benchmarks::threadAllocations()
+{
+    return threadCount;
+}
+
+void rogue::benchmarks::SteadyState::finish() const
+{
+    if(m_strict && m_allocated > 0)
+    {
+        std::cout << std::format("{} allocated {} times building {} steady-state requests.",
+            m_loop, m_allocated, m_operations - WARM_OPERATIONS) << std::endl;
+        throw std::runtime_error{ "Steady-state loop allocated." };
+    }
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocate(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size); } catch(const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size); } catch(const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, alignment); } catch(const std::bad_alloc&) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    try { return allocate(size, alignment); } catch(const std::bad_alloc&) { return nullptr; }
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
@@ -0,0 +1,57 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Allocations through operator new, counted by the replacement operator new in
+        // allocation_counter.cpp. This includes gRPC's C++ internals but not gpr_malloc.
+        uint64_t allocations();
+        uint64_t threadAllocations();
+
+        // Allocations of a worker while it builds requests, from building until built. The
+        // first WARM_OPERATIONS requests may allocate while reused messages grow to size. Any
+        // allocation after that fails the run in strict mode (allocations = strict). Writes are
+        // left out since the sync API allocates inside gRPC for every message.
+        class SteadyState
+        {
+        public:
+            static constexpr uint64_t WARM_OPERATIONS{ 100 };
+
+            SteadyState(const bool strict, std::string loop) :
+                m_strict{ strict },
+                m_loop{ std::move(loop) }
+            {}
+
+            void building()
+            {
+                ++m_operations;
+                m_mark = threadAllocations();
+            }
+
+            void built()
+            {
+                if(m_operations > WARM_OPERATIONS)
+                {
+                    m_allocated += threadAllocations() - m_mark;
+                }
+            }
+
+            void finish() const;
+
+        private:
+            const bool m_strict;
+            const std::string m_loop;
+            uint64_t m_operations{ 0 };
+            uint64_t m_mark{ 0 };
+            uint64_t m_allocated{ 0 };
+        };
+    }
+}
+
+#endif //ALLOCATION_COUNTER_H
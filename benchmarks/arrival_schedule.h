@@ -0,0 +1,106 @@
+#ifndef ARRIVAL_SCHEDULE_H
+#define ARRIVAL_SCHEDULE_H
+
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        enum class ArrivalProcess
+        {
+            CLOSED_LOOP, // Send as fast as the stream accepts.
+            FIXED_INTERVAL,
+            POISSON
+        };
+
+        struct LoadMode
+        {
+            ArrivalProcess process{ ArrivalProcess::CLOSED_LOOP };
+            double operationsPerSecond{ 0 }; // Target across all workers.
+
+            // Closed-loop runs keep their original benchmark names.
+            std::string label(const std::string& benchmark) const
+            {
+                switch(process)
+                {
+                    case ArrivalProcess::FIXED_INTERVAL:
+                        return std::format("{} - Open Loop Fixed {:.0f} op/s", benchmark, operationsPerSecond);
+                    case ArrivalProcess::POISSON:
+                        return std::format("{} - Open Loop Poisson {:.0f} op/s", benchmark, operationsPerSecond);
+                    default:
+                        return benchmark;
+                }
+            }
+        };
+
+        // Per-worker schedule of intended send times for open-loop load.
+        // Requests are due at a constant rate regardless of how quickly the server responds.
+        // When a Write blocks past the next due time, the following requests are sent
+        // immediately to catch up, and latency measured from the intended send time
+        // includes the time spent queued behind the stall (ie. no coordinated omission).
+        class ArrivalSchedule
+        {
+        public:
+            // seed drives the Poisson gaps, eg. spec.seedFor(worker), so open-loop runs
+            // replay like every other random source.
+            ArrivalSchedule(
+                const LoadMode& load,
+                const uint64_t workers,
+                const uint64_t batchSize,
+                const uint64_t seed) :
+                m_process{ load.process },
+                m_interval{ load.process == ArrivalProcess::CLOSED_LOOP || load.operationsPerSecond <= 0
+                    ? 0.0
+                    : static_cast<double>(batchSize * workers) / load.operationsPerSecond },
+                m_exponential{ m_interval > 0 ? 1.0 / m_interval : 1.0 },
+                m_generator{ seed }
+            {
+                if(m_interval <= 0)
+                {
+                    m_process = ArrivalProcess::CLOSED_LOOP;
+                }
+            }
+
+            void start()
+            {
+                m_due = std::chrono::steady_clock::now();
+            }
+
+            // Blocks until the next request is due and returns its intended send time.
+            // In closed-loop mode it returns immediately with the current time.
+            std::chrono::steady_clock::time_point next()
+            {
+                if(m_process == ArrivalProcess::CLOSED_LOOP)
+                {
+                    return std::chrono::steady_clock::now();
+                }
+
+                const double seconds{ m_process == ArrivalProcess::POISSON
+                    ? m_exponential(m_generator)
+                    : m_interval };
+                m_due += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(seconds));
+                if(std::chrono::steady_clock::now() < m_due)
+                {
+                    std::this_thread::sleep_until(m_due);
+                }
+                return m_due;
+            }
+
+        private:
+            ArrivalProcess m_process;
+            const double m_interval; // Seconds between requests of this worker.
+            std::exponential_distribution<double> m_exponential;
+            std::mt19937_64 m_generator;
+            std::chrono::steady_clock::time_point m_due{ std::chrono::steady_clock::now() };
+        };
+    }
+}
+
+#endif //ARRIVAL_SCHEDULE_H
@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "benchmarks/benchmark_runner.h"
+#include "benchmarks/common.h"
+
+namespace
+{
+    rogue::benchmarks::WorkloadSpec warmupSpec(const rogue::benchmarks::WorkloadSpec& spec)
+    {
+        rogue::benchmarks::WorkloadSpec warmup{ spec };
+        warmup.operationCount = spec.warmupOperations > 0 ? spec.warmupOperations : spec.operationCount;
+        warmup.maxExecutionTime = std::chrono::seconds{ 0 };
+        return warmup;
+    }
+}
+
+double rogue::benchmarks::Measurement::operationsPerSecond() const
+{
+    const double seconds{ std::chrono::duration<double>(finish - start).count() };
+    return seconds > 0 ? (readOperations + writeOperations) / seconds : 0;
+}
+
+std::string rogue::benchmarks::repetitionsFile(const std::string& filename)
+{
+    return std::filesystem::path{ filename }.replace_extension().string() + "_REPETITIONS.md";
+}
+
+double rogue::benchmarks::repeat(
+    const WorkloadSpec& spec,
+    const std::string& filename,
+    const std::string& benchmark,
+    const std::function<Measurement(const WorkloadSpec&, TimeSeries&)>& run)
+{
+    if(spec.warmupOperations > 0 || spec.warmupTime.count() > 0)
+    {
+        const WorkloadSpec warmup{ warmupSpec(spec) };
+        const auto deadline{ std::chrono::steady_clock::now() + spec.warmupTime };
+        do
+        {
+            TimeSeries series{ spec.reportInterval };
+            run(warmup, series);
+        } while(std::chrono::steady_clock::now() < deadline);
+    }
+
+    std::vector<double> throughputs{};
+    Measurement pooled{};
+    ResourceCounters counters{ spec.hardwareCounters };
+    ResourceUsage resources{};
+    std::chrono::system_clock::duration measured{ 0 };
+    RepetitionSummary summary{};
+    std::unique_ptr<TimeSeries> series{};
+    for(uint64_t repetition{ 0 }; repetition < spec.repetitions; ++repetition)
+    {
+        // Includes the setup of each run, eg. opening channels, as runs measure themselves.
+        series = std::make_unique<TimeSeries>(spec.reportInterval);
+        counters.start();
+        const Measurement measurement{ run(spec, *series) };
+        const ResourceUsage usage{ counters.stop() };
+        resources += measurement.resources.value_or(usage);
+        throughputs.push_back(measurement.operationsPerSecond());
+        std::cout << std::format("{} run {}: {:.2f} op/s", benchmark, repetition + 1, throughputs.back()) << std::endl;
+
+        if(repetition == 0)
+        {
+            pooled.start = measurement.start;
+        }
+        measured += measurement.finish - measurement.start;
+        pooled.readOperations += measurement.readOperations;
+        pooled.writeOperations += measurement.writeOperations;
+        pooled.latencies.merge(measurement.latencies);
+
+        summary = summarize(throughputs);
+        // One run has no interval to converge, so at least two are taken before stopping early.
+        if(throughputs.size() >= std::max<uint64_t>(2, spec.minRepetitions) && summary.halfWidth <= spec.targetPrecision * summary.mean)
+        {
+            break;
+        }
+    }
+
+    // Throughput of the table row is the pooled operations over the pooled measured time.
+    pooled.finish = pooled.start + measured;
+    logBenchmark(filename, benchmark, pooled.start, pooled.finish,
+        pooled.readOperations, pooled.writeOperations, pooled.latencies, series.get(), &resources, throughputs);
+
+    const std::string path{ repetitionsFile(filename) };
+    const bool created{ !std::filesystem::exists(path) };
+    std::ofstream output{ path, std::ios::app };
+    if(created)
+    {
+        output << "| Benchmark | Runs | Mean | Std Dev | 95% CI | CI / Mean |\n";
+        output << "| --- | ---: | ---: | ---: | ---: | ---: |\n";
+    }
+    output << std::format(
+        std::locale(std::locale{}, new CommaPunctuation{}),
+        "| {} | {} | {:.2Lf} op/s | {:.2Lf} op/s | ± {:.2Lf} op/s | {:.2Lf}% |\n",
+        benchmark, summary.runs, summary.mean, summary.standardDeviation, summary.halfWidth,
+        summary.mean > 0 ? 100.0 * summary.halfWidth / summary.mean : 0.0);
+    return summary.mean;
+}
@@ -0,0 +1,60 @@
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "benchmarks/latency_histogram.h"
+#include "benchmarks/resource_usage.h"
+#include "benchmarks/statistics.h"
+#include "benchmarks/time_series.h"
+#include "benchmarks/workload_spec.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Result of a single run of a benchmark, logged by the runner instead of the benchmark.
+        struct Measurement
+        {
+            std::chrono::system_clock::time_point start;
+            std::chrono::system_clock::time_point finish;
+            uint64_t readOperations;
+            uint64_t writeOperations;
+            LatencyHistogram latencies;
+            // Usage of the measured part alone, for runs whose setup must not count, eg. loading
+            // initial data. The runner counts the whole run when it is not set.
+            std::optional<ResourceUsage> resources{};
+
+            double operationsPerSecond() const;
+        };
+
+        // eg. GRPC_BENCHMARKS.md -> GRPC_BENCHMARKS_REPETITIONS.md
+        std::string repetitionsFile(const std::string& filename);
+
+        // Runs one benchmark configuration:
+        // 1. Warm-up passes with operationcount = warmupoperations, or the measured
+        //    operationcount when it is 0, until warmuptime has passed. At least one pass runs
+        //    when either is set. Their measurements are discarded.
+        // 2. Up to repetitions measured runs. After minrepetitions, and at least two runs, stops
+        //    as soon as the 95% confidence interval of the throughput is within targetprecision
+        //    of the mean.
+        // Logs the pooled runs to the table, the per-run statistics to the repetitions table and
+        // the resource usage of the measured runs to the resources table.
+        // Every run gets a TimeSeries of spec.reportInterval. The run attaches its histograms,
+        // starts the series when its workers are released and stops it once they finished.
+        // The series of the last measured run is written beside the table.
+        // Returns the mean throughput.
+        double repeat(
+            const WorkloadSpec& spec,
+            const std::string& filename,
+            const std::string& benchmark,
+            const std::function<Measurement(const WorkloadSpec&, TimeSeries&)>& run);
+    }
+}
+
+#endif //BENCHMARK_RUNNER_H
@@ -0,0 +1,126 @@
+#ifndef BIDI_STREAM_H
+#define BIDI_STREAM_H
+
+#include <coroutine>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/client_callback.h>
+
+#include "benchmarks/scheduler.h"
+#include "protos/queries.pb.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // RogueDB bidi stream on the callback API with awaitable operations for Tasks:
+        //
+        //     while(co_await stream.write(search)) {}
+        //     co_await stream.writesDone();
+        //     const grpc::Status status{ co_await stream.finish() };
+        //
+        // One write (or writesDone) and one read may be pending at a time, so a writer and a
+        // reader task can share a stream. Completions are resumed through the scheduler, never
+        // inline on gRPC's callback threads. Call finish exactly once, after the last operation.
+        template<typename Request>
+        class BidiStream : public grpc::ClientBidiReactor<Request, rogue::services::Response>
+        {
+        public:
+            using Response = rogue::services::Response;
+            using Reactor = grpc::ClientBidiReactor<Request, Response>;
+
+            // Start opens the call through a stub's async interface, eg.
+            // [&](grpc::ClientContext* context, auto* reactor){ stub->async()->search(context, reactor); }
+            template<typename Start>
+            BidiStream(Scheduler& scheduler, Start&& start) :
+                m_scheduler{ scheduler }
+            {
+                start(&m_context, static_cast<Reactor*>(this));
+                // Keeps OnDone back until finish is awaited, so an early close by the server
+                // only fails the pending operations.
+                this->AddHold();
+                this->StartCall();
+            }
+
+            // Resumes with whether the request was written. The request must outlive the write.
+            auto write(const Request& request)
+            {
+                return Awaiter{ m_written, [this, &request](){ this->StartWrite(&request); } };
+            }
+
+            auto writesDone()
+            {
+                return Awaiter{ m_written, [this](){ this->StartWritesDone(); } };
+            }
+
+            // Resumes with false once the server closed the stream.
+            auto read(Response& response)
+            {
+                return Awaiter{ m_read, [this, &response](){ this->StartRead(&response); } };
+            }
+
+            auto finish()
+            {
+                return FinishAwaiter{ *this };
+            }
+
+            void OnWriteDone(bool ok) override { complete(m_written, ok); }
+            void OnWritesDoneDone(bool ok) override { complete(m_written, ok); }
+            void OnReadDone(bool ok) override { complete(m_read, ok); }
+            void OnDone(const grpc::Status& status) override
+            {
+                m_status = status;
+                complete(m_finished, status.ok());
+            }
+
+        private:
+            struct Completion
+            {
+                std::coroutine_handle<> handle{};
+                bool ok{ false };
+            };
+
+            template<typename Begin>
+            struct Awaiter
+            {
+                Completion& completion;
+                Begin begin;
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle)
+                {
+                    completion.handle = handle;
+                    begin();
+                }
+                bool await_resume() const noexcept { return completion.ok; }
+            };
+
+            struct FinishAwaiter
+            {
+                BidiStream& stream;
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle)
+                {
+                    stream.m_finished.handle = handle;
+                    stream.RemoveHold();
+                }
+                grpc::Status await_resume() const { return stream.m_status; }
+            };
+
+            void complete(Completion& completion, const bool ok)
+            {
+                completion.ok = ok;
+                m_scheduler.schedule(completion.handle);
+            }
+
+            Scheduler& m_scheduler;
+            grpc::ClientContext m_context{};
+            Completion m_written{};
+            Completion m_read{};
+            Completion m_finished{};
+            grpc::Status m_status{};
+        };
+    }
+}
+
+#endif //BIDI_STREAM_H
@@ -0,0 +1,46 @@
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "benchmarks/client_styles.h"
+#include "benchmarks/executor.h"
+
+rogue::benchmarks::ClientStyle rogue::benchmarks::parseClientStyle(const std::string& style)
+{
+    if(style == "sync")
+    {
+        return ClientStyle::SYNC;
+    }
+    if(style == "callback")
+    {
+        return ClientStyle::CALLBACK;
+    }
+    if(style == "async")
+    {
+        return ClientStyle::ASYNC;
+    }
+    throw std::invalid_argument{ std::format("Client style must be sync, callback, or async: {}", style) };
+}
+
+std::string rogue::benchmarks::clientStyleName(const ClientStyle style)
+{
+    switch(style)
+    {
+        case ClientStyle::SYNC:
+            return "Sync";
+        case ClientStyle::CALLBACK:
+            return "Callback";
+        case ClientStyle::ASYNC:
+            return "Async";
+    }
+    return "";
+}
+
+uint64_t rogue::benchmarks::styleStreams(const ClientStyle style, const uint64_t streams, const uint64_t pollers)
+{
+    if(style != ClientStyle::SYNC)
+    {
+        return streams;
+    }
+    return std::min(streams, std::clamp(pollers, uint64_t{1}, static_cast<uint64_t>(executor().get_thread_count())));
+}
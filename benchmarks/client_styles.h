@@ -0,0 +1,338 @@
+#ifndef CLIENT_STYLES_H
+#define CLIENT_STYLES_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/client_callback.h>
+
+#include "benchmarks/bidi_stream.h"
+#include "benchmarks/executor.h"
+#include "benchmarks/latency_histogram.h"
+#include "benchmarks/scheduler.h"
+#include "benchmarks/stream_engine.h"
+#include "benchmarks/time_series.h"
+#include "benchmarks/workload_spec.h"
+#include "protos/queries.pb.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // gRPC client API the streams of a workload are driven with.
+        enum class ClientStyle
+        {
+            SYNC,
+            CALLBACK,
+            ASYNC
+        };
+
+        // sync, callback, or async. Throws std::invalid_argument otherwise.
+        ClientStyle parseClientStyle(const std::string& style);
+        std::string clientStyleName(const ClientStyle style);
+        // Streams a ClientStyleRunner opens in the style for the requested streams. A sync
+        // stream blocks its thread, so sync opens one per poller at most, capped by the
+        // executor's threads.
+        uint64_t styleStreams(const ClientStyle style, const uint64_t streams, const uint64_t pollers);
+
+        // Opens the stream with the given index in each style, eg. for search:
+        //  - sync: stub->search(context)
+        //  - callback: stub->async()->search(context, reactor)
+        //  - async: stub->PrepareAsyncsearch(context, queue)
+        template<typename Request>
+        struct ClientCalls
+        {
+            using Response = rogue::services::Response;
+
+            std::function<std::unique_ptr<grpc::ClientReaderWriter<Request, Response>>(grpc::ClientContext*, const uint64_t)> sync;
+            std::function<void(grpc::ClientContext*, grpc::ClientBidiReactor<Request, Response>*, const uint64_t)> callback;
+            typename StreamEngine<Request>::Prepare async;
+        };
+
+        // Runs the same streams under any ClientStyle. Requests, windows, and latencies follow
+        // StreamEngine, so the styles only differ by how the client waits on gRPC:
+        //  - sync: options.pollers executor threads, each blocked in Write or Read of one
+        //    stream. The operations of all options.streams are split over those streams.
+        //  - callback: a reactor per stream, resumed on options.pollers scheduler threads.
+        //  - async: StreamEngine itself, options.pollers threads polling completion queues.
+        // Sync and callback streams alternate between writing and reading on one thread of
+        // control, reading only once the window is full or the stream is done writing.
+        // Latencies go to one histogram per thread, so memory does not grow with the streams.
+        // They are created with the runner, so a TimeSeries can be attached before the run.
+        template<typename Request>
+        class ClientStyleRunner
+        {
+        public:
+            using Response = rogue::services::Response;
+            using Engine = StreamEngine<Request>;
+
+            ClientStyleRunner(
+                const WorkloadSpec& spec,
+                const typename Engine::Options& options,
+                const ClientStyle style,
+                ClientCalls<Request> calls,
+                typename Engine::Next next) :
+                m_spec{ spec },
+                m_options{ options },
+                m_style{ style },
+                m_calls{ std::move(calls) },
+                m_next{ std::move(next) },
+                m_syncOptions{ options }
+            {
+                switch(m_style)
+                {
+                    case ClientStyle::SYNC:
+                        m_syncOptions.streams = styleStreams(ClientStyle::SYNC, m_options.streams, m_options.pollers);
+                        m_syncOptions.operationsPerStream = m_syncOptions.streams == 0 ? 0
+                            : m_options.operationsPerStream * m_options.streams / m_syncOptions.streams;
+                        m_histograms = std::vector<LatencyHistogram>(m_syncOptions.streams);
+                        break;
+                    case ClientStyle::CALLBACK:
+                        m_histograms = std::vector<LatencyHistogram>(std::max<uint64_t>(m_options.pollers, 1));
+                        break;
+                    case ClientStyle::ASYNC:
+                        m_engine = std::make_unique<Engine>(m_spec, m_options, m_calls.async, m_next);
+                        break;
+                }
+            }
+
+            // Only before run. See TimeSeries::attach.
+            void attach(TimeSeries& series)
+            {
+                if(m_engine)
+                {
+                    m_engine->attach(series);
+                    return;
+                }
+                series.attachAll(m_histograms);
+            }
+
+            // Blocks until every stream finished.
+            void run()
+            {
+                switch(m_style)
+                {
+                    case ClientStyle::SYNC:
+                        runSync();
+                        break;
+                    case ClientStyle::CALLBACK:
+                        runCallback();
+                        break;
+                    case ClientStyle::ASYNC:
+                        m_engine->run();
+                        m_errors += m_engine->errors();
+                        break;
+                }
+            }
+
+            LatencyHistogram histogram() const
+            {
+                if(m_engine)
+                {
+                    return m_engine->histogram();
+                }
+                LatencyHistogram merged{};
+                for(const auto& histogram : m_histograms)
+                {
+                    merged.merge(histogram);
+                }
+                return merged;
+            }
+
+            uint64_t errors() const { return m_errors.load(); }
+
+        private:
+            // Progress of one stream, shared by the sync and callback loops.
+            struct StreamState
+            {
+                StreamState(
+                    const WorkloadSpec& spec,
+                    const typename Engine::Options& options,
+                    const uint64_t streamIndex,
+                    LatencyHistogram& histogram) :
+                    index{ streamIndex },
+                    histogram{ &histogram },
+                    timestamps{ options.window + 1 },
+                    tracker{ timestamps, histogram, options.batchSize },
+                    limit{ spec, options.operationsPerStream }
+                {}
+
+                // Records into the histogram of the thread now running the stream.
+                void use(LatencyHistogram& current)
+                {
+                    histogram = &current;
+                    tracker.rebind(current);
+                }
+
+                const uint64_t index;
+                LatencyHistogram* histogram;
+                Request request{};
+                Response response{};
+                StreamTimestamps timestamps;
+                FinishedTracker tracker;
+                OperationLimit limit;
+                std::unique_ptr<BidiStream<Request>> stream{};
+                std::chrono::steady_clock::time_point written{};
+                uint64_t sent{ 0 };
+                uint64_t operations{ 0 };
+            };
+
+            // Whether the next step of the stream is a write rather than a read.
+            bool writable(const StreamState& state) const
+            {
+                return state.limit.running(state.operations)
+                    && (!m_options.acknowledged || state.sent - state.tracker.completed() < m_options.window);
+            }
+
+            // Whether acknowledgements are still owed once the stream stopped writing.
+            bool pending(const StreamState& state) const
+            {
+                return m_options.acknowledged && state.tracker.completed() < state.sent;
+            }
+
+            void prepare(StreamState& state)
+            {
+                m_next(state.request, state.index);
+                state.written = std::chrono::steady_clock::now();
+                state.timestamps.sent(state.sent, state.written);
+                state.histogram->issued(m_options.batchSize);
+                ++state.sent;
+                state.operations += m_options.batchSize;
+            }
+
+            void written(StreamState& state)
+            {
+                if(!m_options.acknowledged)
+                {
+                    state.histogram->record(state.written, std::chrono::steady_clock::now(), m_options.batchSize);
+                }
+            }
+
+            void finished(const grpc::Status& status)
+            {
+                if(!status.ok())
+                {
+                    ++m_errors;
+                    std::cout << "Stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+                }
+            }
+
+            void runSync()
+            {
+                if(m_syncOptions.streams == 0)
+                {
+                    return;
+                }
+                for(uint64_t index{ 0 }; index < m_syncOptions.streams; ++index)
+                {
+                    executor().detach_task([this, index](){ syncStream(index); });
+                }
+                executor().wait();
+            }
+
+            void syncStream(const uint64_t index)
+            {
+                StreamState state{ m_spec, m_syncOptions, index, m_histograms[index] };
+                grpc::ClientContext context{};
+                const std::unique_ptr<grpc::ClientReaderWriter<Request, Response>> stream{ m_calls.sync(&context, index) };
+
+                state.limit.start();
+                bool open{ true };
+                while(open && state.limit.running(state.operations))
+                {
+                    if(writable(state))
+                    {
+                        prepare(state);
+                        open = stream->Write(state.request);
+                        if(open)
+                        {
+                            written(state);
+                        }
+                    }
+                    else if((open = stream->Read(&state.response)))
+                    {
+                        state.tracker.finished(state.response.finished_size());
+                    }
+                }
+                open = open && stream->WritesDone();
+                while(open && pending(state) && (open = stream->Read(&state.response)))
+                {
+                    state.tracker.finished(state.response.finished_size());
+                }
+                finished(stream->Finish());
+            }
+
+            void runCallback()
+            {
+                Scheduler scheduler{ m_histograms.size() };
+                std::vector<std::unique_ptr<StreamState>> states{};
+                for(uint64_t index{ 0 }; index < m_options.streams; ++index)
+                {
+                    states.push_back(std::make_unique<StreamState>(m_spec, m_options, index, m_histograms[0]));
+                    StreamState& state{ *states.back() };
+                    state.stream = std::make_unique<BidiStream<Request>>(
+                        scheduler,
+                        [this, index](grpc::ClientContext* context, auto* reactor){ m_calls.callback(context, reactor, index); });
+                    scheduler.spawn(callbackStream(state, scheduler));
+                }
+                scheduler.run();
+            }
+
+            // A task may resume on another worker after each co_await, so it takes up that
+            // worker's histogram before recording anything.
+            Task callbackStream(StreamState& state, Scheduler& scheduler)
+            {
+                const auto resumed = [&](){ state.use(m_histograms[scheduler.worker()]); };
+                BidiStream<Request>& stream{ *state.stream };
+                resumed();
+                state.limit.start();
+                bool open{ true };
+                while(open && state.limit.running(state.operations))
+                {
+                    if(writable(state))
+                    {
+                        prepare(state);
+                        open = co_await stream.write(state.request);
+                        resumed();
+                        if(open)
+                        {
+                            written(state);
+                        }
+                    }
+                    else if((open = co_await stream.read(state.response)))
+                    {
+                        resumed();
+                        state.tracker.finished(state.response.finished_size());
+                    }
+                }
+                open = open && co_await stream.writesDone();
+                while(open && pending(state) && (open = co_await stream.read(state.response)))
+                {
+                    resumed();
+                    state.tracker.finished(state.response.finished_size());
+                }
+                finished(co_await stream.finish());
+            }
+
+            const WorkloadSpec& m_spec;
+            const typename Engine::Options m_options;
+            const ClientStyle m_style;
+            const ClientCalls<Request> m_calls;
+            const typename Engine::Next m_next;
+            // Sync opens fewer streams than requested, each with more operations.
+            typename Engine::Options m_syncOptions;
+            std::vector<LatencyHistogram> m_histograms{};
+            std::unique_ptr<Engine> m_engine{};
+            std::atomic<uint64_t> m_errors{ 0 };
+        };
+    }
+}
+
+#endif //CLIENT_STYLES_H
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
 #include "benchmarks/common.h"
 
 
@@ -28,25 +32,94 @@ message Dummy\n\
 void rogue::benchmarks::initialLog(const std::string& filename)
 {
     std::ofstream output{ filename, std::ios::app };
-    output << "| Benchmark | Execution Time | Read Ops | Write Ops | Throughput |\n";
-    output << "| --- | --- | --- | --- | ---: |\n";
+    output << "| Benchmark | Execution Time | Read Ops | Write Ops | Throughput | p50 | p90 | p99 | p99.9 | Max |\n";
+    output << "| --- | --- | --- | --- | ---: | ---: | ---: | ---: | ---: | ---: |\n";
     output.close();
+    initialResults(filename);
+}
+
+rogue::benchmarks::LatencyHistogram rogue::benchmarks::mergeHistograms(
+    const std::vector<LatencyHistogram>& histograms)
+{
+    LatencyHistogram merged{};
+    for(const auto& histogram : histograms)
+    {
+        merged.merge(histogram);
+    }
+    return merged;
 }
 
-void rogue::benchmarks::logBenchmark(
+uint64_t rogue::benchmarks::countOperations(
+    const std::vector<LatencyHistogram>& histograms,
+    const uint64_t begin,
+    const uint64_t end)
+{
+    uint64_t operations{ 0 };
+    for(uint64_t index{ begin }; index < std::min<uint64_t>(end, histograms.size()); ++index)
+    {
+        operations += histograms[index].count();
+    }
+    return operations;
+}
+
+double rogue::benchmarks::logBenchmark(
     const std::string& filename,
     const std::string benchmark,
     const std::chrono::_V2::system_clock::time_point start, 
     const std::chrono::_V2::system_clock::time_point finish,
     uint64_t readOperations, 
-    const uint64_t writeOperations)
+    const uint64_t writeOperations,
+    const LatencyHistogram& latencies,
+    const TimeSeries* series,
+    const ResourceUsage* usage,
+    const std::vector<double>& samples)
 {
     std::ofstream output{ filename, std::ios::app };
     const double seconds{ std::chrono::duration<double>(finish - start).count() };
     const double operationsPerSecond{ (readOperations + writeOperations) / seconds };
     output << std::format(
-        std::locale(std::locale{}, new rogue::benchmarks::CommaPunctuation{}), "| {} | {:.3Lf} s | {:L} op | {:L} op | {:.2Lf} op/s |\n", 
+        std::locale(std::locale{}, new rogue::benchmarks::CommaPunctuation{}), 
+        "| {} | {:.3Lf} s | {:L} op | {:L} op | {:.2Lf} op/s | {:.1Lf} us | {:.1Lf} us | {:.1Lf} us | {:.1Lf} us | {:.1Lf} us |\n", 
         benchmark, seconds, readOperations, 
-        writeOperations, operationsPerSecond);
+        writeOperations, operationsPerSecond,
+        latencies.percentile(50) / 1000.0, latencies.percentile(90) / 1000.0,
+        latencies.percentile(99) / 1000.0, latencies.percentile(99.9) / 1000.0,
+        latencies.max() / 1000.0);
     output.close();
+
+    // Full distribution next to the table, eg. BENCHMARKS.md -> BENCHMARKS_HISTOGRAMS/[benchmark].hgrm
+    std::string name{ benchmark };
+    std::replace_if(name.begin(), name.end(), [](const char c){ return !std::isalnum(c); }, '_');
+    const std::string table{ std::filesystem::path{ filename }.replace_extension().string() };
+    const std::filesystem::path directory{ table + "_HISTOGRAMS" };
+    std::filesystem::create_directories(directory);
+    std::ofstream histogram{ directory / (name + ".hgrm"), std::ios::trunc };
+    latencies.dump(histogram);
+    histogram.close();
+
+    // Per-interval samples, eg. BENCHMARKS_TIMESERIES/[benchmark].csv
+    if(series != nullptr)
+    {
+        const std::filesystem::path seriesDirectory{ table + "_TIMESERIES" };
+        std::filesystem::create_directories(seriesDirectory);
+        series->write((seriesDirectory / (name + ".csv")).string());
+    }
+
+    // Same row for the comparator. Intervals of one run are not independent, so a benchmark
+    // without repetitions has its single throughput as the only sample.
+    BenchmarkResult result{ benchmark, seconds, readOperations, writeOperations, operationsPerSecond,
+        latencies.percentile(50), latencies.percentile(90), latencies.percentile(99),
+        latencies.percentile(99.9), latencies.max(), samples };
+    if(result.samples.empty())
+    {
+        result.samples.push_back(operationsPerSecond);
+    }
+    recordResult(filename, result, latencies, usage);
+
+    // Client-side cost per operation, eg. BENCHMARKS_RESOURCES.md
+    if(usage != nullptr)
+    {
+        logResources(filename, benchmark, readOperations + writeOperations, *usage);
+    }
+    return operationsPerSecond;
 }
@@ -0,0 +1,165 @@
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmarks/results.h"
+#include "benchmarks/statistics.h"
+
+namespace
+{
+    struct Options
+    {
+        std::string baseline{};
+        std::string candidate{};
+        // Relative change that counts as a regression, eg. 0.05 = 5%.
+        double threshold{ 0.05 };
+        // Significance level of the throughput test.
+        double alpha{ 0.05 };
+    };
+
+    Options parseOptions(int argc, char** argv)
+    {
+        Options options{};
+        std::vector<std::string> files{};
+        for(int index{ 1 }; index < argc; ++index)
+        {
+            const std::string argument{ argv[index] };
+            if(argument.starts_with("--threshold="))
+            {
+                options.threshold = std::stod(argument.substr(12));
+            }
+            else if(argument.starts_with("--alpha="))
+            {
+                options.alpha = std::stod(argument.substr(8));
+            }
+            else if(argument.starts_with("--"))
+            {
+                throw std::invalid_argument{ std::format("Unknown option {}.", argument) };
+            }
+            else
+            {
+                files.push_back(argument);
+            }
+        }
+        if(files.size() != 2 || options.threshold < 0 || options.alpha <= 0 || options.alpha >= 1)
+        {
+            throw std::invalid_argument{ "Expected a baseline and a candidate results file." };
+        }
+        options.baseline = files[0];
+        options.candidate = files[1];
+        return options;
+    }
+
+    double change(const double baseline, const double candidate)
+    {
+        return baseline > 0 ? (candidate - baseline) / baseline : 0;
+    }
+}
+
+// Diffs the results CSV of two runs of the same binary, eg.
+//   compare_benchmarks main/BENCHMARKS.csv branch/BENCHMARKS.csv --threshold=0.05
+// Throughput regresses when it drops by more than the threshold and Welch's t-test on the
+// per-repetition samples rejects equal means at alpha. With fewer than two repetitions on
+// either side there is no verdict on throughput. Tail latency regresses when p99 or p99.9
+// grows by more than the threshold. Those come from one pooled histogram per side, so they
+// are raw deltas without a test. Exits with 1 on any regression, and with 2 when a file
+// cannot be read or names a benchmark twice.
+int main(int argc, char** argv)
+{
+    Options options{};
+    std::vector<rogue::benchmarks::BenchmarkResult> baseline{};
+    std::vector<rogue::benchmarks::BenchmarkResult> candidate{};
+    try
+    {
+        options = parseOptions(argc, argv);
+        baseline = rogue::benchmarks::readResults(options.baseline);
+        candidate = rogue::benchmarks::readResults(options.candidate);
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl
+            << "Usage: " << argv[0] << " baseline.csv candidate.csv [--threshold=0.05] [--alpha=0.05]" << std::endl;
+        return 2;
+    }
+
+    std::map<std::string, const rogue::benchmarks::BenchmarkResult*> baselines{};
+    for(const auto& result : baseline)
+    {
+        baselines[result.benchmark] = &result;
+    }
+
+    uint64_t regressions{ 0 };
+    std::cout << "| Benchmark | Baseline | Candidate | Change | p-value | p99 Raw Change | p99.9 Raw Change | Verdict |\n";
+    std::cout << "| --- | ---: | ---: | ---: | ---: | ---: | ---: | --- |\n";
+    for(const auto& current : candidate)
+    {
+        const auto found{ baselines.find(current.benchmark) };
+        if(found == baselines.end())
+        {
+            std::cout << std::format("| {} | - | {:.2f} op/s | - | - | - | - | new |\n",
+                current.benchmark, current.operationsPerSecond);
+            continue;
+        }
+        const rogue::benchmarks::BenchmarkResult& previous{ *found->second };
+        baselines.erase(found);
+
+        const double throughput{ change(previous.operationsPerSecond, current.operationsPerSecond) };
+        const double p99{ change(previous.p99, current.p99) };
+        const double p999{ change(previous.p999, current.p999) };
+        // A single run has no variance to test against, so it gets no throughput verdict.
+        const bool testable{ previous.samples.size() >= 2 && current.samples.size() >= 2 };
+        const rogue::benchmarks::WelchTest test{ rogue::benchmarks::welchTest(previous.samples, current.samples) };
+        const bool significant{ testable && test.pValue < options.alpha };
+        const bool slower{ throughput < -options.threshold && significant };
+        const bool tail{ p99 > options.threshold || p999 > options.threshold };
+
+        std::vector<std::string> verdicts{};
+        if(!testable)
+        {
+            verdicts.emplace_back("insufficient repetitions");
+        }
+        else if(slower)
+        {
+            verdicts.emplace_back("throughput regression");
+        }
+        else if(throughput > options.threshold && significant)
+        {
+            verdicts.emplace_back("improved");
+        }
+        if(tail)
+        {
+            verdicts.emplace_back("tail regression (raw delta)");
+        }
+        if(verdicts.empty())
+        {
+            verdicts.emplace_back("ok");
+        }
+        std::string verdict{ verdicts.front() };
+        for(uint64_t index{ 1 }; index < verdicts.size(); ++index)
+        {
+            verdict += ", " + verdicts[index];
+        }
+        if(slower || tail)
+        {
+            ++regressions;
+        }
+
+        std::cout << std::format("| {} | {:.2f} op/s | {:.2f} op/s | {:+.2f}% | {} | {:+.2f}% | {:+.2f}% | {} |\n",
+            current.benchmark, previous.operationsPerSecond, current.operationsPerSecond, 100 * throughput,
+            testable ? std::format("{:.4f}", test.pValue) : std::string{ "-" },
+            100 * p99, 100 * p999, verdict);
+    }
+    for(const auto& [name, missing] : baselines)
+    {
+        std::cout << std::format("| {} | {:.2f} op/s | - | - | - | - | - | missing |\n",
+            name, missing->operationsPerSecond);
+    }
+
+    std::cout << std::endl << std::format("{} regression(s) at threshold {:.1f}% and alpha {}.",
+        regressions, 100 * options.threshold, options.alpha) << std::endl;
+    return regressions > 0 ? 1 : 0;
+}
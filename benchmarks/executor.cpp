@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <grpc/grpc.h>
+
+#include "benchmarks/executor.h"
+
+namespace
+{
+    std::unique_ptr<rogue::benchmarks::Executor> instance{};
+    std::vector<uint32_t> grpcCoreSet{};
+    // Either one core per worker, round robin, or a set every worker shares.
+    std::vector<uint32_t> workerCoreList{};
+    std::vector<uint32_t> workerCoreSet{};
+
+    std::string readLine(const std::string& path)
+    {
+        std::ifstream input{ path };
+        std::string line{};
+        std::getline(input, line);
+        return line;
+    }
+
+    std::vector<bool> mask(const std::vector<uint32_t>& cores)
+    {
+        std::vector<bool> allowed{};
+        for(const uint32_t core : cores)
+        {
+            allowed.resize(std::max<size_t>(allowed.size(), core + 1), false);
+            allowed[core] = true;
+        }
+        return allowed;
+    }
+
+    void pin(const std::vector<uint32_t>& cores)
+    {
+        if(!cores.empty() && !BS::this_thread::set_os_thread_affinity(mask(cores)))
+        {
+            std::cout << "Could not set the affinity of a thread." << std::endl;
+        }
+    }
+}
+
+rogue::benchmarks::Executor& rogue::benchmarks::executor()
+{
+    if(!instance)
+    {
+        instance = std::make_unique<Executor>();
+    }
+    return *instance;
+}
+
+void rogue::benchmarks::configureExecutor(const WorkloadSpec& spec)
+{
+    std::vector<uint32_t> grpcCores{ spec.grpcCores };
+    if(grpcCores.empty() && !spec.cores.empty())
+    {
+        for(const uint32_t core : onlineCores())
+        {
+            if(std::find(spec.cores.begin(), spec.cores.end(), core) == spec.cores.end())
+            {
+                grpcCores.push_back(core);
+            }
+        }
+    }
+
+    // Threads inherit the affinity of their creator, so the gRPC threads started by
+    // grpc_init() stay on these cores. The workers re-pin themselves below.
+    grpcCoreSet = grpcCores;
+    pin(grpcCores);
+    grpc_init();
+
+    workerCoreList = spec.cores;
+    workerCoreSet = spec.numaNode ? numaNodeCores(*spec.numaNode) : std::vector<uint32_t>{};
+    if(workerCoreList.empty() && workerCoreSet.empty() && !grpcCores.empty())
+    {
+        // Workers would otherwise inherit the gRPC cores of this thread.
+        for(const uint32_t core : onlineCores())
+        {
+            if(std::find(grpcCores.begin(), grpcCores.end(), core) == grpcCores.end())
+            {
+                workerCoreSet.push_back(core);
+            }
+        }
+    }
+    if(instance)
+    {
+        instance->wait();
+    }
+    instance = std::make_unique<Executor>(spec.workers,
+        []()
+        {
+            pinToWorkerCores(BS::this_thread::get_index().value_or(0));
+        });
+}
+
+void rogue::benchmarks::pinToGrpcCores()
+{
+    pin(grpcCoreSet);
+}
+
+void rogue::benchmarks::pinToWorkerCores(const uint64_t worker)
+{
+    if(!workerCoreList.empty())
+    {
+        pin({ workerCoreList[worker % workerCoreList.size()] });
+    }
+    else
+    {
+        pin(workerCoreSet);
+    }
+}
+
+std::vector<uint32_t> rogue::benchmarks::parseCpuList(const std::string& cpus)
+{
+    std::vector<uint32_t> cores{};
+    size_t position{ 0 };
+    while(position < cpus.size())
+    {
+        const size_t end{ std::min(cpus.find(',', position), cpus.size()) };
+        const std::string range{ cpus.substr(position, end - position) };
+        position = end + 1;
+        if(range.find_first_not_of(" \t\n") == std::string::npos)
+        {
+            continue;
+        }
+
+        try
+        {
+            const size_t dash{ range.find('-') };
+            const uint32_t first{ static_cast<uint32_t>(std::stoul(range.substr(0, dash))) };
+            const uint32_t last{ dash == std::string::npos 
+                ? first 
+                : static_cast<uint32_t>(std::stoul(range.substr(dash + 1))) };
+            for(uint32_t core{ first }; core <= last; ++core)
+            {
+                cores.push_back(core);
+            }
+        }
+        catch(const std::logic_error&)
+        {
+            throw std::invalid_argument{ std::format("Invalid cpu list: {}", cpus) };
+        }
+    }
+    return cores;
+}
+
+std::vector<uint32_t> rogue::benchmarks::numaNodeCores(const uint32_t node)
+{
+    const std::vector<uint32_t> cores{ 
+        parseCpuList(readLine(std::format("/sys/devices/system/node/node{}/cpulist", node))) };
+    if(cores.empty())
+    {
+        throw std::invalid_argument{ std::format("NUMA node {} has no cores.", node) };
+    }
+    return cores;
+}
+
+std::vector<uint32_t> rogue::benchmarks::onlineCores()
+{
+    std::vector<uint32_t> cores{ parseCpuList(readLine("/sys/devices/system/cpu/online")) };
+    if(cores.empty())
+    {
+        for(uint32_t core{ 0 }; core < std::thread::hardware_concurrency(); ++core)
+        {
+            cores.push_back(core);
+        }
+    }
+    return cores;
+}
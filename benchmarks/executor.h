@@ -0,0 +1,49 @@
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define BS_THREAD_POOL_NATIVE_EXTENSIONS
+#include "BS_thread_pool.hpp"
+
+#include "benchmarks/workload_spec.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        using Executor = BS::thread_pool<BS::tp::none>;
+
+        // The single pool every benchmark worker runs on. Defined in one translation unit so
+        // the binary only owns the threads it is configured for.
+        Executor& executor();
+
+        // Sizes the executor to the workers of the spec and applies its core placement:
+        // - cores: each worker is pinned to one of the listed cores, round robin.
+        // - numanode: without cores, workers may run on any core of the node.
+        // - grpccores: the calling thread is restricted to these cores before gRPC starts.
+        //   Defaults to the cores left over by the workers. With only grpccores set, the
+        //   workers run on every other online core.
+        // Threads inherit the affinity of the thread that creates them, so on grpccores run:
+        // - the calling thread, and every thread it creates, eg. the time series reporter.
+        // - gRPC's own threads, as long as channels are created on the calling thread before
+        //   work is dispatched. A channel created on a worker may start them on its core.
+        // - threads that call pinToGrpcCores, eg. the consumers draining a worker's stream.
+        // Load threads started outside the executor call pinToWorkerCores instead. Call from
+        // main before any channel is created.
+        void configureExecutor(const WorkloadSpec& spec);
+        // Restrict the calling thread as configured by the last configureExecutor: to its
+        // grpccores, or to the cores of the given executor worker. No-ops when unset.
+        void pinToGrpcCores();
+        void pinToWorkerCores(const uint64_t worker);
+
+        // Parses the Linux cpulist format, eg. "0-3,8,10-11".
+        std::vector<uint32_t> parseCpuList(const std::string& cpus);
+        std::vector<uint32_t> numaNodeCores(const uint32_t node);
+        std::vector<uint32_t> onlineCores();
+    }
+}
+
+#endif //EXECUTOR_H
@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "benchmarks/grpc/experiment_server.h"
+
+#include "protos/experiment.grpc.pb.h"
+
+namespace
+{
+    using Search = rogue::services::Search;
+    using Response = rogue::services::Response;
+    using AsyncService = rogue::services::Experiment::AsyncService;
+
+    enum class Pattern
+    {
+        ALTERNATE,
+        ALL_THEN_ALL,
+        NO_RESPONSE
+    };
+
+    void answer(const uint64_t queries, Response& response)
+    {
+        response.clear_finished();
+        for(uint64_t query{ 0 }; query < queries; ++query)
+        {
+            response.add_finished(query);
+        }
+    }
+
+    grpc::Status serve(grpc::ServerReaderWriter<Response, Search>* stream, const Pattern pattern)
+    {
+        Search search{};
+        Response response{};
+        std::vector<uint64_t> pending{};
+        while(stream->Read(&search))
+        {
+            switch(pattern)
+            {
+                case Pattern::ALTERNATE:
+                    answer(search.queries_size(), response);
+                    if(!stream->Write(response))
+                    {
+                        return grpc::Status{ grpc::StatusCode::CANCELLED, "Write failed." };
+                    }
+                    break;
+                case Pattern::ALL_THEN_ALL:
+                    pending.push_back(search.queries_size());
+                    break;
+                case Pattern::NO_RESPONSE:
+                    break;
+            }
+        }
+        for(const uint64_t queries : pending)
+        {
+            answer(queries, response);
+            if(!stream->Write(response))
+            {
+                return grpc::Status{ grpc::StatusCode::CANCELLED, "Write failed." };
+            }
+        }
+        return grpc::Status::OK;
+    }
+
+    class SyncService final : public rogue::services::Experiment::Service
+    {
+    public:
+        using Stream = grpc::ServerReaderWriter<Response, Search>;
+
+        grpc::Status search(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::ALTERNATE); }
+        grpc::Status singleReadAllWriteAll(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::ALL_THEN_ALL); }
+        grpc::Status singleReadWriteAlternate(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::ALTERNATE); }
+        grpc::Status singleReadAllNoResponse(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::NO_RESPONSE); }
+        grpc::Status bulkReadAllWriteAll(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::ALL_THEN_ALL); }
+        grpc::Status bulkReadWriteAlternate(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::ALTERNATE); }
+        grpc::Status bulkReadAllNoResponse(grpc::ServerContext*, Stream* stream) override { return serve(stream, Pattern::NO_RESPONSE); }
+    };
+
+    // Reads and writes alternate, so at most one operation is in flight per stream.
+    class Reactor final : public grpc::ServerBidiReactor<Search, Response>
+    {
+    public:
+        explicit Reactor(const Pattern pattern) :
+            m_pattern{ pattern }
+        {
+            StartRead(&m_search);
+        }
+
+        void OnReadDone(const bool ok) override
+        {
+            if(!ok)
+            {
+                m_draining = true;
+                writeNext();
+                return;
+            }
+            switch(m_pattern)
+            {
+                case Pattern::ALTERNATE:
+                    answer(m_search.queries_size(), m_response);
+                    StartWrite(&m_response);
+                    return;
+                case Pattern::ALL_THEN_ALL:
+                    m_pending.push_back(m_search.queries_size());
+                    break;
+                case Pattern::NO_RESPONSE:
+                    break;
+            }
+            StartRead(&m_search);
+        }
+
+        void OnWriteDone(const bool ok) override
+        {
+            if(!ok)
+            {
+                Finish(grpc::Status{ grpc::StatusCode::CANCELLED, "Write failed." });
+            }
+            else if(m_draining)
+            {
+                writeNext();
+            }
+            else
+            {
+                StartRead(&m_search);
+            }
+        }
+
+        void OnDone() override
+        {
+            delete this;
+        }
+
+    private:
+        void writeNext()
+        {
+            if(m_written == m_pending.size())
+            {
+                Finish(grpc::Status::OK);
+                return;
+            }
+            answer(m_pending[m_written++], m_response);
+            StartWrite(&m_response);
+        }
+
+        const Pattern m_pattern;
+        Search m_search{};
+        Response m_response{};
+        std::vector<uint64_t> m_pending{};
+        uint64_t m_written{ 0 };
+        bool m_draining{ false };
+    };
+
+    class CallbackService final : public rogue::services::Experiment::CallbackService
+    {
+    public:
+        using Stream = grpc::ServerBidiReactor<Search, Response>;
+
+        Stream* search(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::ALTERNATE }; }
+        Stream* singleReadAllWriteAll(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::ALL_THEN_ALL }; }
+        Stream* singleReadWriteAlternate(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::ALTERNATE }; }
+        Stream* singleReadAllNoResponse(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::NO_RESPONSE }; }
+        Stream* bulkReadAllWriteAll(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::ALL_THEN_ALL }; }
+        Stream* bulkReadWriteAlternate(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::ALTERNATE }; }
+        Stream* bulkReadAllNoResponse(grpc::CallbackServerContext*) override { return new Reactor{ Pattern::NO_RESPONSE }; }
+    };
+
+    using Request = void (AsyncService::*)(
+        grpc::ServerContext*,
+        grpc::ServerAsyncReaderWriter<Response, Search>*,
+        grpc::CompletionQueue*,
+        grpc::ServerCompletionQueue*,
+        void*);
+
+    struct Method
+    {
+        Request request;
+        Pattern pattern;
+    };
+
+    const std::vector<Method> METHODS{
+        { &AsyncService::Requestsearch, Pattern::ALTERNATE },
+        { &AsyncService::RequestsingleReadAllWriteAll, Pattern::ALL_THEN_ALL },
+        { &AsyncService::RequestsingleReadWriteAlternate, Pattern::ALTERNATE },
+        { &AsyncService::RequestsingleReadAllNoResponse, Pattern::NO_RESPONSE },
+        { &AsyncService::RequestbulkReadAllWriteAll, Pattern::ALL_THEN_ALL },
+        { &AsyncService::RequestbulkReadWriteAlternate, Pattern::ALTERNATE },
+        { &AsyncService::RequestbulkReadAllNoResponse, Pattern::NO_RESPONSE } };
+
+    // One call of the async server, tagged by itself since it has one operation in flight at a
+    // time. Every call requests its successor once connected, so each queue keeps one call of
+    // every method waiting.
+    class AsyncCall
+    {
+    public:
+        AsyncCall(
+            AsyncService& service,
+            grpc::ServerCompletionQueue& queue,
+            const Method& method,
+            std::mutex& requesting,
+            const bool& stopping) :
+            m_service{ service },
+            m_queue{ queue },
+            m_method{ method },
+            m_requesting{ requesting },
+            m_stopping{ stopping }
+        {
+            (m_service.*m_method.request)(&m_context, &m_stream, &m_queue, &m_queue, this);
+        }
+
+        // Returns false once the call is over.
+        bool proceed(const bool ok)
+        {
+            switch(m_state)
+            {
+                case State::CONNECTING:
+                    if(!ok)
+                    {
+                        return false;
+                    }
+                    requestNext();
+                    read();
+                    return true;
+                case State::READING:
+                    if(!ok)
+                    {
+                        m_draining = true;
+                        writeNext();
+                        return true;
+                    }
+                    switch(m_method.pattern)
+                    {
+                        case Pattern::ALTERNATE:
+                            answer(m_search.queries_size(), m_response);
+                            m_state = State::WRITING;
+                            m_stream.Write(m_response, this);
+                            return true;
+                        case Pattern::ALL_THEN_ALL:
+                            m_pending.push_back(m_search.queries_size());
+                            break;
+                        case Pattern::NO_RESPONSE:
+                            break;
+                    }
+                    read();
+                    return true;
+                case State::WRITING:
+                    if(!ok)
+                    {
+                        m_state = State::FINISHING;
+                        m_stream.Finish(grpc::Status{ grpc::StatusCode::CANCELLED, "Write failed." }, this);
+                    }
+                    else if(m_draining)
+                    {
+                        writeNext();
+                    }
+                    else
+                    {
+                        read();
+                    }
+                    return true;
+                case State::FINISHING:
+                    return false;
+            }
+            return false;
+        }
+
+    private:
+        enum class State
+        {
+            CONNECTING,
+            READING,
+            WRITING,
+            FINISHING
+        };
+
+        void requestNext()
+        {
+            std::lock_guard<std::mutex> lock{ m_requesting };
+            if(!m_stopping)
+            {
+                new AsyncCall{ m_service, m_queue, m_method, m_requesting, m_stopping };
+            }
+        }
+
+        void read()
+        {
+            m_state = State::READING;
+            m_stream.Read(&m_search, this);
+        }
+
+        void writeNext()
+        {
+            if(m_written == m_pending.size())
+            {
+                m_state = State::FINISHING;
+                m_stream.Finish(grpc::Status::OK, this);
+                return;
+            }
+            answer(m_pending[m_written++], m_response);
+            m_state = State::WRITING;
+            m_stream.Write(m_response, this);
+        }
+
+        AsyncService& m_service;
+        grpc::ServerCompletionQueue& m_queue;
+        const Method& m_method;
+        std::mutex& m_requesting;
+        const bool& m_stopping;
+        grpc::ServerContext m_context{};
+        grpc::ServerAsyncReaderWriter<Response, Search> m_stream{ &m_context };
+        State m_state{ State::CONNECTING };
+        Search m_search{};
+        Response m_response{};
+        std::vector<uint64_t> m_pending{};
+        uint64_t m_written{ 0 };
+        bool m_draining{ false };
+    };
+
+    void poll(grpc::ServerCompletionQueue& queue)
+    {
+        void* tag{ nullptr };
+        bool ok{ false };
+        while(queue.Next(&tag, &ok))
+        {
+            AsyncCall* call{ static_cast<AsyncCall*>(tag) };
+            if(!call->proceed(ok))
+            {
+                delete call;
+            }
+        }
+    }
+}
+
+rogue::benchmarks::ServerStyle rogue::benchmarks::parseServerStyle(const std::string& style)
+{
+    if(style == "sync")
+    {
+        return ServerStyle::SYNC;
+    }
+    if(style == "callback")
+    {
+        return ServerStyle::CALLBACK;
+    }
+    if(style == "async")
+    {
+        return ServerStyle::ASYNC;
+    }
+    throw std::invalid_argument{ std::format("Server style must be sync, callback, or async: {}", style) };
+}
+
+rogue::benchmarks::ExperimentServer::ExperimentServer(const ServerOptions& options)
+{
+    grpc::ServerBuilder builder{};
+    m_boundPorts.resize(options.ports.size());
+    for(uint64_t index{ 0 }; index < options.ports.size(); ++index)
+    {
+        builder.AddListeningPort(
+            std::format("{}:{}", options.address, options.ports[index]), grpc::InsecureServerCredentials(), &m_boundPorts[index]);
+    }
+    for(const std::string& uri : options.uris)
+    {
+        builder.AddListeningPort(uri, grpc::InsecureServerCredentials());
+    }
+
+    switch(options.style)
+    {
+        case ServerStyle::SYNC:
+            m_service = std::make_unique<SyncService>();
+            if(options.threads > 0)
+            {
+                builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS, static_cast<int>(options.threads));
+                builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MAX_POLLERS, static_cast<int>(options.threads));
+            }
+            break;
+        case ServerStyle::CALLBACK:
+            m_service = std::make_unique<CallbackService>();
+            break;
+        case ServerStyle::ASYNC:
+            m_service = std::make_unique<AsyncService>();
+            for(uint64_t index{ 0 }; index < (options.threads > 0 ? options.threads : std::max(1U, std::thread::hardware_concurrency())); ++index)
+            {
+                m_queues.push_back(builder.AddCompletionQueue());
+            }
+            break;
+    }
+    builder.RegisterService(m_service.get());
+    m_server = builder.BuildAndStart();
+    if(!m_server)
+    {
+        throw std::runtime_error{ std::format("Could not listen on {}.", options.address) };
+    }
+
+    AsyncService* async{ dynamic_cast<AsyncService*>(m_service.get()) };
+    for(const auto& queue : m_queues)
+    {
+        for(const Method& method : METHODS)
+        {
+            new AsyncCall{ *async, *queue, method, m_requesting, m_stopping };
+        }
+        m_pollers.emplace_back([&queue = *queue](){ poll(queue); });
+    }
+}
+
+rogue::benchmarks::ExperimentServer::~ExperimentServer()
+{
+    shutdown();
+}
+
+void rogue::benchmarks::ExperimentServer::wait()
+{
+    m_server->Wait();
+}
+
+std::shared_ptr<grpc::Channel> rogue::benchmarks::ExperimentServer::inProcessChannel() const
+{
+    return m_server->InProcessChannel(grpc::ChannelArguments{});
+}
+
+void rogue::benchmarks::ExperimentServer::shutdown()
+{
+    if(m_stopped)
+    {
+        return;
+    }
+    m_stopped = true;
+    {
+        std::lock_guard<std::mutex> lock{ m_requesting };
+        m_stopping = true;
+    }
+    m_server->Shutdown();
+    for(const auto& queue : m_queues)
+    {
+        queue->Shutdown();
+    }
+    for(std::thread& poller : m_pollers)
+    {
+        poller.join();
+    }
+}
+
+std::vector<std::unique_ptr<rogue::benchmarks::ExperimentServer>> rogue::benchmarks::startBenchmarkServers(ServerOptions options)
+{
+    std::vector<std::unique_ptr<ExperimentServer>> servers{};
+    options.ports = { 80 };
+    for(uint32_t port{ 86 }; port <= 101; ++port)
+    {
+        options.ports.push_back(port);
+    }
+    servers.push_back(std::make_unique<ExperimentServer>(options));
+    for(const uint32_t port : { 82, 83, 84, 85 })
+    {
+        options.ports = { port };
+        servers.push_back(std::make_unique<ExperimentServer>(options));
+    }
+    return servers;
+}
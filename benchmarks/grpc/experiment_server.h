@@ -0,0 +1,87 @@
+#ifndef EXPERIMENT_SERVER_H
+#define EXPERIMENT_SERVER_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // gRPC server API the Experiment service is implemented with.
+        enum class ServerStyle
+        {
+            SYNC,
+            CALLBACK,
+            ASYNC
+        };
+
+        // sync, callback, or async. Throws std::invalid_argument otherwise.
+        ServerStyle parseServerStyle(const std::string& style);
+
+        struct ServerOptions
+        {
+            ServerStyle style{ ServerStyle::SYNC };
+            std::string address{ "0.0.0.0" };
+            std::vector<uint32_t> ports{ 80 }; // 0 binds any free port, see boundPorts.
+            // Listened on as given, eg. unix:/tmp/experiment.sock.
+            std::vector<std::string> uris{};
+            // Completion queues of the sync server, or of the async server each polled by its
+            // own thread. gRPC's default for sync and one per hardware thread for async when 0.
+            // The callback server always runs on gRPC's own threads.
+            uint64_t threads{ 0 };
+        };
+
+        // Reference implementation of the Experiment service for running grpc_benchmarks on
+        // one machine. Every Search is answered by a Response whose finished lists all of its
+        // queries, following the pattern the method is named after:
+        //  - search, singleReadWriteAlternate, bulkReadWriteAlternate answer each Search as
+        //    it arrives.
+        //  - singleReadAllWriteAll, bulkReadAllWriteAll read until the client's WritesDone,
+        //    then answer every Search.
+        //  - singleReadAllNoResponse, bulkReadAllNoResponse read until WritesDone and answer
+        //    nothing.
+        // All ports are served by one server. Separate ExperimentServers act as separate servers.
+        class ExperimentServer
+        {
+        public:
+            explicit ExperimentServer(const ServerOptions& options);
+            ~ExperimentServer();
+            ExperimentServer(const ExperimentServer&) = delete;
+            ExperimentServer& operator=(const ExperimentServer&) = delete;
+
+            // Blocks until shutdown.
+            void wait();
+            void shutdown();
+
+            // Ports bound for ServerOptions::ports, in the same order.
+            const std::vector<int>& boundPorts() const { return m_boundPorts; }
+            // A channel into the server that bypasses the network stack entirely.
+            std::shared_ptr<grpc::Channel> inProcessChannel() const;
+
+        private:
+            std::unique_ptr<grpc::Service> m_service{};
+            std::unique_ptr<grpc::Server> m_server{};
+            std::vector<int> m_boundPorts{};
+            std::vector<std::unique_ptr<grpc::ServerCompletionQueue>> m_queues{};
+            std::vector<std::thread> m_pollers{};
+            // Async calls request their successors under the lock, and shutdown sets m_stopping
+            // under it before closing the queues, so no request reaches a closed queue.
+            std::mutex m_requesting{};
+            bool m_stopping{ false };
+            bool m_stopped{ false };
+        };
+
+        // The servers grpc_benchmarks connects to at options.address: one listening on 80 and
+        // 86-101 for the main, forced-channel, and multi-port sweeps, and one each on 82-85 for
+        // the multi-server sweep. options.ports is ignored.
+        std::vector<std::unique_ptr<ExperimentServer>> startBenchmarkServers(ServerOptions options);
+    }
+}
+
+#endif //EXPERIMENT_SERVER_H
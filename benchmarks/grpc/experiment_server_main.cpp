@@ -0,0 +1,79 @@
+#include <format>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "benchmarks/executor.h"
+#include "benchmarks/grpc/experiment_server.h"
+
+namespace
+{
+    struct Options
+    {
+        rogue::benchmarks::ServerOptions server{};
+        // Serves only these ports from one server instead of the grpc_benchmarks layout.
+        bool customPorts{ false };
+    };
+
+    Options parseOptions(int argc, char** argv)
+    {
+        Options options{};
+        for(int index{ 1 }; index < argc; ++index)
+        {
+            const std::string argument{ argv[index] };
+            if(argument.starts_with("--style="))
+            {
+                options.server.style = rogue::benchmarks::parseServerStyle(argument.substr(8));
+            }
+            else if(argument.starts_with("--threads="))
+            {
+                options.server.threads = std::stoull(argument.substr(10));
+            }
+            else if(argument.starts_with("--ports="))
+            {
+                options.server.ports = rogue::benchmarks::parseCpuList(argument.substr(8));
+                options.customPorts = true;
+                if(options.server.ports.empty())
+                {
+                    throw std::invalid_argument{ "ports must not be empty." };
+                }
+            }
+            else if(argument.starts_with("--"))
+            {
+                throw std::invalid_argument{ std::format("Unknown option: {}", argument) };
+            }
+            else
+            {
+                options.server.address = argument;
+            }
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    Options options{};
+    try
+    {
+        options = parseOptions(argc, argv);
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl
+            << "Usage: " << argv[0] << " [address] [--style=sync|callback|async] [--threads=0] [--ports=80,86-101]" << std::endl;
+        return 2;
+    }
+
+    if(options.customPorts)
+    {
+        rogue::benchmarks::ExperimentServer server{ options.server };
+        server.wait();
+    }
+    else
+    {
+        const auto servers{ rogue::benchmarks::startBenchmarkServers(options.server) };
+        servers.front()->wait();
+    }
+    return 0;
+}
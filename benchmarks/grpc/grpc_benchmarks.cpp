@@ -1,8 +1,17 @@
+#include <functional>
 #include <latch>
 #include <random>
+#include <unistd.h>
 #include <grpcpp/grpcpp.h>
 
+#include "benchmarks/benchmark_runner.h"
+#include "benchmarks/bidi_stream.h"
+#include "benchmarks/client_styles.h"
 #include "benchmarks/common.h"
+#include "benchmarks/grpc/experiment_server.h"
+#include "benchmarks/message_arena.h"
+#include "benchmarks/scheduler.h"
+#include "benchmarks/workload_spec.h"
 #include "benchmarks/zipfian_generator.h"
 
 #include "protos/experiment.grpc.pb.h"
@@ -12,128 +21,208 @@ const std::string FORCED_CHANNEL_BENCHMARK_FILE{ "GRPC_FORCED_CHANNEL_BENCHMARKS
 const std::string MULTI_PORT_BENCHMARK_FILE{ "GRPC_MULTI_PORT_BENCHMARKS.md" };
 const std::string MULTI_SERVER_BENCHMARK_FILE{ "GRPC_MULTI_SERVER_BENCHMARKS.md" };
 const std::string THREAD_BENCHMARK_FILE{ "GRPC_THREADING_BENCHMARKS.md" };
+const std::string TRANSPORT_BENCHMARK_FILE{ "GRPC_TRANSPORT_BENCHMARKS.md" };
+const std::string CLIENT_STYLE_BENCHMARK_FILE{ "GRPC_CLIENT_STYLE_BENCHMARKS.md" };
 const std::string BENCHMARK_FILE{ "GRPC_BENCHMARKS.md" };
+const std::string SPEC_FILE{ "GRPC_BENCHMARKS_SPEC.txt" };
 
-class SearchChatter : public grpc::ClientBidiReactor<rogue::services::Search, rogue::services::Response> 
+std::shared_ptr<grpc::Channel> connect(const rogue::benchmarks::WorkloadSpec& spec)
 {
-public:
-    explicit SearchChatter(
-        std::unique_ptr<rogue::services::Experiment::Stub>& stub,
-        const uint32_t operations)
-        : m_totalOperations{ operations }
+    return grpc::CreateChannel(std::format("{}:80", spec.address), grpc::InsecureChannelCredentials());
+}
+
+// One stub per streamsperchannel streams. Distinct channel arguments keep gRPC from
+// sharing a single connection between the stubs.
+std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> streamStubs(const rogue::benchmarks::WorkloadSpec& spec)
+{
+    std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{};
+    for(uint64_t index{ 0 }; index < (spec.streams + spec.streamsPerChannel - 1) / spec.streamsPerChannel; ++index)
     {
-        rogue::services::Query* query{ m_search.add_queries() };
+        grpc::ChannelArguments arguments{};
+        arguments.SetInt("dummy", index);
+        stubs.push_back(rogue::services::Experiment::NewStub(
+            grpc::CreateCustomChannel(
+                std::format("{}:80", spec.address), 
+                grpc::InsecureChannelCredentials(),
+                arguments)));
+    }
+    return stubs;
+}
+
+// Fills search, eg. one created on a MessageArena, with batchSize EQUAL queries.
+void batchSearch(const uint64_t batchSize, rogue::services::Search& search)
+{
+    search.set_api_key(rogue::benchmarks::API_KEY);
+    rogue::benchmarks::Dummy dummy{};
+    dummy.set_id(1);
+    for(uint64_t count{ 0 }; count < batchSize; ++count)
+    {
+        rogue::services::Query* query{ search.add_queries() };
         rogue::services::Basic& expression{ *query->mutable_basic() };
         expression.set_logical_operator(rogue::services::LogicalOperator::AND);
         expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-        expression.add_operands();
-
-        rogue::benchmarks::Dummy dummy{};
-        dummy.set_id(1);
-        query->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
-
-        stub->async()->search(&m_context, this);
-        nextWrite();
-        StartRead(&m_response);
-        StartCall();
+        expression.add_operands()->PackFrom(dummy);
     }
-    void OnWriteDone(bool ok) override
+}
+
+rogue::benchmarks::Task writeSearches(
+    rogue::benchmarks::BidiStream<rogue::services::Search>& stream,
+    const rogue::services::Search& search,
+    rogue::benchmarks::StreamTimestamps& timestamps,
+    const uint64_t operations)
+{
+    for(uint64_t count{ 0 }; count < operations; ++count)
     {
-        if(ok) 
+        timestamps.sent(count);
+        if(!co_await stream.write(search))
         {
-            nextWrite();
+            break;
         }
     }
-    void OnReadDone(bool ok) override
+    co_await stream.writesDone();
+}
+
+// Each response answers a Search of batchSize queries. Records into the histogram of the
+// scheduler worker that resumed the task, so histograms scale with pollers, not streams.
+rogue::benchmarks::Task readResponses(
+    rogue::benchmarks::Scheduler& scheduler,
+    rogue::benchmarks::BidiStream<rogue::services::Search>& stream,
+    rogue::benchmarks::StreamTimestamps& timestamps,
+    std::vector<rogue::benchmarks::LatencyHistogram>& histograms,
+    const uint64_t batchSize)
+{
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Response& response{ arena.create<rogue::services::Response>() };
+    for(uint64_t received{ 0 }; co_await stream.read(response); ++received)
     {
-        if(ok)
-        {
-            StartRead(&m_response);
-        }
+        histograms[scheduler.worker()].record(timestamps.at(received), std::chrono::steady_clock::now(), batchSize);
     }
-    void OnDone(const grpc::Status& status) override 
+
+    const grpc::Status status{ co_await stream.finish() };
+    if(!status.ok())
     {
-        std::unique_lock<std::mutex> l(m_stateLock);
-        m_status = status;
-        m_done = true;
-        m_conditional.notify_one();
+        std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+        throw std::runtime_error{"Could not recover."};
     }
+}
 
-    grpc::Status Await()
+// Pipelined searches on spec.streams streams, each driven by a writer and a reader task on
+// spec.pollers scheduler threads instead of a thread per stream.
+rogue::benchmarks::Measurement readOnlyBulkAsync(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t batchSize, rogue::benchmarks::TimeSeries& series)
+{
+    // As in the bulk benchmarks, operationCount counts queries, batchSize to each Search.
+    const uint64_t searchesPerStream{ spec.operationCount / spec.streams / batchSize };
+    const std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{ streamStubs(spec) };
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+    batchSearch(batchSize, search);
+
+    rogue::benchmarks::Scheduler scheduler{ spec.pollers };
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(scheduler.workers());
+    series.attachAll(histograms);
+    std::vector<std::unique_ptr<rogue::benchmarks::StreamTimestamps>> timestamps{};
+    std::vector<std::unique_ptr<rogue::benchmarks::BidiStream<rogue::services::Search>>> streams{};
+    
+    // The streams are opened before the clock starts, as in the other rows.
+    for(uint64_t index{ 0 }; index < spec.streams; ++index)
     {
-        std::unique_lock<std::mutex> l(m_stateLock);
-        m_conditional.wait(l, [this] { return m_done; });
-        return std::move(m_status);
+        rogue::services::Experiment::Stub& stub{ *stubs[index / spec.streamsPerChannel] };
+        timestamps.push_back(std::make_unique<rogue::benchmarks::StreamTimestamps>(searchesPerStream));
+        streams.push_back(std::make_unique<rogue::benchmarks::BidiStream<rogue::services::Search>>(
+            scheduler, 
+            [&](grpc::ClientContext* context, auto* reactor){ stub.async()->search(context, reactor); }));
+        scheduler.spawn(writeSearches(*streams.back(), search, *timestamps.back(), searchesPerStream));
+        scheduler.spawn(readResponses(scheduler, *streams.back(), *timestamps.back(), histograms, batchSize));
     }
 
-private:
-    void nextWrite()
+    const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    scheduler.run();
+    series.stop();
+    const auto finish{ std::chrono::high_resolution_clock::now() };
+
+    return rogue::benchmarks::Measurement{ start, finish, rogue::benchmarks::countOperations(histograms, 0, histograms.size()), 0, rogue::benchmarks::mergeHistograms(histograms) };
+}
+
+// readStreams streams on search, answered per Search, next to writeStreams streams on
+// bulkReadAllNoResponse, never answered, all driven in the given client style. Mixed runs
+// split the pollers between the two so neither waits for executor threads.
+rogue::benchmarks::Measurement clientStyleWorkload(
+    const rogue::benchmarks::WorkloadSpec& spec,
+    const rogue::benchmarks::ClientStyle style,
+    const uint64_t batchSize,
+    const uint64_t readStreams,
+    const uint64_t writeStreams,
+    rogue::benchmarks::TimeSeries& series)
+{
+    using Runner = rogue::benchmarks::ClientStyleRunner<rogue::services::Search>;
+    const std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{ streamStubs(spec) };
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+    batchSearch(batchSize, search);
+    const uint64_t operationsPerStream{ spec.operationCount / spec.streams };
+    const uint64_t pollers{ readStreams > 0 && writeStreams > 0 ? std::max<uint64_t>(spec.pollers / 2, 1) : spec.pollers };
+    const auto next = [&](rogue::services::Search& request, const uint64_t)
     {
-        if(m_count++ < m_totalOperations)
+        if(request.queries_size() == 0)
         {
-            StartWrite(&m_search);
-        }
-        else
-        {   
-            StartWritesDone();
+            request = search;
         }
-    }
-    
-    const uint32_t m_totalOperations;
-    uint32_t m_count{ 0 };
-    grpc::ClientContext m_context{};
-    rogue::services::Search m_search{};
-    rogue::services::Response m_response{};
-    std::mutex m_stateLock{};
-    std::condition_variable m_conditional{};
-    grpc::Status m_status{};
-    bool m_done{ false };
-};
-
-void readOnlyBulkAsync(const std::string& ipAddress, const uint64_t batchSize)
-{
-    std::latch latch{ 1 };
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / rogue::benchmarks::TOTAL_WORKERS };
-    
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS; ++index)
-    {
-        rogue::benchmarks::threadpool.detach_task(
-            [&]()
-            {
-                std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-                    grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
-                latch.wait();
-
-                SearchChatter chatter{ readerStub, operationsPerThread };
-                grpc::Status status = chatter.Await();
-                if (!status.ok()) {
-                    std::cout << "RouteChat rpc failed." << std::endl;
-                }
-                std::cout << "finished reads" << std::endl;
-            });
-    }
+    };
+
+    // Write streams come after the read streams on the channels.
+    const auto stub = [&](const uint64_t stream){ return stubs[stream / spec.streamsPerChannel].get(); };
+    Runner reader{ 
+        spec, 
+        Runner::Engine::Options{ readStreams, pollers, operationsPerStream, batchSize, spec.window, true },
+        style,
+        rogue::benchmarks::ClientCalls<rogue::services::Search>{
+            [&](grpc::ClientContext* context, const uint64_t stream){ return stub(stream)->search(context); },
+            [&](grpc::ClientContext* context, auto* reactor, const uint64_t stream){ stub(stream)->async()->search(context, reactor); },
+            [&](grpc::ClientContext* context, grpc::CompletionQueue* queue, const uint64_t stream){ return stub(stream)->PrepareAsyncsearch(context, queue); } },
+        next };
+    Runner writer{ 
+        spec, 
+        Runner::Engine::Options{ writeStreams, pollers, operationsPerStream, batchSize, spec.window, false },
+        style,
+        rogue::benchmarks::ClientCalls<rogue::services::Search>{
+            [&](grpc::ClientContext* context, const uint64_t stream){ return stub(readStreams + stream)->bulkReadAllNoResponse(context); },
+            [&](grpc::ClientContext* context, auto* reactor, const uint64_t stream){ stub(readStreams + stream)->async()->bulkReadAllNoResponse(context, reactor); },
+            [&](grpc::ClientContext* context, grpc::CompletionQueue* queue, const uint64_t stream){ return stub(readStreams + stream)->PrepareAsyncbulkReadAllNoResponse(context, queue); } },
+        next };
+
+    reader.attach(series);
+    writer.attach(series);
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
     const auto start{ std::chrono::high_resolution_clock::now() };
-    latch.count_down();
-    rogue::benchmarks::threadpool.wait();
+    series.start();
+    std::thread writing{ [&](){ writer.run(); } };
+    reader.run();
+    writing.join();
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
+    if(reader.errors() + writer.errors() > 0)
+    {
+        throw std::runtime_error{"Could not recover."};
+    }
 
-    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, std::format("Read Only Bulk Asyc {}", batchSize), start, finish, operationsPerThread * rogue::benchmarks::TOTAL_WORKERS, 0);
+    rogue::benchmarks::LatencyHistogram histogram{ reader.histogram() };
+    histogram.merge(writer.histogram());
+    return rogue::benchmarks::Measurement{ start, finish, reader.histogram().count(), writer.histogram().count(), histogram };
 }
 
-void singleReadAllWriteAll(const std::string& ipAddress)
+rogue::benchmarks::Measurement singleReadAllWriteAll(const rogue::benchmarks::WorkloadSpec& spec, const std::shared_ptr<grpc::Channel>& channel, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
-    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
+    const uint64_t operationsPerThread{ spec.operationCount / 10 };
+    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(channel) };
     grpc::ClientContext readerContext{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
         readerStub->singleReadAllWriteAll(&readerContext) };
     std::random_device randomizer{};
     std::mt19937 generator{ randomizer() };
     
-    rogue::services::Search search{};
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
     search.set_api_key(rogue::benchmarks::API_KEY);
     
     rogue::services::Query* query{ search.add_queries() };
@@ -143,15 +232,20 @@ void singleReadAllWriteAll(const std::string& ipAddress)
     expression.add_operands();
 
     rogue::benchmarks::Dummy dummy{};
-    rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
+    rogue::utilities::ZipfianGenerator zipfian{spec.recordCount, .9};
     rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-    rogue::services::Response readResponse{};
+    rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+    rogue::benchmarks::LatencyHistogram histogram{};
+    series.attach(histogram);
+    rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread };
     dummy.set_id(zipfianGenerator());
-    search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+    rogue::benchmarks::repack(*search.mutable_queries(0)->mutable_basic()->mutable_operands(0), dummy);
     
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
     for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
     {
+        timestamps.sent(count);
         stream->Write(search);
     }
     stream->WritesDone();
@@ -164,21 +258,19 @@ void singleReadAllWriteAll(const std::string& ipAddress)
             std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
             throw std::runtime_error{"Could not recover."};
         }
+        histogram.record(timestamps.at(count), std::chrono::steady_clock::now());
     }
 
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        BENCHMARK_FILE, 
-        "Send All Receive All - Batch 1", 
-        start, finish, operationsPerThread, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread, 0, histogram };
 }
 
-void singleReadWriteAlternate(const std::string& ipAddress)
+rogue::benchmarks::Measurement singleReadWriteAlternate(const rogue::benchmarks::WorkloadSpec& spec, const std::shared_ptr<grpc::Channel>& channel, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
+    const uint64_t operationsPerThread{ spec.operationCount / 10 };
     
-    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
+    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(channel) };
     
     grpc::ClientContext readerContext{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
@@ -186,7 +278,8 @@ void singleReadWriteAlternate(const std::string& ipAddress)
     std::random_device randomizer{};
     std::mt19937 generator{ randomizer() };
     
-    rogue::services::Search search{};
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
     search.set_api_key(rogue::benchmarks::API_KEY);
     
     rogue::services::Query* query{ search.add_queries() };
@@ -196,15 +289,19 @@ void singleReadWriteAlternate(const std::string& ipAddress)
     expression.add_operands();
 
     rogue::benchmarks::Dummy dummy{};
-    rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
+    rogue::utilities::ZipfianGenerator zipfian{spec.recordCount, .9};
     rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-    rogue::services::Response readResponse{};
+    rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+    rogue::benchmarks::LatencyHistogram histogram{};
+    series.attach(histogram);
     dummy.set_id(zipfianGenerator());
-    search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+    rogue::benchmarks::repack(*search.mutable_queries(0)->mutable_basic()->mutable_operands(0), dummy);
     
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
     for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
     {
+        const auto sent{ std::chrono::steady_clock::now() };
         stream->Write(search);
         if(!stream->Read(&readResponse))
         {
@@ -212,21 +309,20 @@ void singleReadWriteAlternate(const std::string& ipAddress)
             std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
             throw std::runtime_error{"Could not recover."};
         }
+        histogram.record(sent, std::chrono::steady_clock::now());
     }
     stream->WritesDone();
 
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        BENCHMARK_FILE, 
-        "Alternate Send Receive - Batch 1", start, finish, operationsPerThread, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread, 0, histogram };
 }
 
-void singleReadAllNoResponse(const std::string& ipAddress)
+rogue::benchmarks::Measurement singleReadAllNoResponse(const rogue::benchmarks::WorkloadSpec& spec, const std::shared_ptr<grpc::Channel>& channel, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
+    const uint64_t operationsPerThread{ spec.operationCount / 10 };
     
-    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
+    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(channel) };
     
     grpc::ClientContext readerContext{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
@@ -234,7 +330,8 @@ void singleReadAllNoResponse(const std::string& ipAddress)
     std::random_device randomizer{};
     std::mt19937 generator{ randomizer() };
     
-    rogue::services::Search search{};
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
     search.set_api_key(rogue::benchmarks::API_KEY);
     
     rogue::services::Query* query{ search.add_queries() };
@@ -244,31 +341,35 @@ void singleReadAllNoResponse(const std::string& ipAddress)
     expression.add_operands();
 
     rogue::benchmarks::Dummy dummy{};
-    rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
+    rogue::utilities::ZipfianGenerator zipfian{spec.recordCount, .9};
     rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-    rogue::services::Response readResponse{};
+    rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+    rogue::benchmarks::LatencyHistogram histogram{};
+    series.attach(histogram);
     dummy.set_id(zipfianGenerator());
-    search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+    rogue::benchmarks::repack(*search.mutable_queries(0)->mutable_basic()->mutable_operands(0), dummy);
     
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
     for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
     {
+        // No responses are sent. Latency is the time for the stream to accept the write.
+        const auto sent{ std::chrono::steady_clock::now() };
         stream->Write(search);
+        histogram.record(sent, std::chrono::steady_clock::now());
     }
     stream->WritesDone();
 
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        BENCHMARK_FILE, 
-        "Send All No Response - Batch 1", start, finish, operationsPerThread, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread, 0, histogram };
 }
 
-void bulkReadAllWriteAll(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement bulkReadAllWriteAll(const rogue::benchmarks::WorkloadSpec& spec, const std::shared_ptr<grpc::Channel>& channel, const uint64_t batchSize, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS };
+    const uint64_t operationsPerThread{ spec.operationCount };
     
-    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
+    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(channel) };
     
     grpc::ClientContext readerContext{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
@@ -276,7 +377,8 @@ void bulkReadAllWriteAll(const std::string& ipAddress, const uint64_t batchSize)
     std::random_device randomizer{};
     std::mt19937 generator{ randomizer() };
     
-    rogue::services::Search search{};
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
     search.set_api_key(rogue::benchmarks::API_KEY);
     rogue::benchmarks::Dummy dummy{};
     
@@ -289,10 +391,15 @@ void bulkReadAllWriteAll(const std::string& ipAddress, const uint64_t batchSize)
         expression.add_operands();
     }
 
-    rogue::services::Response readResponse{};
+    rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+    rogue::benchmarks::LatencyHistogram histogram{};
+    series.attach(histogram);
+    rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread / batchSize + 1 };
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
     for(uint64_t count{ 0 }; count < operationsPerThread; count += batchSize)
     {
+        timestamps.sent(count / batchSize);
         stream->Write(search);
     }
     stream->WritesDone();
@@ -305,20 +412,19 @@ void bulkReadAllWriteAll(const std::string& ipAddress, const uint64_t batchSize)
             std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
             throw std::runtime_error{"Could not recover."};
         }
+        histogram.record(timestamps.at(count / batchSize), std::chrono::steady_clock::now(), batchSize);
     }
 
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        BENCHMARK_FILE, 
-        std::format("Send All Receive All - Batch {}", batchSize), start, finish, operationsPerThread, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread, 0, histogram };
 }
 
-void bulkReadWriteAlternate(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement bulkReadWriteAlternate(const rogue::benchmarks::WorkloadSpec& spec, const std::shared_ptr<grpc::Channel>& channel, const uint64_t batchSize, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS };
+    const uint64_t operationsPerThread{ spec.operationCount };
     
-    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
+    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(channel) };
     
     grpc::ClientContext readerContext{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
@@ -326,7 +432,8 @@ void bulkReadWriteAlternate(const std::string& ipAddress, const uint64_t batchSi
     std::random_device randomizer{};
     std::mt19937 generator{ randomizer() };
     
-    rogue::services::Search search{};
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
     search.set_api_key(rogue::benchmarks::API_KEY);
     rogue::benchmarks::Dummy dummy{};
     
@@ -339,10 +446,14 @@ void bulkReadWriteAlternate(const std::string& ipAddress, const uint64_t batchSi
         expression.add_operands();
     }
 
-    rogue::services::Response readResponse{};
+    rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+    rogue::benchmarks::LatencyHistogram histogram{};
+    series.attach(histogram);
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
     for(uint64_t count{ 0 }; count < operationsPerThread; count += batchSize)
     {
+        const auto sent{ std::chrono::steady_clock::now() };
         stream->Write(search);
         if(!stream->Read(&readResponse))
         {
@@ -350,21 +461,20 @@ void bulkReadWriteAlternate(const std::string& ipAddress, const uint64_t batchSi
             std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
             throw std::runtime_error{"Could not recover."};
         }
+        histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
     }
     stream->WritesDone();
     
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        BENCHMARK_FILE, 
-        std::format("Alternate Send Receive - Batch {}", batchSize), start, finish, operationsPerThread, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread, 0, histogram };
 }
 
-void bulkReadAllNoResponse(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement bulkReadAllNoResponse(const rogue::benchmarks::WorkloadSpec& spec, const std::shared_ptr<grpc::Channel>& channel, const uint64_t batchSize, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS };
+    const uint64_t operationsPerThread{ spec.operationCount };
     
-    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
+    std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(channel) };
     
     grpc::ClientContext readerContext{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
@@ -372,7 +482,8 @@ void bulkReadAllNoResponse(const std::string& ipAddress, const uint64_t batchSiz
     std::random_device randomizer{};
     std::mt19937 generator{ randomizer() };
     
-    rogue::services::Search search{};
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Search& search{ arena.create<rogue::services::Search>() };
     search.set_api_key(rogue::benchmarks::API_KEY);
     rogue::benchmarks::Dummy dummy{};
     
@@ -385,71 +496,80 @@ void bulkReadAllNoResponse(const std::string& ipAddress, const uint64_t batchSiz
         expression.add_operands();
     }
 
-    rogue::services::Response readResponse{};
+    rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+    rogue::benchmarks::LatencyHistogram histogram{};
+    series.attach(histogram);
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
     for(uint64_t count{ 0 }; count < operationsPerThread; count += batchSize)
     {
+        const auto sent{ std::chrono::steady_clock::now() };
         stream->Write(search);
+        histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
     }
     stream->WritesDone();
     
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        BENCHMARK_FILE, 
-        std::format("Send All No Response - Batch {}", batchSize), start, finish, operationsPerThread, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread, 0, histogram };
 }
 
-/*
-Observations:
+// Fills search with one EQUAL query for a zipfian id, as the single stream benchmarks search.
+void zipfianSearch(const rogue::benchmarks::WorkloadSpec& spec, rogue::services::Search& search)
+{
+    std::random_device randomizer{};
+    std::mt19937 generator{ randomizer() };
+    rogue::utilities::ZipfianGenerator zipfian{spec.recordCount, .9};
+    rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
 
-- An active stream causes baseline CPU idle of ~20%. 
-- Multiple streams caps at ~40% utilization.
-- 1 single stream is equivalent to 3 single streams. 
-    - Diminishing returns post-6 streams.
-    - Peaks around 7 streams. 1.9x Throughput Increase
-- Useage of separate channels (not uniquely identifiable) and stubs did not affect performance.
-*/
-void singleReadAllWriteAllThreaded(const std::string& ipAddress, const uint64_t threadCount)
+    search.set_api_key(rogue::benchmarks::API_KEY);
+    rogue::services::Basic& expression{ *search.add_queries()->mutable_basic() };
+    expression.set_logical_operator(rogue::services::LogicalOperator::AND);
+    expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
+    rogue::benchmarks::Dummy dummy{};
+    dummy.set_id(zipfianGenerator());
+    expression.add_operands()->PackFrom(dummy);
+}
+
+// Opens one stream per stub with the stub's bidirectional method, eg.
+// &rogue::services::Experiment::Stub::singleReadAllWriteAll, each on an executor worker.
+// Every stream fills one request with makeRequest(spec, request) on its own MessageArena, writes
+// it operationCount / 10 times, released together, then reads as many responses.
+template<typename Method, typename MakeRequest>
+rogue::benchmarks::Measurement readAllWriteAllStreams(
+    const rogue::benchmarks::WorkloadSpec& spec,
+    const std::vector<std::unique_ptr<rogue::services::Experiment::Stub>>& stubs,
+    Method method,
+    MakeRequest makeRequest,
+    rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
+    const uint64_t operationsPerThread{ spec.operationCount / 10 };
     std::latch latch{ 1 };
-    
-    for(uint32_t index{ 0 }; index < threadCount; ++index)
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(stubs.size());
+    series.attachAll(histograms);
+
+    for(uint64_t index{ 0 }; index < stubs.size(); ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
-            [&]() mutable
+        rogue::benchmarks::executor().detach_task(
+            [&, index]()
             {
-                std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-                    grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials())) };
                 grpc::ClientContext readerContext{};
-                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
-                    readerStub->singleReadAllWriteAll(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
-                
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                rogue::services::Query* query{ search.add_queries() };
-                rogue::services::Basic& expression{ *query->mutable_basic() };
-                expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                expression.add_operands();
-            
-                rogue::benchmarks::Dummy dummy{};
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-                rogue::services::Response readResponse{};
-                dummy.set_id(zipfianGenerator());
-                search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
-                
+                const auto stream{ std::invoke(method, *stubs[index], &readerContext) };
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& request{ arena.create<rogue::services::Search>() };
+                makeRequest(spec, request);
+                rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[index] };
+                rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread };
+
                 latch.wait();
                 for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
                 {
-                    stream->Write(search);
+                    timestamps.sent(count);
+                    stream->Write(request);
                 }
                 stream->WritesDone();
-            
+
                 for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
                 {
                     if(!stream->Read(&readResponse))
@@ -458,275 +578,260 @@ void singleReadAllWriteAllThreaded(const std::string& ipAddress, const uint64_t
                         std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
                         throw std::runtime_error{"Could not recover."};
                     }
+                    histogram.record(timestamps.at(count), std::chrono::steady_clock::now());
                 }
             }
         );
     }
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    series.start();
     latch.count_down();
     const auto start{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::threadpool.wait();
+    rogue::benchmarks::executor().wait();
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        THREAD_BENCHMARK_FILE, 
-        std::format("gRPC Single Read All Write All - {} thread(s)", threadCount), 
-        start, finish, operationsPerThread * threadCount, 0);
+    return rogue::benchmarks::Measurement{ start, finish, operationsPerThread * stubs.size(), 0, rogue::benchmarks::mergeHistograms(histograms) };
 }
 
-void singleReadAllWriteAllMultipleServers(const std::string& ipAddress, const uint64_t serverCount)
+// The stubs are created by the caller's thread, which runs on grpccores, not on the workers.
+rogue::benchmarks::Measurement singleReadAllWriteAllStubs(
+    const rogue::benchmarks::WorkloadSpec& spec,
+    const std::vector<std::unique_ptr<rogue::services::Experiment::Stub>>& stubs,
+    rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
-    std::latch latch{ 1 };
-    std::vector<uint32_t> ports{ 80, 82, 83, 84, 85 };
-    for(uint32_t count{ 0 }; count < serverCount; ++count)
+    return readAllWriteAllStreams(spec, stubs, &rogue::services::Experiment::Stub::singleReadAllWriteAll, zipfianSearch, series);
+}
+
+/*
+Observations:
+
+- An active stream causes baseline CPU idle of ~20%. 
+- Multiple streams caps at ~40% utilization.
+- 1 single stream is equivalent to 3 single streams. 
+    - Diminishing returns post-6 streams.
+    - Peaks around 7 streams. 1.9x Throughput Increase
+- Useage of separate channels (not uniquely identifiable) and stubs did not affect performance.
+*/
+rogue::benchmarks::Measurement singleReadAllWriteAllThreaded(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t threadCount, rogue::benchmarks::TimeSeries& series)
+{
+    std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{};
+    for(uint32_t index{ 0 }; index < threadCount; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
-            [&, index = count]() mutable
-            {
-                std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-                    grpc::CreateChannel(std::format("{}:{}", ipAddress, ports[index]), grpc::InsecureChannelCredentials())) };
-                grpc::ClientContext readerContext{};
-                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
-                    readerStub->singleReadAllWriteAll(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
-                
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                rogue::services::Query* query{ search.add_queries() };
-                rogue::services::Basic& expression{ *query->mutable_basic() };
-                expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                expression.add_operands();
-            
-                rogue::benchmarks::Dummy dummy{};
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-                rogue::services::Response readResponse{};
-                dummy.set_id(zipfianGenerator());
-                search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
-                
-                latch.wait();
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    stream->Write(search);
-                }
-                stream->WritesDone();
-            
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    if(!stream->Read(&readResponse))
-                    {
-                        grpc::Status status{ stream->Finish() };
-                        std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
-                        throw std::runtime_error{"Could not recover."};
-                    }
-                }
-            }
-        );
+        stubs.push_back(rogue::services::Experiment::NewStub(
+            grpc::CreateChannel(std::format("{}:80", spec.address), grpc::InsecureChannelCredentials())));
     }
+    return singleReadAllWriteAllStubs(spec, stubs, series);
+}
 
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    latch.count_down();
-    const auto start{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::threadpool.wait();
-    const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        MULTI_SERVER_BENCHMARK_FILE, 
-        std::format("gRPC Single Read All Write All - {} Servers", serverCount), 
-        start, finish, operationsPerThread * serverCount, 0);
+rogue::benchmarks::Measurement singleReadAllWriteAllMultipleServers(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t serverCount, rogue::benchmarks::TimeSeries& series)
+{
+    std::vector<uint32_t> ports{ 80, 82, 83, 84, 85 };
+    std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{};
+    for(uint32_t index{ 0 }; index < serverCount; ++index)
+    {
+        stubs.push_back(rogue::services::Experiment::NewStub(
+            grpc::CreateChannel(std::format("{}:{}", spec.address, ports[index]), grpc::InsecureChannelCredentials())));
+    }
+    return singleReadAllWriteAllStubs(spec, stubs, series);
 }
 
-void singleReadAllWriteAllMultiplePorts(const std::string& ipAddress, const uint64_t portCount)
+rogue::benchmarks::Measurement singleReadAllWriteAllMultiplePorts(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t portCount, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
-    std::latch latch{ 1 };
     std::vector<uint32_t> ports{ 86, 87, 88, 89, 90, 91, 92, 93, 94, 95, 96, 97, 98, 99, 100, 101 };
-    
+    std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{};
     for(uint32_t index{ 0 }; index < portCount; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
-            [&, count = index]() mutable
-            {
-                std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-                    grpc::CreateChannel(std::format("{}:{}", ipAddress, ports[count]), grpc::InsecureChannelCredentials())) };
-                grpc::ClientContext readerContext{};
-                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
-                    readerStub->singleReadAllWriteAll(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
-                
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                rogue::services::Query* query{ search.add_queries() };
-                rogue::services::Basic& expression{ *query->mutable_basic() };
-                expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                expression.add_operands();
-            
-                rogue::benchmarks::Dummy dummy{};
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-                rogue::services::Response readResponse{};
-                dummy.set_id(zipfianGenerator());
-                search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
-                
-                latch.wait();
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    stream->Write(search);
-                }
-                stream->WritesDone();
-            
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    if(!stream->Read(&readResponse))
-                    {
-                        grpc::Status status{ stream->Finish() };
-                        std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
-                        throw std::runtime_error{"Could not recover."};
-                    }
-                }
-            }
-        );
+        stubs.push_back(rogue::services::Experiment::NewStub(
+            grpc::CreateChannel(std::format("{}:{}", spec.address, ports[index]), grpc::InsecureChannelCredentials())));
     }
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    latch.count_down();
-    const auto start{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::threadpool.wait();
-    const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        MULTI_PORT_BENCHMARK_FILE, 
-        std::format("gRPC Single Read All Write All - {} port(s)", portCount), 
-        start, finish, operationsPerThread * portCount, 0);
+    return singleReadAllWriteAllStubs(spec, stubs, series);
 }
 
-void singleReadAllWriteAllForcedChannel(const std::string& ipAddress, const uint64_t threadCount)
+rogue::benchmarks::Measurement singleReadAllWriteAllForcedChannel(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t threadCount, rogue::benchmarks::TimeSeries& series)
 {
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / 10 };
-    std::latch latch{ 1 };
-    
+    std::vector<std::unique_ptr<rogue::services::Experiment::Stub>> stubs{};
     for(uint32_t index{ 0 }; index < threadCount; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
-            [&, count = index]() mutable
+        grpc::ChannelArguments arguments{};
+        arguments.SetInt("dummy", index);
+        stubs.push_back(rogue::services::Experiment::NewStub(
+            grpc::CreateCustomChannel(
+                std::format("{}:86",spec.address), 
+                grpc::InsecureChannelCredentials(), 
+                arguments)));
+    }
+    return singleReadAllWriteAllStubs(spec, stubs, series);
+}
+
+// The Experiment workloads over each of spec.transports against its own local server, so the same
+// client and server only differ by what carries the bytes:
+// - tcp: loopback TCP, the kernel network stack and HTTP/2 framing.
+// - unix: a unix domain socket, HTTP/2 framing without TCP/IP.
+// - inprocess: the server's in-process channel, neither. Serialization and gRPC's own call
+//   handling remain, so this is the ceiling any transport can reach.
+void transportBenchmarks(const rogue::benchmarks::WorkloadSpec& spec)
+{
+    const std::filesystem::path socket{ std::filesystem::temp_directory_path() / std::format("grpc_benchmarks_{}.sock", ::getpid()) };
+    for(const std::string& transport : spec.transports)
+    {
+        rogue::benchmarks::ServerOptions options{
+            .style = rogue::benchmarks::parseServerStyle(spec.localServer == "none" ? "sync" : spec.localServer),
+            .address = "127.0.0.1",
+            .ports = {},
+            .threads = spec.serverThreads };
+        if(transport == "tcp")
+        {
+            options.ports = { 0 };
+        }
+        else if(transport == "unix")
+        {
+            std::filesystem::remove(socket);
+            options.uris = { std::format("unix:{}", socket.string()) };
+        }
+        rogue::benchmarks::ExperimentServer server{ options };
+        const auto connect = [&]()
+        {
+            if(transport == "tcp")
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", count);
-                std::unique_ptr<rogue::services::Experiment::Stub> readerStub{ rogue::services::Experiment::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:86",ipAddress), 
-                        grpc::InsecureChannelCredentials(), 
-                        arguments)) };
-                
-                grpc::ClientContext readerContext{};
-                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
-                    readerStub->singleReadAllWriteAll(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
-                
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                rogue::services::Query* query{ search.add_queries() };
-                rogue::services::Basic& expression{ *query->mutable_basic() };
-                expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                expression.add_operands();
-            
-                rogue::benchmarks::Dummy dummy{};
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-                rogue::services::Response readResponse{};
-                dummy.set_id(zipfianGenerator());
-                search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
-                
-                latch.wait();
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    stream->Write(search);
-                }
-                stream->WritesDone();
-            
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    if(!stream->Read(&readResponse))
-                    {
-                        grpc::Status status{ stream->Finish() };
-                        std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
-                        throw std::runtime_error{"Could not recover."};
-                    }
-                }
+                return grpc::CreateChannel(std::format("127.0.0.1:{}", server.boundPorts()[0]), grpc::InsecureChannelCredentials());
             }
-        );
+            if(transport == "unix")
+            {
+                return grpc::CreateChannel(std::format("unix:{}", socket.string()), grpc::InsecureChannelCredentials());
+            }
+            return server.inProcessChannel();
+        };
+
+        rogue::benchmarks::repeat(spec, TRANSPORT_BENCHMARK_FILE, std::format("{} - Send All Receive All - Batch 1", transport), 
+            [&](const auto& phase, auto& series){ return singleReadAllWriteAll(phase, connect(), series); });
+        rogue::benchmarks::repeat(spec, TRANSPORT_BENCHMARK_FILE, std::format("{} - Alternate Send Receive - Batch 1", transport), 
+            [&](const auto& phase, auto& series){ return singleReadWriteAlternate(phase, connect(), series); });
+        rogue::benchmarks::repeat(spec, TRANSPORT_BENCHMARK_FILE, std::format("{} - Send All No Response - Batch 1", transport), 
+            [&](const auto& phase, auto& series){ return singleReadAllNoResponse(phase, connect(), series); });
+        for(const uint64_t batchSize : spec.batchSizes)
+        {
+            // Batch 1 has its rows above.
+            if(batchSize == 1)
+            {
+                continue;
+            }
+            rogue::benchmarks::repeat(spec, TRANSPORT_BENCHMARK_FILE, std::format("{} - Send All Receive All - Batch {}", transport, batchSize), 
+                [&](const auto& phase, auto& series){ return bulkReadAllWriteAll(phase, connect(), batchSize, series); });
+            rogue::benchmarks::repeat(spec, TRANSPORT_BENCHMARK_FILE, std::format("{} - Alternate Send Receive - Batch {}", transport, batchSize), 
+                [&](const auto& phase, auto& series){ return bulkReadWriteAlternate(phase, connect(), batchSize, series); });
+            rogue::benchmarks::repeat(spec, TRANSPORT_BENCHMARK_FILE, std::format("{} - Send All No Response - Batch {}", transport, batchSize), 
+                [&](const auto& phase, auto& series){ return bulkReadAllNoResponse(phase, connect(), batchSize, series); });
+        }
     }
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    latch.count_down();
-    const auto start{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::threadpool.wait();
-    const auto finish{ std::chrono::high_resolution_clock::now() };
-    rogue::benchmarks::logBenchmark(
-        FORCED_CHANNEL_BENCHMARK_FILE, 
-        std::format("gRPC Single Read All Write All Forced Channel - {} threads", threadCount), 
-        start, finish, operationsPerThread * threadCount, 0);
+    std::filesystem::remove(socket);
 }
 
-// NOTE: Run the following beforehand: bazel run //roguedb/management:sync_server &
 int main(int argc, char** argv)
 {
-    std::filesystem::remove(FORCED_CHANNEL_BENCHMARK_FILE);
-    rogue::benchmarks::initialLog(FORCED_CHANNEL_BENCHMARK_FILE);
-
-    std::filesystem::remove(MULTI_PORT_BENCHMARK_FILE);
-    rogue::benchmarks::initialLog(MULTI_PORT_BENCHMARK_FILE);
+    rogue::benchmarks::WorkloadSpec spec{};
+    spec.batchSizes = { 10, 100, 1000 };
+    try
+    {
+        spec = rogue::benchmarks::parseWorkloadSpec(argc, argv, spec);
+    }
+    catch(const std::invalid_argument& error)
+    {
+        std::cerr << error.what() << std::endl << rogue::benchmarks::workloadUsage(argv[0]);
+        return 1;
+    }
+    rogue::benchmarks::configureExecutor(spec);
+    rogue::benchmarks::describeRun(spec);
+    rogue::benchmarks::writeWorkloadSpec(SPEC_FILE, spec);
 
-    std::filesystem::remove(MULTI_SERVER_BENCHMARK_FILE);
-    rogue::benchmarks::initialLog(MULTI_SERVER_BENCHMARK_FILE);
-    
-    std::filesystem::remove(THREAD_BENCHMARK_FILE);
-    rogue::benchmarks::initialLog(THREAD_BENCHMARK_FILE);
+    // NOTE: With localserver = none, run the following beforehand: bazel run //roguedb/management:sync_server &
+    std::vector<std::unique_ptr<rogue::benchmarks::ExperimentServer>> servers{};
+    if(spec.localServer != "none")
+    {
+        servers = rogue::benchmarks::startBenchmarkServers({
+            .style = rogue::benchmarks::parseServerStyle(spec.localServer),
+            .address = spec.address,
+            .threads = spec.serverThreads });
+    }
 
-    std::filesystem::remove(BENCHMARK_FILE);
-    rogue::benchmarks::initialLog(BENCHMARK_FILE);
-    const std::string ipAddress{ argv[1] };
+    for(const std::string& file : { FORCED_CHANNEL_BENCHMARK_FILE, MULTI_PORT_BENCHMARK_FILE, 
+        MULTI_SERVER_BENCHMARK_FILE, THREAD_BENCHMARK_FILE, TRANSPORT_BENCHMARK_FILE, 
+        CLIENT_STYLE_BENCHMARK_FILE, BENCHMARK_FILE })
+    {
+        std::filesystem::remove(file);
+        std::filesystem::remove(rogue::benchmarks::repetitionsFile(file));
+        std::filesystem::remove(rogue::benchmarks::resourcesFile(file));
+        rogue::benchmarks::initialLog(file);
+    }
 
-    singleReadAllWriteAll(ipAddress);
-    singleReadWriteAlternate(ipAddress);
-    singleReadAllNoResponse(ipAddress);
+    rogue::benchmarks::repeat(spec, BENCHMARK_FILE, "Send All Receive All - Batch 1", 
+        [](const auto& phase, auto& series){ return singleReadAllWriteAll(phase, connect(phase), series); });
+    rogue::benchmarks::repeat(spec, BENCHMARK_FILE, "Alternate Send Receive - Batch 1", 
+        [](const auto& phase, auto& series){ return singleReadWriteAlternate(phase, connect(phase), series); });
+    rogue::benchmarks::repeat(spec, BENCHMARK_FILE, "Send All No Response - Batch 1", 
+        [](const auto& phase, auto& series){ return singleReadAllNoResponse(phase, connect(phase), series); });
 
-    const std::vector<uint64_t> grpcBatchSizes{ 10, 100, 1000 };
-    for(const auto& batchSize : grpcBatchSizes)
+    for(const auto& batchSize : spec.batchSizes)
     {
-        bulkReadAllWriteAll(ipAddress, batchSize);
-        bulkReadWriteAlternate(ipAddress, batchSize);
-        bulkReadAllNoResponse(ipAddress, batchSize);
+        // Batch 1 has its rows above, but still runs Read Only Bulk Async.
+        if(batchSize != 1)
+        {
+            rogue::benchmarks::repeat(spec, BENCHMARK_FILE, std::format("Send All Receive All - Batch {}", batchSize), 
+                [&](const auto& phase, auto& series){ return bulkReadAllWriteAll(phase, connect(phase), batchSize, series); });
+            rogue::benchmarks::repeat(spec, BENCHMARK_FILE, std::format("Alternate Send Receive - Batch {}", batchSize), 
+                [&](const auto& phase, auto& series){ return bulkReadWriteAlternate(phase, connect(phase), batchSize, series); });
+            rogue::benchmarks::repeat(spec, BENCHMARK_FILE, std::format("Send All No Response - Batch {}", batchSize), 
+                [&](const auto& phase, auto& series){ return bulkReadAllNoResponse(phase, connect(phase), batchSize, series); });
+        }
+        rogue::benchmarks::repeat(spec, BENCHMARK_FILE, std::format("Read Only Bulk Async {} ({} Streams)", batchSize, spec.streams), 
+            [&](const auto& phase, auto& series){ return readOnlyBulkAsync(phase, batchSize, series); });
     }
     
-    const std::vector<uint64_t> threads{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
-    for(const uint64_t threadCount : threads)
+    for(const uint64_t threadCount : spec.grpcThreads)
+    {
+        rogue::benchmarks::repeat(spec, FORCED_CHANNEL_BENCHMARK_FILE, 
+            std::format("gRPC Single Read All Write All Forced Channel - {} threads", threadCount), 
+            [&](const auto& phase, auto& series){ return singleReadAllWriteAllForcedChannel(phase, threadCount, series); });
+    }
+
+    for(const uint64_t portCount : spec.ports)
     {
-        singleReadAllWriteAllForcedChannel(ipAddress, threadCount);
+        rogue::benchmarks::repeat(spec, MULTI_PORT_BENCHMARK_FILE, 
+            std::format("gRPC Single Read All Write All - {} port(s)", portCount), 
+            [&](const auto& phase, auto& series){ return singleReadAllWriteAllMultiplePorts(phase, portCount, series); });
     }
 
-    const std::vector<uint64_t> ports{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
-    for(const uint64_t portCount : ports)
+    for(const uint64_t serverCount : spec.servers)
     {
-        singleReadAllWriteAllMultiplePorts(ipAddress, portCount);
+        rogue::benchmarks::repeat(spec, MULTI_SERVER_BENCHMARK_FILE, 
+            std::format("gRPC Single Read All Write All - {} Servers", serverCount), 
+            [&](const auto& phase, auto& series){ return singleReadAllWriteAllMultipleServers(phase, serverCount, series); });
     }
 
-    const std::vector<uint64_t> servers{ 1, 2, 3, 4, 5 };
-    for(const uint64_t serverCount : servers)
+    for(const uint64_t threadCount : spec.grpcThreads)
     {
-        singleReadAllWriteAllMultipleServers(ipAddress, serverCount);
+        rogue::benchmarks::repeat(spec, THREAD_BENCHMARK_FILE, 
+            std::format("gRPC Single Read All Write All - {} thread(s)", threadCount), 
+            [&](const auto& phase, auto& series){ return singleReadAllWriteAllThreaded(phase, threadCount, series); });
     }
 
-    for(const uint64_t threadCount : threads)
+    transportBenchmarks(spec);
+
+    for(const std::string& name : spec.clientStyles)
     {
-        singleReadAllWriteAllThreaded(ipAddress, threadCount);
+        const rogue::benchmarks::ClientStyle style{ rogue::benchmarks::parseClientStyle(name) };
+        const uint64_t streams{ rogue::benchmarks::styleStreams(style, spec.streams, spec.pollers) };
+        for(const uint64_t batchSize : spec.batchSizes)
+        {
+            rogue::benchmarks::repeat(spec, CLIENT_STYLE_BENCHMARK_FILE, 
+                std::format("{} Read Only - Batch {} ({} Streams)", rogue::benchmarks::clientStyleName(style), batchSize, streams), 
+                [&](const auto& phase, auto& series){ return clientStyleWorkload(phase, style, batchSize, phase.streams, 0, series); });
+            rogue::benchmarks::repeat(spec, CLIENT_STYLE_BENCHMARK_FILE, 
+                std::format("{} No Response - Batch {} ({} Streams)", rogue::benchmarks::clientStyleName(style), batchSize, streams), 
+                [&](const auto& phase, auto& series){ return clientStyleWorkload(phase, style, batchSize, 0, phase.streams, series); });
+            rogue::benchmarks::repeat(spec, CLIENT_STYLE_BENCHMARK_FILE, 
+                std::format("{} Mixed - Batch {} ({} Streams)", rogue::benchmarks::clientStyleName(style), batchSize, streams), 
+                [&](const auto& phase, auto& series){ return clientStyleWorkload(phase, style, batchSize, phase.streams / 2, phase.streams - phase.streams / 2, series); });
+        }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,304 @@
+#ifndef KEY_GENERATORS_H
+#define KEY_GENERATORS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "benchmarks/alias_table.h"
+#include "benchmarks/fast_random.h"
+#include "benchmarks/zipfian_generator.h"
+
+namespace rogue
+{
+    namespace utilities
+    {
+        using KeyEngine = Xoshiro256PlusPlus;
+
+        // Chooses the id of the next key to operate on. Ids are in [0, keys).
+        // Each worker owns its own generator and random engine. fill() writes a batch of keys
+        // at once so workers pay for the virtual call once per batch rather than per key.
+        class KeyGenerator
+        {
+        public:
+            virtual ~KeyGenerator() = default;
+            virtual uint64_t next(KeyEngine& rng) = 0;
+
+            virtual void fill(std::span<uint64_t> keys, KeyEngine& rng)
+            {
+                for(uint64_t& key : keys)
+                {
+                    key = next(rng);
+                }
+            }
+        };
+
+        class UniformKeyGenerator : public KeyGenerator
+        {
+        public:
+            explicit UniformKeyGenerator(const uint64_t keys) :
+                m_keys{ std::max(uint64_t{1}, keys) }
+            {}
+
+            uint64_t next(KeyEngine& rng) override
+            {
+                return reduce(rng(), m_keys);
+            }
+
+            void fill(std::span<uint64_t> keys, KeyEngine& rng) override
+            {
+                for(uint64_t& key : keys)
+                {
+                    key = reduce(rng(), m_keys);
+                }
+            }
+
+        private:
+            const uint64_t m_keys;
+        };
+
+        class SequentialKeyGenerator : public KeyGenerator
+        {
+        public:
+            SequentialKeyGenerator(
+                const uint64_t keys,
+                const uint64_t start = 0) :
+                m_keys{ std::max(uint64_t{1}, keys) },
+                m_next{ start % m_keys }
+            {}
+
+            uint64_t next(KeyEngine&) override
+            {
+                const uint64_t key{ m_next };
+                m_next = m_next + 1 == m_keys ? 0 : m_next + 1;
+                return key;
+            }
+
+        private:
+            const uint64_t m_keys;
+            uint64_t m_next;
+        };
+
+        // Rank 1 is the hottest key, so the hottest keys are adjacent ids.
+        // Sampled from an alias table shared between all workers with the same parameters.
+        class ZipfianKeyGenerator : public KeyGenerator
+        {
+        public:
+            ZipfianKeyGenerator(
+                const uint64_t keys,
+                const double exponent) :
+                m_table{ AliasTable::zipfian(std::max(uint64_t{1}, keys), exponent) }
+            {}
+
+            uint64_t next(KeyEngine& rng) override
+            {
+                return m_table->sample(rng());
+            }
+
+            void fill(std::span<uint64_t> keys, KeyEngine& rng) override
+            {
+                m_table->fill(keys, rng);
+            }
+
+        private:
+            std::shared_ptr<const AliasTable> m_table;
+        };
+
+        // Zipfian popularity with the hot keys spread across the key space by hashing the rank.
+        // Ranks are drawn from a much larger item space before hashing as YCSB does so that
+        // collisions from the modulo do not merge the hottest ranks together. The item space is
+        // too large for an alias table, so this one stays on rejection-inversion.
+        class ScrambledZipfianKeyGenerator : public KeyGenerator
+        {
+        public:
+            static constexpr uint64_t ITEM_SPACE{ 10000000000 };
+
+            ScrambledZipfianKeyGenerator(
+                const uint64_t keys,
+                const double exponent) :
+                m_keys{ std::max(uint64_t{1}, keys) },
+                m_zipfian{ ITEM_SPACE, exponent }
+            {}
+
+            // 64-bit FNV-1a over the bytes of the value.
+            static uint64_t fnvHash(uint64_t value)
+            {
+                uint64_t hash{ 0xCBF29CE484222325 };
+                for(uint32_t byte{ 0 }; byte < sizeof(uint64_t); ++byte)
+                {
+                    hash ^= value & 0xFF;
+                    hash *= 1099511628211;
+                    value >>= 8;
+                }
+                return hash;
+            }
+
+            uint64_t next(KeyEngine& rng) override
+            {
+                return fnvHash(m_zipfian.next(rng)) % m_keys;
+            }
+
+        private:
+            const uint64_t m_keys;
+            ZipfianGenerator m_zipfian;
+        };
+
+        // hotOperationFraction of the operations go to the first hotKeyFraction of the keys.
+        // The rest are uniform over the remaining keys.
+        class HotspotKeyGenerator : public KeyGenerator
+        {
+        public:
+            HotspotKeyGenerator(
+                const uint64_t keys,
+                const double hotKeyFraction,
+                const double hotOperationFraction) :
+                m_keys{ std::max(uint64_t{1}, keys) },
+                m_hotKeys{ std::clamp(static_cast<uint64_t>(keys * hotKeyFraction), uint64_t{1}, m_keys) },
+                m_hotOperationFraction{ std::clamp(hotOperationFraction, 0.0, 1.0) }
+            {}
+
+            uint64_t next(KeyEngine& rng) override
+            {
+                if(rng.uniform() < m_hotOperationFraction || m_hotKeys == m_keys)
+                {
+                    return reduce(rng(), m_hotKeys);
+                }
+                return m_hotKeys + reduce(rng(), m_keys - m_hotKeys);
+            }
+
+        private:
+            const uint64_t m_keys;
+            const uint64_t m_hotKeys;
+            const double m_hotOperationFraction;
+        };
+
+        // Skewed towards the most recently inserted ids. inserted is the next id to insert.
+        // Writers claim their ids from it with fetch_add, so the skew follows them while the
+        // benchmark runs. Rank 1 is the newest id.
+        // A bulk fill reads inserted once, so its keys lag inserts made during the batch.
+        class LatestKeyGenerator : public KeyGenerator
+        {
+        public:
+            LatestKeyGenerator(
+                const std::atomic<uint64_t>& inserted,
+                const uint64_t keys,
+                const double exponent) :
+                m_inserted{ inserted },
+                m_table{ AliasTable::zipfian(std::max(uint64_t{1}, keys), exponent) }
+            {}
+
+            uint64_t next(KeyEngine& rng) override
+            {
+                const uint64_t newest{ std::max(uint64_t{1}, m_inserted.load(std::memory_order_relaxed)) - 1 };
+                return newest - std::min(newest, m_table->sample(rng()));
+            }
+
+            void fill(std::span<uint64_t> keys, KeyEngine& rng) override
+            {
+                const uint64_t newest{ std::max(uint64_t{1}, m_inserted.load(std::memory_order_relaxed)) - 1 };
+                m_table->fill(keys, rng);
+                for(uint64_t& key : keys)
+                {
+                    key = newest - std::min(newest, key);
+                }
+            }
+
+        private:
+            const std::atomic<uint64_t>& m_inserted;
+            std::shared_ptr<const AliasTable> m_table;
+        };
+
+        enum class KeyDistribution
+        {
+            UNIFORM,
+            SEQUENTIAL,
+            ZIPFIAN,
+            SCRAMBLED_ZIPFIAN,
+            HOTSPOT,
+            LATEST
+        };
+
+        struct KeySelection
+        {
+            KeyDistribution distribution{ KeyDistribution::ZIPFIAN };
+            uint64_t keys{ 1 };
+            double exponent{ .9 };
+            double hotKeyFraction{ .2 };
+            double hotOperationFraction{ .8 };
+        };
+
+        inline KeyDistribution keyDistribution(const std::string& name)
+        {
+            if(name == "uniform") return KeyDistribution::UNIFORM;
+            if(name == "sequential") return KeyDistribution::SEQUENTIAL;
+            if(name == "zipfian") return KeyDistribution::ZIPFIAN;
+            if(name == "scrambled") return KeyDistribution::SCRAMBLED_ZIPFIAN;
+            if(name == "hotspot") return KeyDistribution::HOTSPOT;
+            if(name == "latest") return KeyDistribution::LATEST;
+            throw std::invalid_argument{ std::format("Unknown key distribution: {}", name) };
+        }
+
+        // inserted is only read by the latest distribution.
+        inline std::unique_ptr<KeyGenerator> makeKeyGenerator(
+            const KeySelection& selection,
+            const std::atomic<uint64_t>& inserted)
+        {
+            switch(selection.distribution)
+            {
+                case KeyDistribution::UNIFORM:
+                    return std::make_unique<UniformKeyGenerator>(selection.keys);
+                case KeyDistribution::SEQUENTIAL:
+                    return std::make_unique<SequentialKeyGenerator>(selection.keys);
+                case KeyDistribution::SCRAMBLED_ZIPFIAN:
+                    return std::make_unique<ScrambledZipfianKeyGenerator>(selection.keys, selection.exponent);
+                case KeyDistribution::HOTSPOT:
+                    return std::make_unique<HotspotKeyGenerator>(
+                        selection.keys, selection.hotKeyFraction, selection.hotOperationFraction);
+                case KeyDistribution::LATEST:
+                    return std::make_unique<LatestKeyGenerator>(inserted, selection.keys, selection.exponent);
+                default:
+                    return std::make_unique<ZipfianKeyGenerator>(selection.keys, selection.exponent);
+            }
+        }
+
+        // Hands out keys one at a time from batches filled in bulk.
+        class KeyBuffer
+        {
+        public:
+            KeyBuffer(
+                std::unique_ptr<KeyGenerator> generator,
+                const uint64_t seed,
+                const uint64_t capacity = 256) :
+                m_generator{ std::move(generator) },
+                m_engine{ seed },
+                m_keys(std::max(uint64_t{1}, capacity)),
+                m_position{ m_keys.size() }
+            {}
+
+            uint64_t next()
+            {
+                if(m_position == m_keys.size())
+                {
+                    m_generator->fill(m_keys, m_engine);
+                    m_position = 0;
+                }
+                return m_keys[m_position++];
+            }
+
+        private:
+            std::unique_ptr<KeyGenerator> m_generator;
+            KeyEngine m_engine;
+            std::vector<uint64_t> m_keys;
+            uint64_t m_position;
+        };
+    }
+}
+
+#endif //KEY_GENERATORS_H
@@ -0,0 +1,338 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Lock-free progress of one worker, sampled by the TimeSeries reporter while the worker
+        // runs. Same log-linear layout as LatencyHistogram but coarser (~3% relative error) so a
+        // sample stays cheap. Each counter has a single writer, eg. completions are only recorded
+        // by the reading thread and issued requests only by the writing one.
+        class IntervalCounters
+        {
+        public:
+            static constexpr uint64_t SUB_BUCKET_BITS{ 5 };
+            static constexpr uint64_t SUB_BUCKET_COUNT{ uint64_t{1} << SUB_BUCKET_BITS };
+            static constexpr uint64_t SUB_BUCKET_HALF{ SUB_BUCKET_COUNT / 2 };
+            static constexpr uint64_t MAX_MAGNITUDE{ 42 };
+            static constexpr uint64_t BUCKET_COUNT{
+                SUB_BUCKET_COUNT + (MAX_MAGNITUDE - SUB_BUCKET_BITS) * SUB_BUCKET_HALF };
+
+            static uint64_t bucketIndex(uint64_t value)
+            {
+                value = std::min(value, (uint64_t{1} << MAX_MAGNITUDE) - 1);
+                const uint64_t magnitude{ static_cast<uint64_t>(std::bit_width(value)) };
+                if(magnitude <= SUB_BUCKET_BITS)
+                {
+                    return value;
+                }
+                const uint64_t shift{ magnitude - SUB_BUCKET_BITS };
+                return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF
+                    + ((value >> shift) - SUB_BUCKET_HALF);
+            }
+
+            static uint64_t bucketValue(const uint64_t index)
+            {
+                if(index < SUB_BUCKET_COUNT)
+                {
+                    return index;
+                }
+                const uint64_t shift{ (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1 };
+                const uint64_t subBucket{ (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF };
+                return ((subBucket + 1) << shift) - 1;
+            }
+
+            void record(const uint64_t nanoseconds, const uint64_t count)
+            {
+                add(m_counts[bucketIndex(nanoseconds)], count);
+                add(m_completed, count);
+            }
+
+            // Operations sent but not yet recorded count as in flight.
+            void issued(const uint64_t count) { add(m_issued, count); }
+            void failed(const uint64_t count = 1) { m_errors.fetch_add(count, std::memory_order_relaxed); }
+
+            uint64_t completed() const { return m_completed.load(std::memory_order_relaxed); }
+            uint64_t issued() const { return m_issued.load(std::memory_order_relaxed); }
+            uint64_t errors() const { return m_errors.load(std::memory_order_relaxed); }
+            uint64_t countAt(const uint64_t index) const { return m_counts[index].load(std::memory_order_relaxed); }
+
+        private:
+            // Single writer, so a plain load and store is enough and avoids a locked add.
+            static void add(std::atomic<uint64_t>& counter, const uint64_t count)
+            {
+                counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+            }
+
+            std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_counts{};
+            alignas(64) std::atomic<uint64_t> m_completed{ 0 };
+            alignas(64) std::atomic<uint64_t> m_issued{ 0 };
+            std::atomic<uint64_t> m_errors{ 0 };
+        };
+
+        // HDR-style log-linear histogram of latencies in nanoseconds.
+        // Values below 2^SUB_BUCKET_BITS are recorded exactly. Above that, every power of two
+        // is split into 2^(SUB_BUCKET_BITS - 1) linear sub-buckets giving ~0.1% relative error.
+        // Each worker owns one histogram and records without synchronization. The per-worker
+        // histograms get merged after the worker threads finish.
+        class LatencyHistogram
+        {
+        public:
+            static constexpr uint64_t SUB_BUCKET_BITS{ 11 };
+            static constexpr uint64_t SUB_BUCKET_COUNT{ uint64_t{1} << SUB_BUCKET_BITS };
+            static constexpr uint64_t SUB_BUCKET_HALF{ SUB_BUCKET_COUNT / 2 };
+            static constexpr uint64_t MAX_MAGNITUDE{ 42 }; // ~73 minutes in nanoseconds.
+            static constexpr uint64_t MAX_TRACKABLE{ (uint64_t{1} << MAX_MAGNITUDE) - 1 };
+            static constexpr uint64_t BUCKET_COUNT{
+                SUB_BUCKET_COUNT + (MAX_MAGNITUDE - SUB_BUCKET_BITS) * SUB_BUCKET_HALF };
+
+            LatencyHistogram() :
+                m_counts(BUCKET_COUNT, 0)
+            {}
+
+            static uint64_t bucketIndex(uint64_t value)
+            {
+                value = std::min(value, MAX_TRACKABLE);
+                const uint64_t magnitude{ static_cast<uint64_t>(std::bit_width(value)) };
+                if(magnitude <= SUB_BUCKET_BITS)
+                {
+                    return value;
+                }
+                const uint64_t shift{ magnitude - SUB_BUCKET_BITS };
+                return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF
+                    + ((value >> shift) - SUB_BUCKET_HALF);
+            }
+
+            // Highest value that maps into the bucket.
+            static uint64_t bucketValue(const uint64_t index)
+            {
+                if(index < SUB_BUCKET_COUNT)
+                {
+                    return index;
+                }
+                const uint64_t shift{ (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF + 1 };
+                const uint64_t subBucket{ (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF + SUB_BUCKET_HALF };
+                return ((subBucket + 1) << shift) - 1;
+            }
+
+            void record(const uint64_t nanoseconds, const uint64_t count = 1)
+            {
+                m_counts[bucketIndex(nanoseconds)] += count;
+                m_total += count;
+                m_sum += static_cast<double>(nanoseconds) * count;
+                m_min = std::min(m_min, nanoseconds);
+                m_max = std::max(m_max, nanoseconds);
+                if(m_live != nullptr)
+                {
+                    m_live->record(nanoseconds, count);
+                }
+            }
+
+            void record(
+                const std::chrono::steady_clock::time_point start,
+                const std::chrono::steady_clock::time_point finish,
+                const uint64_t count = 1)
+            {
+                record(static_cast<uint64_t>(std::max<int64_t>(0,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count())), count);
+            }
+
+            void merge(const LatencyHistogram& other)
+            {
+                for(uint64_t index{ 0 }; index < BUCKET_COUNT; ++index)
+                {
+                    m_counts[index] += other.m_counts[index];
+                }
+                m_total += other.m_total;
+                m_sum += other.m_sum;
+                m_min = std::min(m_min, other.m_min);
+                m_max = std::max(m_max, other.m_max);
+            }
+
+            void reset()
+            {
+                std::fill(m_counts.begin(), m_counts.end(), 0);
+                m_total = 0;
+                m_sum = 0;
+                m_min = UINT64_MAX;
+                m_max = 0;
+            }
+
+            // Mirrors every recording into the counters, see TimeSeries. nullptr detaches.
+            void attach(IntervalCounters* live) { m_live = live; }
+            // Operations sent but not yet recorded, forwarded to the attached counters if any.
+            void issued(const uint64_t count) const
+            {
+                if(m_live != nullptr)
+                {
+                    m_live->issued(count);
+                }
+            }
+
+            uint64_t count() const { return m_total; }
+            uint64_t max() const { return m_max; }
+            uint64_t min() const { return m_total == 0 ? 0 : m_min; }
+            double mean() const { return m_total == 0 ? 0 : m_sum / m_total; }
+            uint64_t countAt(const uint64_t index) const { return m_counts[index]; }
+
+            // Percentile in [0, 100]. Returns 0 for an empty histogram.
+            uint64_t percentile(const double percent) const
+            {
+                if(m_total == 0)
+                {
+                    return 0;
+                }
+                const uint64_t target{ std::max(uint64_t{1}, static_cast<uint64_t>(
+                    std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * m_total))) };
+                uint64_t seen{ 0 };
+                for(uint64_t index{ 0 }; index < BUCKET_COUNT; ++index)
+                {
+                    seen += m_counts[index];
+                    if(seen >= target)
+                    {
+                        return std::clamp(bucketValue(index), min(), m_max);
+                    }
+                }
+                return m_max;
+            }
+
+            // Writes the percentile distribution in the HdrHistogram text format (.hgrm) with
+            // values in microseconds so runs can be diffed or plotted with standard tooling.
+            void dump(std::ostream& output) const
+            {
+                constexpr uint32_t TICKS_PER_HALF_DISTANCE{ 5 };
+                const auto row = [&](const double percent)
+                {
+                    const double fraction{ percent / 100.0 };
+                    const uint64_t totalCount{ static_cast<uint64_t>(std::ceil(fraction * m_total)) };
+                    output << std::format("{:12.3f} {:2.12f} {:10} {:14.2f}\n",
+                        percentile(percent) / 1000.0, fraction, totalCount,
+                        fraction < 1.0 ? 1.0 / (1.0 - fraction) : INFINITY);
+                };
+
+                output << std::format("{:>12} {:>14} {:>10} {:>14}\n\n",
+                    "Value", "Percentile", "TotalCount", "1/(1-Percentile)");
+                if(m_total > 0)
+                {
+                    for(uint32_t level{ 0 }; std::pow(2.0, level) <= m_total; ++level)
+                    {
+                        const double remaining{ 100.0 / std::pow(2.0, level) };
+                        for(uint32_t tick{ 0 }; tick < TICKS_PER_HALF_DISTANCE; ++tick)
+                        {
+                            row(100.0 - remaining + (remaining / 2.0) * tick / TICKS_PER_HALF_DISTANCE);
+                        }
+                    }
+                    row(100.0);
+                }
+
+                double variance{ 0 };
+                for(uint64_t index{ 0 }; index < BUCKET_COUNT; ++index)
+                {
+                    if(m_counts[index] > 0)
+                    {
+                        const double delta{ bucketValue(index) - mean() };
+                        variance += delta * delta * m_counts[index];
+                    }
+                }
+                output << std::format("#[Mean    = {:12.3f}, StdDeviation   = {:12.3f}]\n",
+                    mean() / 1000.0, m_total == 0 ? 0.0 : std::sqrt(variance / m_total) / 1000.0);
+                output << std::format("#[Max     = {:12.3f}, Total count    = {:12}]\n", m_max / 1000.0, m_total);
+                output << std::format("#[Buckets = {:12}, SubBuckets     = {:12}]\n",
+                    MAX_MAGNITUDE - SUB_BUCKET_BITS + 1, SUB_BUCKET_COUNT);
+            }
+
+        private:
+            std::vector<uint64_t> m_counts;
+            uint64_t m_total{ 0 };
+            double m_sum{ 0 };
+            uint64_t m_min{ UINT64_MAX };
+            uint64_t m_max{ 0 };
+            IntervalCounters* m_live{ nullptr };
+        };
+
+        // Send timestamps of a single stream. The writer stamps each message before Write and
+        // the reader takes them in order as responses report the message finished. Responses
+        // are not correlated to a request otherwise, so the ordering of the stream is relied on.
+        class StreamTimestamps
+        {
+        public:
+            explicit StreamTimestamps(const uint64_t capacity) :
+                m_capacity{ std::max(uint64_t{1}, capacity) },
+                m_sent{ std::make_unique<std::atomic<int64_t>[]>(m_capacity) }
+            {}
+
+            void sent(const uint64_t index)
+            {
+                m_sent[index % m_capacity].store(
+                    std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_release);
+            }
+
+            void sent(const uint64_t index, const std::chrono::steady_clock::time_point time)
+            {
+                m_sent[index % m_capacity].store(time.time_since_epoch().count(), std::memory_order_release);
+            }
+
+            std::chrono::steady_clock::time_point at(const uint64_t index) const
+            {
+                return std::chrono::steady_clock::time_point{ std::chrono::steady_clock::duration{
+                    m_sent[index % m_capacity].load(std::memory_order_acquire) } };
+            }
+
+        private:
+            const uint64_t m_capacity;
+            std::unique_ptr<std::atomic<int64_t>[]> m_sent;
+        };
+
+        // Converts Response.finished acknowledgements into per-batch latencies. Every batch
+        // of batchSize queries counts as complete once batchSize more query ids finish.
+        class FinishedTracker
+        {
+        public:
+            FinishedTracker(
+                const StreamTimestamps& timestamps,
+                LatencyHistogram& histogram,
+                const uint64_t batchSize) :
+                m_timestamps{ timestamps },
+                m_histogram{ &histogram },
+                m_batchSize{ std::max(uint64_t{1}, batchSize) }
+            {}
+
+            // Records into histogram from now on, eg. that of the thread a stream resumed on.
+            void rebind(LatencyHistogram& histogram) { m_histogram = &histogram; }
+
+            void finished(const uint64_t queries)
+            {
+                m_finished += queries;
+                const auto now{ std::chrono::steady_clock::now() };
+                while(m_finished >= (m_completed + 1) * m_batchSize)
+                {
+                    m_histogram->record(m_timestamps.at(m_completed++), now, m_batchSize);
+                }
+            }
+
+            uint64_t completed() const { return m_completed; }
+
+        private:
+            const StreamTimestamps& m_timestamps;
+            LatencyHistogram* m_histogram;
+            const uint64_t m_batchSize;
+            uint64_t m_finished{ 0 };
+            uint64_t m_completed{ 0 };
+        };
+    }
+}
+
+#endif //LATENCY_HISTOGRAM_H
@@ -0,0 +1,56 @@
+#ifndef MESSAGE_ARENA_H
+#define MESSAGE_ARENA_H
+
+#include <cstdint>
+#include <vector>
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/arena.h>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Owns the requests and responses a worker reuses for every operation. Their sub-messages,
+        // repeated fields and Any operands are bump-allocated from one block instead of spread
+        // over the heap, and are freed all at once when the worker finishes. Any values are
+        // still strings on the heap, but a reused message keeps their capacity between operations.
+        class MessageArena
+        {
+        public:
+            static constexpr uint64_t INITIAL_BLOCK{ 64 * 1024 };
+
+            explicit MessageArena(const uint64_t initialBlock = INITIAL_BLOCK) :
+                m_block(initialBlock),
+                m_arena{ m_block.data(), m_block.size() }
+            {}
+
+            MessageArena(const MessageArena&) = delete;
+            MessageArena& operator=(const MessageArena&) = delete;
+
+            template<typename Message>
+            Message& create()
+            {
+                return *google::protobuf::Arena::Create<Message>(&m_arena);
+            }
+
+        private:
+            std::vector<char> m_block;
+            google::protobuf::Arena m_arena;
+        };
+
+        // PackFrom builds the type url, a heap allocated string, on every call. An Any that
+        // already holds the type only has its value reserialized, reusing its capacity.
+        template<typename Message>
+        void repack(google::protobuf::Any& any, const Message& message)
+        {
+            if(!any.Is<Message>())
+            {
+                any.PackFrom(message);
+                return;
+            }
+            message.SerializeToString(any.mutable_value());
+        }
+    }
+}
+
+#endif //MESSAGE_ARENA_H
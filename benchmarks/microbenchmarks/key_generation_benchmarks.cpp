@@ -0,0 +1,122 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "benchmarks/coroutines.h"
+#include "benchmarks/key_generators.h"
+#include "benchmarks/zipfian_generator.h"
+
+// Client-side cost of choosing keys, single threaded. Keys match the initial data of the
+// cloud benchmarks so the alias tables are the size the workers use.
+const std::string BENCHMARK_FILE{ "KEY_GENERATION_BENCHMARKS.md" };
+constexpr uint64_t KEYS{ 5000000 };
+constexpr uint64_t SAMPLES{ 50000000 };
+constexpr uint64_t BATCH_SIZE{ 256 };
+constexpr double EXPONENT{ .9 };
+
+// Keeps the compiler from discarding the generated keys.
+uint64_t checksum{ 0 };
+
+void benchmark(
+    std::ofstream& output,
+    const std::string& name,
+    const std::function<void(std::span<uint64_t>)>& fill)
+{
+    std::vector<uint64_t> keys(BATCH_SIZE);
+    fill(keys);
+
+    const auto start{ std::chrono::steady_clock::now() };
+    for(uint64_t count{ 0 }; count < SAMPLES; count += BATCH_SIZE)
+    {
+        fill(keys);
+        checksum += keys[count % BATCH_SIZE];
+    }
+    const auto finish{ std::chrono::steady_clock::now() };
+
+    const double nanoseconds{ static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()) };
+    const std::string row{ std::format("| {} | {:.2f} | {:.1f}M |",
+        name, nanoseconds / SAMPLES, SAMPLES / nanoseconds * 1000.0) };
+    std::cout << row << std::endl;
+    output << row << std::endl;
+}
+
+int main()
+{
+    std::filesystem::remove(BENCHMARK_FILE);
+    std::ofstream output{ BENCHMARK_FILE, std::ios::app };
+    output << "| Key Generator | ns/key | Keys/s |" << std::endl;
+    output << "| --- | --- | --- |" << std::endl;
+
+    std::random_device randomizer{};
+    const uint64_t seed{ randomizer() };
+    const std::atomic<uint64_t> inserted{ KEYS };
+
+    // Original path: rejection-inversion resumed through a coroutine for every key.
+    {
+        std::mt19937 generator{ static_cast<uint32_t>(seed) };
+        rogue::utilities::ZipfianGenerator zipfian{ KEYS, EXPONENT };
+        rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
+        benchmark(output, "Zipfian coroutine (mt19937)", [&](std::span<uint64_t> keys)
+        {
+            for(uint64_t& key : keys)
+            {
+                key = zipfianGenerator();
+            }
+        });
+    }
+
+    {
+        rogue::utilities::Xoshiro256PlusPlus generator{ seed };
+        rogue::utilities::ZipfianGenerator zipfian{ KEYS, EXPONENT };
+        benchmark(output, "Zipfian rejection-inversion (xoshiro256++)", [&](std::span<uint64_t> keys)
+        {
+            for(uint64_t& key : keys)
+            {
+                key = zipfian.next(generator);
+            }
+        });
+    }
+
+    const std::vector<std::pair<std::string, rogue::utilities::KeyDistribution>> distributions{
+        { "Zipfian", rogue::utilities::KeyDistribution::ZIPFIAN },
+        { "Scrambled Zipfian", rogue::utilities::KeyDistribution::SCRAMBLED_ZIPFIAN },
+        { "Latest", rogue::utilities::KeyDistribution::LATEST },
+        { "Hotspot", rogue::utilities::KeyDistribution::HOTSPOT },
+        { "Uniform", rogue::utilities::KeyDistribution::UNIFORM },
+        { "Sequential", rogue::utilities::KeyDistribution::SEQUENTIAL }
+    };
+    for(const auto& [name, distribution] : distributions)
+    {
+        rogue::utilities::KeyEngine generator{ seed };
+        const rogue::utilities::KeySelection selection{ distribution, KEYS, EXPONENT };
+        std::unique_ptr<rogue::utilities::KeyGenerator> keyGenerator{
+            rogue::utilities::makeKeyGenerator(selection, inserted) };
+        benchmark(output, std::format("{} fill", name), [&](std::span<uint64_t> keys)
+        {
+            keyGenerator->fill(keys, generator);
+        });
+    }
+
+    {
+        rogue::utilities::KeyBuffer keyBuffer{ rogue::utilities::makeKeyGenerator(
+            rogue::utilities::KeySelection{ rogue::utilities::KeyDistribution::ZIPFIAN, KEYS, EXPONENT }, inserted), seed };
+        benchmark(output, "Zipfian KeyBuffer next", [&](std::span<uint64_t> keys)
+        {
+            for(uint64_t& key : keys)
+            {
+                key = keyBuffer.next();
+            }
+        });
+    }
+
+    std::cout << "checksum: " << checksum << std::endl;
+    return 0;
+}
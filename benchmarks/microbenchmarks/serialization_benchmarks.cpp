@@ -0,0 +1,118 @@
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <grpcpp/grpcpp.h>
+
+#include "benchmarks/common.h"
+#include "benchmarks/workload_spec.h"
+#include "getting_started/roguedb.grpc.pb.h"
+#include "protos/dummy.pb.h"
+#include "roguedb_driver/cpp/row_encoder.h"
+
+// Client-side cost of turning typed rows into the bytes of an Insert, single threaded, so
+// bytes/s is per core. Both paths end with a ByteBuffer ready for the stream, as gRPC's Write
+// would serialize a typed Insert into one.
+const std::string BENCHMARK_FILE{ "SERIALIZATION_BENCHMARKS.md" };
+constexpr uint64_t ROWS{ 1000000 };
+constexpr uint64_t BATCH_SIZE{ 1000 };
+
+// Keeps the compiler from discarding the serialized requests.
+uint64_t checksum{ 0 };
+
+// Serializes one batch of rows and returns its size in bytes.
+using Serialize = std::function<uint64_t(rogue::benchmarks::Dummy&)>;
+
+void benchmark(
+    std::ofstream& output,
+    const std::string& name,
+    rogue::benchmarks::Dummy& dummy,
+    const Serialize& serialize)
+{
+    serialize(dummy);
+
+    uint64_t bytes{ 0 };
+    const auto start{ std::chrono::steady_clock::now() };
+    for(uint64_t count{ 0 }; count < ROWS; count += BATCH_SIZE)
+    {
+        bytes += serialize(dummy);
+    }
+    const auto finish{ std::chrono::steady_clock::now() };
+    checksum += bytes;
+
+    const double nanoseconds{ static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count()) };
+    const std::string row{ std::format("| {} | {:.1f} | {:.0f} | {:.2f}M |",
+        name, nanoseconds / ROWS, bytes / nanoseconds * 1000.0, ROWS / nanoseconds * 1000.0) };
+    std::cout << row << std::endl;
+    output << row << std::endl;
+}
+
+int main()
+{
+    std::filesystem::remove(BENCHMARK_FILE);
+    std::ofstream output{ BENCHMARK_FILE, std::ios::app };
+    output << "| Serialization | ns/row | MB/s per core | Rows/s |" << std::endl;
+    output << "| --- | --- | --- | --- |" << std::endl;
+
+    for(const uint64_t fieldLength : { 10, 50, 500 })
+    {
+        rogue::benchmarks::WorkloadSpec spec{};
+        spec.fieldLength = fieldLength;
+        rogue::benchmarks::Dummy dummy{};
+        rogue::benchmarks::fillFields(dummy, spec);
+
+        rogue::services::Insert insert{};
+        insert.set_api_key(rogue::benchmarks::API_KEY);
+        const auto packFrom{ [&insert](rogue::benchmarks::Dummy& row)
+        {
+            insert.clear_messages();
+            for(uint64_t index{ 0 }; index < BATCH_SIZE; ++index)
+            {
+                row.set_id(index);
+                insert.add_messages()->PackFrom(row);
+            }
+            grpc::ByteBuffer buffer{};
+            bool owned{ false };
+            if(!grpc::SerializationTraits<rogue::services::Insert>::Serialize(insert, &buffer, &owned).ok())
+            {
+                throw std::runtime_error{ "Could not serialize the Insert." };
+            }
+            return static_cast<uint64_t>(buffer.Length());
+        } };
+
+        rogue::driver::RowEncoder encoder{ rogue::benchmarks::API_KEY };
+        const auto encode{ [&encoder](rogue::benchmarks::Dummy& row)
+        {
+            for(uint64_t index{ 0 }; index < BATCH_SIZE; ++index)
+            {
+                row.set_id(index);
+                encoder.add(row);
+            }
+            return static_cast<uint64_t>(encoder.release().Length());
+        } };
+
+        // Both paths must produce the request the server parses.
+        packFrom(dummy);
+        for(uint64_t index{ 0 }; index < BATCH_SIZE; ++index)
+        {
+            dummy.set_id(index);
+            encoder.add(dummy);
+        }
+        if(encoder.bytes() != insert.SerializeAsString())
+        {
+            throw std::runtime_error{ "RowEncoder bytes differ from PackFrom." };
+        }
+        encoder.clear();
+
+        benchmark(output, std::format("PackFrom ({} byte fields)", fieldLength), dummy, packFrom);
+        benchmark(output, std::format("RowEncoder ({} byte fields)", fieldLength), dummy, encode);
+    }
+
+    std::cout << "checksum: " << checksum << std::endl;
+    return 0;
+}
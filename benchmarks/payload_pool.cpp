@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+#include <string>
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "benchmarks/common.h"
+#include "benchmarks/payload_pool.h"
+
+#include "getting_started/roguedb.pb.h"
+
+namespace
+{
+    const std::string INSERT_METHOD{ "/rogue.services.RogueDB/insert" };
+
+    // Parsers accept varints of up to ten bytes whatever their value, which covers all 64 bits.
+    void writeKey(char* destination, uint64_t key)
+    {
+        for(uint64_t index{ 0 }; index < rogue::benchmarks::PayloadPool::KEY_BYTES - 1; ++index)
+        {
+            destination[index] = static_cast<char>((key & 0x7F) | 0x80);
+            key >>= 7;
+        }
+        destination[rogue::benchmarks::PayloadPool::KEY_BYTES - 1] = static_cast<char>(key & 0x01);
+    }
+
+    void* tag(const uint64_t value)
+    {
+        return reinterpret_cast<void*>(value);
+    }
+}
+
+rogue::benchmarks::PayloadPool::PayloadPool(
+    const google::protobuf::Message& message,
+    const int keyField,
+    const uint64_t batchSize,
+    const uint64_t slots) :
+    m_slots(slots == 0 ? 1 : slots)
+{
+    const google::protobuf::FieldDescriptor* field{ message.GetDescriptor()->FindFieldByNumber(keyField) };
+    // Zigzag encoded sint fields would need the key transformed first.
+    if(field == nullptr || field->is_repeated() || (
+        field->type() != google::protobuf::FieldDescriptor::TYPE_INT32 &&
+        field->type() != google::protobuf::FieldDescriptor::TYPE_INT64 &&
+        field->type() != google::protobuf::FieldDescriptor::TYPE_UINT32 &&
+        field->type() != google::protobuf::FieldDescriptor::TYPE_UINT64))
+    {
+        throw std::invalid_argument{ std::format("{} has no varint field {}.", message.GetTypeName(), keyField) };
+    }
+
+    // The key goes first with a placeholder, followed by every other field.
+    std::unique_ptr<google::protobuf::Message> rest{ message.New() };
+    rest->CopyFrom(message);
+    rest->GetReflection()->ClearField(rest.get(), field);
+    std::string value{};
+    const uint32_t keyTag{ static_cast<uint32_t>(keyField) << 3 };
+    {
+        google::protobuf::io::StringOutputStream output{ &value };
+        google::protobuf::io::CodedOutputStream coded{ &output };
+        coded.WriteVarint32(keyTag);
+    }
+    const uint64_t keyInValue{ value.size() };
+    value.append(KEY_BYTES, '\0');
+    writeKey(value.data() + keyInValue, 0);
+    value += rest->SerializeAsString();
+
+    // One message of the repeated field. value is the last field of the Any, which is the
+    // last field of the chunk, so the key sits at a fixed distance from the chunk's end.
+    rogue::services::Insert single{};
+    google::protobuf::Any& any{ *single.add_messages() };
+    any.PackFrom(message);
+    any.set_value(value);
+    const std::string chunk{ single.SerializeAsString() };
+    const uint64_t keyInChunk{ chunk.size() - value.size() + keyInValue };
+
+    rogue::services::Insert header{};
+    header.set_api_key(rogue::benchmarks::API_KEY);
+    std::string payload{ header.SerializeAsString() };
+    for(uint64_t index{ 0 }; index < batchSize; ++index)
+    {
+        m_keyOffsets.push_back(payload.size() + keyInChunk);
+        payload += chunk;
+    }
+
+    m_payloadSize = payload.size();
+    m_payloads.resize(m_payloadSize * (m_slots.size() + 1));
+    for(uint64_t region{ 0 }; region <= m_slots.size(); ++region)
+    {
+        std::copy(payload.begin(), payload.end(), m_payloads.begin() + region * m_payloadSize);
+    }
+}
+
+grpc::ByteBuffer rogue::benchmarks::PayloadPool::next(const uint64_t firstKey)
+{
+    for(uint64_t tried{ 0 }; tried < m_slots.size(); ++tried)
+    {
+        const uint64_t index{ m_next };
+        m_next = (m_next + 1) % m_slots.size();
+        Slot& slot{ m_slots[index] };
+        if(!slot.sending.load(std::memory_order_acquire))
+        {
+            slot.sending.store(true, std::memory_order_relaxed);
+            char* payload{ writeKeys(index, firstKey) };
+            const grpc::Slice slice{ payload, m_payloadSize, &PayloadPool::release, &slot };
+            return grpc::ByteBuffer{ &slice, 1 };
+        }
+    }
+
+    // gRPC may keep every sent message referenced until the call ends. The staging region
+    // past the slots is never handed to gRPC, so it is patched and copied instead.
+    ++m_copies;
+    const char* payload{ writeKeys(m_slots.size(), firstKey) };
+    const grpc::Slice slice{ payload, m_payloadSize };
+    return grpc::ByteBuffer{ &slice, 1 };
+}
+
+char* rogue::benchmarks::PayloadPool::writeKeys(const uint64_t region, const uint64_t firstKey)
+{
+    char* payload{ m_payloads.data() + region * m_payloadSize };
+    for(uint64_t index{ 0 }; index < m_keyOffsets.size(); ++index)
+    {
+        writeKey(payload + m_keyOffsets[index], firstKey + index);
+    }
+    return payload;
+}
+
+void rogue::benchmarks::PayloadPool::release(void* slot)
+{
+    static_cast<Slot*>(slot)->sending.store(false, std::memory_order_release);
+}
+
+rogue::benchmarks::RawInsertStream::RawInsertStream(const std::shared_ptr<grpc::Channel>& channel) :
+    m_stub{ channel }
+{
+    m_stream = m_stub.PrepareCall(&m_context, INSERT_METHOD, &m_queue);
+    m_stream->StartCall(tag(1));
+    if(!wait())
+    {
+        throw std::runtime_error{ "Could not start the insert stream." };
+    }
+}
+
+rogue::benchmarks::RawInsertStream::~RawInsertStream()
+{
+    if(!m_finished)
+    {
+        m_context.TryCancel();
+        finish();
+    }
+    m_queue.Shutdown();
+    void* ignored{ nullptr };
+    bool ok{ false };
+    while(m_queue.Next(&ignored, &ok))
+    {
+    }
+}
+
+bool rogue::benchmarks::RawInsertStream::write(const grpc::ByteBuffer& payload)
+{
+    m_stream->Write(payload, tag(2));
+    return wait();
+}
+
+grpc::Status rogue::benchmarks::RawInsertStream::finish()
+{
+    m_finished = true;
+    m_stream->WritesDone(tag(3));
+    wait();
+    grpc::Status status{};
+    m_stream->Finish(&status, tag(4));
+    wait();
+    return status;
+}
+
+bool rogue::benchmarks::RawInsertStream::wait()
+{
+    void* ignored{ nullptr };
+    bool ok{ false };
+    if(!m_queue.Next(&ignored, &ok))
+    {
+        return false;
+    }
+    return ok;
+}
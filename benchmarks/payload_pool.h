@@ -0,0 +1,89 @@
+#ifndef PAYLOAD_POOL_H
+#define PAYLOAD_POOL_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/generic_stub.h>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Serialized Inserts of batchSize copies of one message, built once into a single
+        // buffer instead of packing and serializing every write. Only the key of each message
+        // changes between writes. It is written as a ten byte varint, padded with continuation
+        // bits, so a new key is patched in place without moving any length prefix around it.
+        //
+        // gRPC sends the slots without copying them. A slot is only rewritten once gRPC
+        // released every reference to it. When none is free, the keys are patched into a
+        // staging copy that gRPC copies from, which still skips packing and serialization.
+        class PayloadPool
+        {
+        public:
+            static constexpr uint64_t KEY_BYTES{ 10 };
+
+            // keyField must be a varint field of message, eg. Dummy.id or Test.attribute1.
+            PayloadPool(
+                const google::protobuf::Message& message,
+                const int keyField,
+                const uint64_t batchSize,
+                const uint64_t slots);
+            PayloadPool(const PayloadPool&) = delete;
+            PayloadPool& operator=(const PayloadPool&) = delete;
+
+            // The next free slot with the keys firstKey, firstKey + 1, ... of its batch.
+            grpc::ByteBuffer next(const uint64_t firstKey);
+
+            uint64_t payloadSize() const { return m_payloadSize; }
+            // Writes that found every slot still held by gRPC and were copied.
+            uint64_t copies() const { return m_copies; }
+
+        private:
+            struct Slot
+            {
+                std::atomic<bool> sending{ false };
+            };
+
+            static void release(void* slot);
+            char* writeKeys(const uint64_t region, const uint64_t firstKey);
+
+            uint64_t m_payloadSize{ 0 };
+            std::vector<uint64_t> m_keyOffsets{};
+            std::vector<char> m_payloads{}; // One region per slot, then the staging region.
+            std::vector<Slot> m_slots;
+            uint64_t m_next{ 0 };
+            uint64_t m_copies{ 0 };
+        };
+
+        // An insert stream writing serialized Inserts through a generic stub, so gRPC never
+        // sees an Insert message. Blocks on its own completion queue for every operation like
+        // the sync API does.
+        class RawInsertStream
+        {
+        public:
+            explicit RawInsertStream(const std::shared_ptr<grpc::Channel>& channel);
+            ~RawInsertStream();
+            RawInsertStream(const RawInsertStream&) = delete;
+            RawInsertStream& operator=(const RawInsertStream&) = delete;
+
+            bool write(const grpc::ByteBuffer& payload);
+            // WritesDone followed by Finish.
+            grpc::Status finish();
+
+        private:
+            bool wait();
+
+            grpc::GenericStub m_stub;
+            grpc::ClientContext m_context{};
+            grpc::CompletionQueue m_queue{};
+            std::unique_ptr<grpc::GenericClientAsyncReaderWriter> m_stream{};
+            bool m_finished{ false };
+        };
+    }
+}
+
+#endif //PAYLOAD_POOL_H
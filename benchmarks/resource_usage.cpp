@@ -0,0 +1,210 @@
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "benchmarks/allocation_counter.h"
+#include "benchmarks/common.h"
+#include "benchmarks/resource_usage.h"
+
+namespace
+{
+    constexpr std::array<uint64_t, 4> EVENTS{
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES };
+
+    int openCounter(const pid_t thread, const uint64_t event)
+    {
+        perf_event_attr attributes{};
+        attributes.size = sizeof(attributes);
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.config = event;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attributes.disabled = 1;
+        attributes.inherit = 1;
+        // Kernel time is already in the system time of getrusage and needs fewer privileges excluded.
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, thread, -1, -1, 0));
+    }
+
+    // Scaled by enabled / running time in case the PMU was multiplexed between more events
+    // than it has counters for.
+    uint64_t readCounter(const int descriptor)
+    {
+        std::array<uint64_t, 3> values{};
+        if(descriptor < 0 || read(descriptor, values.data(), sizeof(values)) != sizeof(values) || values[2] == 0)
+        {
+            return 0;
+        }
+        return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+    }
+
+    double seconds(const timeval& time)
+    {
+        return time.tv_sec + time.tv_usec / 1e6;
+    }
+
+    std::string perOperation(const bool measured, const uint64_t count, const uint64_t operations)
+    {
+        return measured ? std::format("{:.1f}", static_cast<double>(count) / operations) : "-";
+    }
+}
+
+rogue::benchmarks::ResourceUsage& rogue::benchmarks::ResourceUsage::operator+=(const ResourceUsage& other)
+{
+    hardware = hardware || other.hardware;
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cacheMisses += other.cacheMisses;
+    branchMisses += other.branchMisses;
+    userSeconds += other.userSeconds;
+    systemSeconds += other.systemSeconds;
+    voluntarySwitches += other.voluntarySwitches;
+    involuntarySwitches += other.involuntarySwitches;
+    minorFaults += other.minorFaults;
+    majorFaults += other.majorFaults;
+    allocations += other.allocations;
+    return *this;
+}
+
+rogue::benchmarks::ResourceCounters::ResourceCounters(const bool hardware) :
+    m_hardware{ hardware }
+{}
+
+rogue::benchmarks::ResourceCounters::~ResourceCounters()
+{
+    close();
+}
+
+void rogue::benchmarks::ResourceCounters::start()
+{
+    close();
+    if(m_hardware)
+    {
+        for(const auto& task : std::filesystem::directory_iterator{ "/proc/self/task" })
+        {
+            const pid_t thread{ static_cast<pid_t>(std::stoi(task.path().filename().string())) };
+            for(const uint64_t event : EVENTS)
+            {
+                const int descriptor{ openCounter(thread, event) };
+                // A thread that exited since the listing has nothing left to count.
+                if(descriptor < 0 && errno != ESRCH)
+                {
+                    std::cerr << "perf_event_open failed: " << std::strerror(errno)
+                        << ". Reporting getrusage only." << std::endl;
+                    m_hardware = false;
+                    close();
+                    break;
+                }
+                m_descriptors.push_back(descriptor);
+            }
+            if(!m_hardware)
+            {
+                break;
+            }
+        }
+        for(const int descriptor : m_descriptors)
+        {
+            if(descriptor >= 0)
+            {
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, &m_start);
+    m_allocations = rogue::benchmarks::allocations();
+}
+
+rogue::benchmarks::ResourceUsage rogue::benchmarks::ResourceCounters::stop()
+{
+    rusage finish{};
+    getrusage(RUSAGE_SELF, &finish);
+    const uint64_t allocated{ rogue::benchmarks::allocations() - m_allocations };
+
+    ResourceUsage usage{};
+    usage.hardware = m_hardware;
+    for(uint64_t index{ 0 }; index < m_descriptors.size(); ++index)
+    {
+        const uint64_t count{ readCounter(m_descriptors[index]) };
+        switch(index % EVENTS.size())
+        {
+            case 0: usage.cycles += count; break;
+            case 1: usage.instructions += count; break;
+            case 2: usage.cacheMisses += count; break;
+            default: usage.branchMisses += count; break;
+        }
+    }
+    close();
+
+    usage.userSeconds = seconds(finish.ru_utime) - seconds(m_start.ru_utime);
+    usage.systemSeconds = seconds(finish.ru_stime) - seconds(m_start.ru_stime);
+    usage.voluntarySwitches = finish.ru_nvcsw - m_start.ru_nvcsw;
+    usage.involuntarySwitches = finish.ru_nivcsw - m_start.ru_nivcsw;
+    usage.minorFaults = finish.ru_minflt - m_start.ru_minflt;
+    usage.majorFaults = finish.ru_majflt - m_start.ru_majflt;
+    usage.allocations = allocated;
+    return usage;
+}
+
+void rogue::benchmarks::ResourceCounters::close()
+{
+    for(const int descriptor : m_descriptors)
+    {
+        if(descriptor >= 0)
+        {
+            ::close(descriptor);
+        }
+    }
+    m_descriptors.clear();
+}
+
+std::string rogue::benchmarks::resourcesFile(const std::string& filename)
+{
+    return std::filesystem::path{ filename }.replace_extension().string() + "_RESOURCES.md";
+}
+
+void rogue::benchmarks::logResources(
+    const std::string& filename,
+    const std::string& benchmark,
+    const uint64_t operations,
+    const ResourceUsage& usage)
+{
+    if(operations == 0)
+    {
+        return;
+    }
+
+    const std::string path{ resourcesFile(filename) };
+    const bool created{ !std::filesystem::exists(path) };
+    std::ofstream output{ path, std::ios::app };
+    if(created)
+    {
+        output << "| Benchmark | Cycles / op | Instructions / op | IPC | Cache Misses / op | Branch Misses / op "
+            "| User CPU / op | System CPU / op | Context Switches / op | Page Faults | Allocations / op |\n";
+        output << "| --- | ---: | ---: | ---: | ---: | ---: | ---: | ---: | ---: | ---: | ---: |\n";
+    }
+    output << std::format(
+        std::locale(std::locale{}, new CommaPunctuation{}),
+        "| {} | {} | {} | {} | {} | {} | {:.2Lf} us | {:.2Lf} us | {:.4Lf} | {:L} | {:.2Lf} |\n",
+        benchmark,
+        perOperation(usage.hardware, usage.cycles, operations),
+        perOperation(usage.hardware, usage.instructions, operations),
+        usage.hardware && usage.cycles > 0 ? std::format("{:.2f}", static_cast<double>(usage.instructions) / usage.cycles) : "-",
+        perOperation(usage.hardware, usage.cacheMisses, operations),
+        perOperation(usage.hardware, usage.branchMisses, operations),
+        usage.userSeconds * 1e6 / operations, usage.systemSeconds * 1e6 / operations,
+        static_cast<double>(usage.voluntarySwitches + usage.involuntarySwitches) / operations,
+        usage.minorFaults + usage.majorFaults,
+        static_cast<double>(usage.allocations) / operations);
+}
@@ -0,0 +1,75 @@
+#ifndef RESOURCE_USAGE_H
+#define RESOURCE_USAGE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // What the load generator itself spent on a benchmark. Divided by the operations it
+        // separates client overhead, eg. PackFrom serialization, from time spent in the server.
+        struct ResourceUsage
+        {
+            // User-space hardware counters summed over the threads of the process. Only set
+            // when hardwarecounters is on and perf_event_open is permitted.
+            bool hardware{ false };
+            uint64_t cycles{ 0 };
+            uint64_t instructions{ 0 };
+            uint64_t cacheMisses{ 0 }; // Last level cache on most CPUs.
+            uint64_t branchMisses{ 0 };
+
+            // getrusage of the whole process.
+            double userSeconds{ 0 };
+            double systemSeconds{ 0 };
+            uint64_t voluntarySwitches{ 0 };
+            uint64_t involuntarySwitches{ 0 };
+            uint64_t minorFaults{ 0 };
+            uint64_t majorFaults{ 0 };
+
+            // operator new calls of all threads, see allocations.
+            uint64_t allocations{ 0 };
+
+            ResourceUsage& operator+=(const ResourceUsage& other);
+        };
+
+        // Brackets the measured part of a benchmark. start opens one counter per event for
+        // every thread of the process. Threads those threads create afterwards inherit them.
+        // Falls back to getrusage alone if the counters cannot be opened, eg. in containers
+        // with perf_event_paranoid > 2.
+        class ResourceCounters
+        {
+        public:
+            explicit ResourceCounters(const bool hardware);
+            ~ResourceCounters();
+            ResourceCounters(const ResourceCounters&) = delete;
+            ResourceCounters& operator=(const ResourceCounters&) = delete;
+
+            void start();
+            ResourceUsage stop();
+
+        private:
+            void close();
+
+            bool m_hardware;
+            std::vector<int> m_descriptors{};
+            rusage m_start{};
+            uint64_t m_allocations{ 0 };
+        };
+
+        // eg. BENCHMARKS.md -> BENCHMARKS_RESOURCES.md
+        std::string resourcesFile(const std::string& filename);
+        // Appends the usage normalized per operation to the resources table.
+        void logResources(
+            const std::string& filename,
+            const std::string& benchmark,
+            const uint64_t operations,
+            const ResourceUsage& usage);
+    }
+}
+
+#endif //RESOURCE_USAGE_H
@@ -0,0 +1,311 @@
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#include <sys/utsname.h>
+#include <unistd.h>
+
+#include "benchmarks/results.h"
+
+namespace
+{
+    constexpr char CSV_HEADER[]{
+        "benchmark,seconds,read_ops,write_ops,ops_per_second,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,samples" };
+
+    // Set once by describeRun before any benchmark runs.
+    struct RunMetadata
+    {
+        std::string timestamp{ "unknown" };
+        std::string gitSha{ "unknown" };
+        std::string hostname{ "unknown" };
+        std::string kernel{ "unknown" };
+        std::string cpuModel{ "unknown" };
+        uint64_t cpus{ std::thread::hardware_concurrency() };
+        std::vector<std::pair<std::string, std::string>> settings{};
+    };
+
+    RunMetadata& metadata()
+    {
+        static RunMetadata run{};
+        return run;
+    }
+
+    std::string trim(const std::string& value)
+    {
+        const auto begin{ value.find_first_not_of(" \t\r\n") };
+        const auto end{ value.find_last_not_of(" \t\r\n") };
+        return begin == std::string::npos ? "" : value.substr(begin, end - begin + 1);
+    }
+
+    std::string gitSha()
+    {
+        if(const char* sha{ std::getenv("ROGUE_GIT_SHA") }; sha != nullptr && *sha != '\0')
+        {
+            return sha;
+        }
+
+        std::string sha{};
+        if(FILE* pipe{ popen("git rev-parse HEAD 2>/dev/null", "r") }; pipe != nullptr)
+        {
+            char buffer[64]{};
+            while(std::fgets(buffer, sizeof(buffer), pipe) != nullptr)
+            {
+                sha += buffer;
+            }
+            pclose(pipe);
+        }
+        sha = trim(sha);
+        return sha.empty() ? "unknown" : sha;
+    }
+
+    std::string cpuModel()
+    {
+        std::ifstream cpuinfo{ "/proc/cpuinfo" };
+        for(std::string line{}; std::getline(cpuinfo, line);)
+        {
+            if(line.starts_with("model name"))
+            {
+                const auto colon{ line.find(':') };
+                return colon == std::string::npos ? "unknown" : trim(line.substr(colon + 1));
+            }
+        }
+        return "unknown";
+    }
+
+    std::string json(const std::string& value)
+    {
+        std::string escaped{ "\"" };
+        for(const char c : value)
+        {
+            switch(c)
+            {
+                case '"': escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                case '\t': escaped += "\\t"; break;
+                default:
+                    if(static_cast<unsigned char>(c) < 0x20)
+                    {
+                        escaped += std::format("\\u{:04x}", static_cast<uint32_t>(c));
+                    }
+                    else
+                    {
+                        escaped += c;
+                    }
+            }
+        }
+        return escaped + "\"";
+    }
+
+    // Benchmark names contain commas, eg. "Read Only, Batch Size 10", so every name is quoted.
+    std::string csv(const std::string& value)
+    {
+        std::string quoted{ "\"" };
+        for(const char c : value)
+        {
+            quoted += c == '"' ? std::string{ "\"\"" } : std::string{ c };
+        }
+        return quoted + "\"";
+    }
+
+    std::vector<std::string> splitCsv(const std::string& line)
+    {
+        std::vector<std::string> fields{ "" };
+        bool quoted{ false };
+        for(uint64_t index{ 0 }; index < line.size(); ++index)
+        {
+            const char c{ line[index] };
+            if(quoted && c == '"' && index + 1 < line.size() && line[index + 1] == '"')
+            {
+                fields.back() += '"';
+                ++index;
+            }
+            else if(c == '"')
+            {
+                quoted = !quoted;
+            }
+            else if(c == ',' && !quoted)
+            {
+                fields.emplace_back();
+            }
+            else if(c != '\r')
+            {
+                fields.back() += c;
+            }
+        }
+        return fields;
+    }
+}
+
+void rogue::benchmarks::describeRun(const WorkloadSpec& spec)
+{
+    RunMetadata& run{ metadata() };
+
+    const std::time_t now{ std::time(nullptr) };
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    char timestamp[32]{};
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    run.timestamp = timestamp;
+
+    run.gitSha = gitSha();
+    char hostname[256]{};
+    if(gethostname(hostname, sizeof(hostname) - 1) == 0)
+    {
+        run.hostname = hostname;
+    }
+    if(utsname system{}; uname(&system) == 0)
+    {
+        run.kernel = std::format("{} {} {}", system.sysname, system.release, system.machine);
+    }
+    run.cpuModel = cpuModel();
+    run.settings = workloadSettings(spec);
+}
+
+std::string rogue::benchmarks::resultsCsv(const std::string& filename)
+{
+    return std::filesystem::path{ filename }.replace_extension(".csv").string();
+}
+
+std::string rogue::benchmarks::resultsJson(const std::string& filename)
+{
+    return std::filesystem::path{ filename }.replace_extension(".jsonl").string();
+}
+
+void rogue::benchmarks::initialResults(const std::string& filename)
+{
+    std::ofstream csv{ resultsCsv(filename), std::ios::trunc };
+    csv << CSV_HEADER << '\n';
+    std::ofstream json{ resultsJson(filename), std::ios::trunc };
+}
+
+void rogue::benchmarks::recordResult(
+    const std::string& filename,
+    const BenchmarkResult& result,
+    const LatencyHistogram& latencies,
+    const ResourceUsage* usage)
+{
+    std::string samples{};
+    std::string sampleArray{};
+    for(const double sample : result.samples)
+    {
+        samples += std::format("{}{:.2f}", samples.empty() ? "" : ";", sample);
+        sampleArray += std::format("{}{:.2f}", sampleArray.empty() ? "" : ",", sample);
+    }
+
+    std::ofstream csvOutput{ resultsCsv(filename), std::ios::app };
+    csvOutput << std::format("{},{:.6f},{},{},{:.2f},{},{},{},{},{},{}\n",
+        csv(result.benchmark), result.seconds, result.readOperations, result.writeOperations,
+        result.operationsPerSecond, result.p50, result.p90, result.p99, result.p999, result.max, samples);
+    csvOutput.close();
+
+    // One object per line so runs can be appended and loaded without a custom parser.
+    const RunMetadata& run{ metadata() };
+    std::string config{};
+    for(const auto& [key, value] : run.settings)
+    {
+        config += std::format("{}{}:{}", config.empty() ? "" : ",", json(key), json(value));
+    }
+    std::string histogram{};
+    for(uint64_t index{ 0 }; index < LatencyHistogram::BUCKET_COUNT; ++index)
+    {
+        if(latencies.countAt(index) > 0)
+        {
+            histogram += std::format("{}[{},{}]", histogram.empty() ? "" : ",",
+                LatencyHistogram::bucketValue(index), latencies.countAt(index));
+        }
+    }
+
+    std::string resources{ "null" };
+    if(usage != nullptr)
+    {
+        resources = std::format(
+            "{{\"user_seconds\":{:.6f},\"system_seconds\":{:.6f},\"voluntary_switches\":{},"
+            "\"involuntary_switches\":{},\"minor_faults\":{},\"major_faults\":{},\"allocations\":{}",
+            usage->userSeconds, usage->systemSeconds, usage->voluntarySwitches,
+            usage->involuntarySwitches, usage->minorFaults, usage->majorFaults, usage->allocations);
+        if(usage->hardware)
+        {
+            resources += std::format(",\"cycles\":{},\"instructions\":{},\"cache_misses\":{},\"branch_misses\":{}",
+                usage->cycles, usage->instructions, usage->cacheMisses, usage->branchMisses);
+        }
+        resources += "}";
+    }
+
+    std::ofstream jsonOutput{ resultsJson(filename), std::ios::app };
+    jsonOutput << std::format(
+        "{{\"benchmark\":{},\"timestamp\":{},\"git_sha\":{},"
+        "\"host\":{{\"name\":{},\"kernel\":{},\"cpu_model\":{},\"cpus\":{}}},"
+        "\"config\":{{{}}},"
+        "\"seconds\":{:.6f},\"read_operations\":{},\"write_operations\":{},\"operations_per_second\":{:.2f},"
+        "\"latency_ns\":{{\"min\":{},\"mean\":{:.1f},\"p50\":{},\"p90\":{},\"p99\":{},\"p99_9\":{},\"max\":{}}},"
+        "\"resources\":{},\"samples\":[{}],\"histogram\":[{}]}}\n",
+        json(result.benchmark), json(run.timestamp), json(run.gitSha),
+        json(run.hostname), json(run.kernel), json(run.cpuModel), run.cpus,
+        config,
+        result.seconds, result.readOperations, result.writeOperations, result.operationsPerSecond,
+        latencies.min(), latencies.mean(), result.p50, result.p90, result.p99, result.p999, result.max,
+        resources, sampleArray, histogram);
+}
+
+std::vector<rogue::benchmarks::BenchmarkResult> rogue::benchmarks::readResults(const std::string& path)
+{
+    std::ifstream input{ path };
+    if(!input)
+    {
+        throw std::runtime_error{ std::format("Could not open {}.", path) };
+    }
+
+    std::vector<BenchmarkResult> results{};
+    std::set<std::string> names{};
+    std::string line{};
+    std::getline(input, line);
+    if(trim(line) != CSV_HEADER)
+    {
+        throw std::runtime_error{ std::format("{} is not a benchmark results file.", path) };
+    }
+
+    for(uint64_t number{ 2 }; std::getline(input, line); ++number)
+    {
+        if(trim(line).empty())
+        {
+            continue;
+        }
+        const std::vector<std::string> fields{ splitCsv(line) };
+        if(fields.size() != 11)
+        {
+            throw std::runtime_error{ std::format("{}:{} has {} fields, expected 11.", path, number, fields.size()) };
+        }
+
+        try
+        {
+            BenchmarkResult result{
+                fields[0], std::stod(fields[1]), std::stoull(fields[2]), std::stoull(fields[3]),
+                std::stod(fields[4]), std::stoull(fields[5]), std::stoull(fields[6]), std::stoull(fields[7]),
+                std::stoull(fields[8]), std::stoull(fields[9]) };
+            for(uint64_t begin{ 0 }; begin < fields[10].size();)
+            {
+                const uint64_t end{ std::min(fields[10].find(';', begin), fields[10].size()) };
+                result.samples.push_back(std::stod(fields[10].substr(begin, end - begin)));
+                begin = end + 1;
+            }
+            results.push_back(std::move(result));
+        }
+        catch(const std::logic_error&)
+        {
+            throw std::runtime_error{ std::format("{}:{} could not be parsed.", path, number) };
+        }
+        if(!names.insert(results.back().benchmark).second)
+        {
+            throw std::runtime_error{ std::format("{}:{} repeats benchmark {}. Name each configuration apart.", path, number, results.back().benchmark) };
+        }
+    }
+    return results;
+}
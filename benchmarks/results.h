@@ -0,0 +1,56 @@
+#ifndef BENCHMARK_RESULTS_H
+#define BENCHMARK_RESULTS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "benchmarks/latency_histogram.h"
+#include "benchmarks/resource_usage.h"
+#include "benchmarks/workload_spec.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Machine-readable counterpart of a markdown table row, eg. BENCHMARKS.md gets
+        // BENCHMARKS.csv for the comparator and BENCHMARKS.jsonl with the full metadata and
+        // histogram of every benchmark.
+        struct BenchmarkResult
+        {
+            std::string benchmark{};
+            double seconds{ 0 };
+            uint64_t readOperations{ 0 };
+            uint64_t writeOperations{ 0 };
+            double operationsPerSecond{ 0 };
+            // Nanoseconds.
+            uint64_t p50{ 0 };
+            uint64_t p90{ 0 };
+            uint64_t p99{ 0 };
+            uint64_t p999{ 0 };
+            uint64_t max{ 0 };
+            // Throughput of each repetition, a single one when the benchmark ran once. Used for
+            // the significance test of the comparator.
+            std::vector<double> samples{};
+        };
+
+        // Sets the metadata written with every result of this run: git sha, host and the spec.
+        // The sha is taken from ROGUE_GIT_SHA, falling back to git rev-parse HEAD.
+        void describeRun(const WorkloadSpec& spec);
+
+        std::string resultsCsv(const std::string& filename);
+        std::string resultsJson(const std::string& filename);
+        // Truncates the results files of the table and writes the CSV header.
+        void initialResults(const std::string& filename);
+        void recordResult(
+            const std::string& filename,
+            const BenchmarkResult& result,
+            const LatencyHistogram& latencies,
+            const ResourceUsage* usage = nullptr);
+        // Reads a results CSV, throwing std::runtime_error when it cannot be parsed or names
+        // a benchmark twice, since its rows could not be told apart.
+        std::vector<BenchmarkResult> readResults(const std::string& path);
+    }
+}
+
+#endif //BENCHMARK_RESULTS_H
@@ -0,0 +1,147 @@
+#include <algorithm>
+
+#include "benchmarks/executor.h"
+#include "benchmarks/scheduler.h"
+
+namespace
+{
+    // Worker of the scheduler running on this thread, so tasks reschedule onto their own queue.
+    thread_local rogue::benchmarks::Scheduler* currentScheduler{ nullptr };
+    thread_local uint64_t currentWorker{ 0 };
+}
+
+void rogue::benchmarks::Task::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept
+{
+    handle.promise().m_scheduler->complete(handle);
+}
+
+void rogue::benchmarks::Task::promise_type::unhandled_exception()
+{
+    m_scheduler->fail(std::current_exception());
+}
+
+rogue::benchmarks::Scheduler::Scheduler(const uint64_t workers)
+{
+    for(uint64_t index{ 0 }; index < std::max(uint64_t{1}, workers); ++index)
+    {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+}
+
+void rogue::benchmarks::Scheduler::spawn(Task task)
+{
+    task.m_handle.promise().m_scheduler = this;
+    ++m_outstanding;
+    schedule(task.m_handle);
+}
+
+void rogue::benchmarks::Scheduler::schedule(std::coroutine_handle<> handle)
+{
+    const uint64_t worker{ currentScheduler == this
+        ? currentWorker
+        : m_next.fetch_add(1, std::memory_order_relaxed) % m_queues.size() };
+    {
+        std::lock_guard<std::mutex> lock{ m_queues[worker]->lock };
+        m_queues[worker]->handles.push_back(handle);
+    }
+
+    ++m_queued;
+    if(m_sleeping.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock{ m_sleepLock };
+        m_wake.notify_one();
+    }
+}
+
+void rogue::benchmarks::Scheduler::run()
+{
+    for(uint64_t worker{ 0 }; worker < m_queues.size(); ++worker)
+    {
+        executor().detach_task([this, worker](){ work(worker); });
+    }
+    executor().wait();
+
+    if(m_exception)
+    {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+uint64_t rogue::benchmarks::Scheduler::worker() const
+{
+    return currentScheduler == this ? currentWorker : 0;
+}
+
+void rogue::benchmarks::Scheduler::work(const uint64_t worker)
+{
+    currentScheduler = this;
+    currentWorker = worker;
+    while(true)
+    {
+        const std::coroutine_handle<> handle{ take(worker) };
+        if(handle)
+        {
+            handle.resume();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{ m_sleepLock };
+        ++m_sleeping;
+        m_wake.wait(lock, [this](){ return m_queued.load() > 0 || m_outstanding.load() == 0; });
+        --m_sleeping;
+        if(m_outstanding.load() == 0)
+        {
+            break;
+        }
+    }
+    currentScheduler = nullptr;
+}
+
+std::coroutine_handle<> rogue::benchmarks::Scheduler::take(const uint64_t worker)
+{
+    {
+        Queue& queue{ *m_queues[worker] };
+        std::lock_guard<std::mutex> lock{ queue.lock };
+        if(!queue.handles.empty())
+        {
+            const std::coroutine_handle<> handle{ queue.handles.back() };
+            queue.handles.pop_back();
+            --m_queued;
+            return handle;
+        }
+    }
+
+    for(uint64_t offset{ 1 }; offset < m_queues.size(); ++offset)
+    {
+        Queue& victim{ *m_queues[(worker + offset) % m_queues.size()] };
+        std::lock_guard<std::mutex> lock{ victim.lock };
+        if(!victim.handles.empty())
+        {
+            const std::coroutine_handle<> handle{ victim.handles.front() };
+            victim.handles.pop_front();
+            --m_queued;
+            return handle;
+        }
+    }
+    return {};
+}
+
+void rogue::benchmarks::Scheduler::complete(std::coroutine_handle<Task::promise_type> handle)
+{
+    handle.destroy();
+    if(m_outstanding.fetch_sub(1) == 1)
+    {
+        std::lock_guard<std::mutex> lock{ m_sleepLock };
+        m_wake.notify_all();
+    }
+}
+
+void rogue::benchmarks::Scheduler::fail(std::exception_ptr exception)
+{
+    std::lock_guard<std::mutex> lock{ m_exceptionLock };
+    if(!m_exception)
+    {
+        m_exception = exception;
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        class Scheduler;
+
+        // Fire-and-forget coroutine owned by a Scheduler. Starts suspended and is destroyed by the
+        // scheduler once it runs to completion.
+        struct Task
+        {
+            struct promise_type
+            {
+                Scheduler* m_scheduler{ nullptr };
+
+                struct FinalAwaiter
+                {
+                    bool await_ready() const noexcept { return false; }
+                    void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+                    void await_resume() const noexcept {}
+                };
+
+                Task get_return_object()
+                {
+                    return Task{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() noexcept { return {}; }
+                FinalAwaiter final_suspend() noexcept { return {}; }
+                void return_void() {}
+                void unhandled_exception();
+            };
+
+            std::coroutine_handle<promise_type> m_handle;
+        };
+
+        // M:N runtime for Tasks. Each worker keeps its own queue: handles scheduled from a worker
+        // go to the back of its queue and are taken from the back again, idle workers steal from
+        // the front of the others'. Suspended tasks cost their coroutine frame, not a thread.
+        class Scheduler
+        {
+        public:
+            explicit Scheduler(const uint64_t workers);
+
+            // Takes ownership of the task. May be called before run or from within a task.
+            void spawn(Task task);
+            // Queues a suspended coroutine to be resumed, eg. from a gRPC callback.
+            void schedule(std::coroutine_handle<> handle);
+            // Runs the workers on the executor until every spawned task completed. Rethrows the
+            // first exception a task let escape.
+            void run();
+            // Worker running the calling task, in [0, workers()). Tasks may move between workers
+            // at each co_await, so state per worker, eg. a histogram, is only safe between them.
+            uint64_t worker() const;
+            uint64_t workers() const { return m_queues.size(); }
+
+        private:
+            friend struct Task::promise_type;
+
+            struct Queue
+            {
+                std::mutex lock{};
+                std::deque<std::coroutine_handle<>> handles{};
+            };
+
+            void work(const uint64_t worker);
+            std::coroutine_handle<> take(const uint64_t worker);
+            void complete(std::coroutine_handle<Task::promise_type> handle);
+            void fail(std::exception_ptr exception);
+
+            std::vector<std::unique_ptr<Queue>> m_queues;
+            std::atomic<uint64_t> m_outstanding{ 0 };
+            std::atomic<uint64_t> m_queued{ 0 };
+            std::atomic<uint64_t> m_sleeping{ 0 };
+            std::atomic<uint64_t> m_next{ 0 };
+            std::mutex m_sleepLock{};
+            std::condition_variable m_wake{};
+            std::mutex m_exceptionLock{};
+            std::exception_ptr m_exception{};
+        };
+    }
+}
+
+#endif //SCHEDULER_H
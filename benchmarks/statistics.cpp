@@ -0,0 +1,119 @@
+#include <array>
+#include <cmath>
+
+#include "benchmarks/statistics.h"
+
+namespace
+{
+    // Two-sided 95% critical values of Student's t for 1 to 30 degrees of freedom.
+    constexpr std::array<double, 30> T_CRITICAL{
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042 };
+    constexpr double Z_CRITICAL{ 1.960 };
+
+    double variance(const std::vector<double>& values, const double mean)
+    {
+        double squares{ 0 };
+        for(const double value : values)
+        {
+            squares += (value - mean) * (value - mean);
+        }
+        return squares / (values.size() - 1);
+    }
+
+    // Continued fraction of the regularized incomplete beta function (modified Lentz).
+    double betaFraction(const double a, const double b, const double x)
+    {
+        constexpr double TINY{ 1e-300 };
+        double c{ 1 };
+        double d{ 1 - (a + b) * x / (a + 1) };
+        d = 1 / (std::abs(d) < TINY ? TINY : d);
+        double fraction{ d };
+        for(uint32_t m{ 1 }; m <= 300; ++m)
+        {
+            const double even{ m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)) };
+            d = 1 + even * d;
+            d = 1 / (std::abs(d) < TINY ? TINY : d);
+            c = 1 + even / c;
+            c = std::abs(c) < TINY ? TINY : c;
+            fraction *= d * c;
+
+            const double odd{ -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1)) };
+            d = 1 + odd * d;
+            d = 1 / (std::abs(d) < TINY ? TINY : d);
+            c = 1 + odd / c;
+            c = std::abs(c) < TINY ? TINY : c;
+            const double delta{ d * c };
+            fraction *= delta;
+            if(std::abs(delta - 1) < 1e-12)
+            {
+                break;
+            }
+        }
+        return fraction;
+    }
+
+    double incompleteBeta(const double a, const double b, const double x)
+    {
+        if(x <= 0 || x >= 1)
+        {
+            return x <= 0 ? 0 : 1;
+        }
+        const double front{ std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b)
+            + a * std::log(x) + b * std::log(1 - x)) };
+        return x < (a + 1) / (a + b + 2)
+            ? front * betaFraction(a, b, x) / a
+            : 1 - front * betaFraction(b, a, 1 - x) / b;
+    }
+
+    double mean(const std::vector<double>& values)
+    {
+        double sum{ 0 };
+        for(const double value : values)
+        {
+            sum += value;
+        }
+        return values.empty() ? 0 : sum / values.size();
+    }
+}
+
+rogue::benchmarks::RepetitionSummary rogue::benchmarks::summarize(const std::vector<double>& values)
+{
+    RepetitionSummary summary{ values.size(), mean(values), 0, 0 };
+    if(values.size() < 2)
+    {
+        return summary;
+    }
+
+    summary.standardDeviation = std::sqrt(variance(values, summary.mean));
+    const uint64_t freedom{ values.size() - 1 };
+    const double critical{ freedom <= T_CRITICAL.size() ? T_CRITICAL[freedom - 1] : Z_CRITICAL };
+    summary.halfWidth = critical * summary.standardDeviation / std::sqrt(static_cast<double>(values.size()));
+    return summary;
+}
+
+rogue::benchmarks::WelchTest rogue::benchmarks::welchTest(
+    const std::vector<double>& first,
+    const std::vector<double>& second)
+{
+    if(first.size() < 2 || second.size() < 2)
+    {
+        return WelchTest{ 0, 0, 1 };
+    }
+
+    const double firstMean{ mean(first) };
+    const double secondMean{ mean(second) };
+    const double firstError{ variance(first, firstMean) / first.size() };
+    const double secondError{ variance(second, secondMean) / second.size() };
+    const double error{ firstError + secondError };
+    if(error == 0)
+    {
+        return WelchTest{ 0, 0, firstMean == secondMean ? 1.0 : 0.0 };
+    }
+
+    const double t{ (firstMean - secondMean) / std::sqrt(error) };
+    const double freedom{ error * error / (firstError * firstError / (first.size() - 1)
+        + secondError * secondError / (second.size() - 1)) };
+    return WelchTest{ t, freedom, incompleteBeta(freedom / 2, .5, freedom / (freedom + t * t)) };
+}
@@ -0,0 +1,33 @@
+#ifndef BENCHMARK_STATISTICS_H
+#define BENCHMARK_STATISTICS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        struct RepetitionSummary
+        {
+            uint64_t runs;
+            double mean;
+            double standardDeviation;
+            double halfWidth; // Of the 95% confidence interval of the mean, Student's t.
+        };
+
+        RepetitionSummary summarize(const std::vector<double>& values);
+
+        struct WelchTest
+        {
+            double t;
+            double degreesOfFreedom;
+            double pValue; // Two-sided. 1 when there are fewer than two samples on either side.
+        };
+
+        // Welch's unequal variances t-test of the difference between the means of two samples.
+        WelchTest welchTest(const std::vector<double>& first, const std::vector<double>& second);
+    }
+}
+
+#endif //BENCHMARK_STATISTICS_H
@@ -0,0 +1,309 @@
+#ifndef STREAM_ENGINE_H
+#define STREAM_ENGINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/async_stream.h>
+
+#include "benchmarks/executor.h"
+#include "benchmarks/latency_histogram.h"
+#include "benchmarks/time_series.h"
+#include "benchmarks/workload_spec.h"
+#include "protos/queries.pb.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Drives many bidi streams from a few polling threads with the completion-queue API.
+        // Every stream belongs to one completion queue and every completion queue to one poller,
+        // so a stream's state and its poller's histogram are only ever touched by one thread.
+        //
+        // Acknowledged streams (eg. search) keep up to window requests in flight and measure
+        // latency until Response.finished covers each request. Unacknowledged streams (eg. insert)
+        // measure until the stream accepts the write.
+        template<typename Request>
+        class StreamEngine
+        {
+        public:
+            using Stream = grpc::ClientAsyncReaderWriterInterface<Request, rogue::services::Response>;
+            // Starts the stream with the given index on the completion queue, eg. through a
+            // stub's PrepareAsync method. Picking the stub by index spreads streams over channels.
+            using Prepare = std::function<std::unique_ptr<Stream>(grpc::ClientContext*, grpc::CompletionQueue*, const uint64_t)>;
+            // Fills the request of the stream with the given index before each write.
+            using Next = std::function<void(Request&, const uint64_t)>;
+
+            struct Options
+            {
+                uint64_t streams{ 1000 };
+                uint64_t pollers{ 4 };
+                uint64_t operationsPerStream{ 1000 };
+                uint64_t batchSize{ 1 };
+                uint64_t window{ 1 };
+                bool acknowledged{ true };
+            };
+
+            StreamEngine(
+                const WorkloadSpec& spec,
+                const Options& options,
+                Prepare prepare,
+                Next next) :
+                m_options{ options },
+                m_prepare{ std::move(prepare) },
+                m_next{ std::move(next) },
+                // Pollers never return while their streams are open, so every one needs its own thread.
+                m_queues(std::clamp(options.pollers, uint64_t{1}, static_cast<uint64_t>(executor().get_thread_count()))),
+                m_histograms(m_queues.size())
+            {
+                for(uint64_t index{ 0 }; index < m_options.streams; ++index)
+                {
+                    const uint64_t poller{ index % m_queues.size() };
+                    m_streams.push_back(std::make_unique<StreamState>(
+                        spec, m_options, index, poller, m_histograms[poller]));
+                }
+            }
+
+            // Starts every stream and blocks until all of them finished.
+            void run()
+            {
+                for(uint64_t poller{ 0 }; poller < m_queues.size(); ++poller)
+                {
+                    m_queues[poller] = std::make_unique<grpc::CompletionQueue>();
+                }
+                for(auto& state : m_streams)
+                {
+                    state->limit.start();
+                    state->stream = m_prepare(&state->context, m_queues[state->poller].get(), state->index);
+                    state->stream->StartCall(&state->tags[START]);
+                }
+
+                for(uint64_t poller{ 0 }; poller < m_queues.size(); ++poller)
+                {
+                    executor().detach_task([this, poller](){ poll(poller); });
+                }
+                executor().wait();
+            }
+
+            LatencyHistogram histogram() const
+            {
+                LatencyHistogram merged{};
+                for(const auto& histogram : m_histograms)
+                {
+                    merged.merge(histogram);
+                }
+                return merged;
+            }
+
+            uint64_t errors() const { return m_errors.load(); }
+
+            // Before run. Writes count as in flight until recorded, broken streams as errors.
+            void attach(TimeSeries& series)
+            {
+                for(LatencyHistogram& histogram : m_histograms)
+                {
+                    m_live.push_back(&series.attach(histogram));
+                }
+            }
+
+        private:
+            enum Event : uint32_t
+            {
+                START,
+                WRITE,
+                READ,
+                WRITES_DONE,
+                FINISH,
+                EVENT_COUNT
+            };
+
+            struct StreamState;
+            struct Tag
+            {
+                StreamState* state;
+                Event event;
+            };
+
+            struct StreamState
+            {
+                StreamState(
+                    const WorkloadSpec& spec,
+                    const Options& options,
+                    const uint64_t streamIndex,
+                    const uint64_t pollerIndex,
+                    LatencyHistogram& histogram) :
+                    index{ streamIndex },
+                    poller{ pollerIndex },
+                    timestamps{ options.window + 1 },
+                    tracker{ timestamps, histogram, options.batchSize },
+                    limit{ spec, options.operationsPerStream }
+                {
+                    for(uint32_t event{ 0 }; event < EVENT_COUNT; ++event)
+                    {
+                        tags[event] = Tag{ this, static_cast<Event>(event) };
+                    }
+                }
+
+                const uint64_t index;
+                const uint64_t poller;
+                grpc::ClientContext context{};
+                std::unique_ptr<Stream> stream{};
+                Request request{};
+                rogue::services::Response response{};
+                grpc::Status status{};
+                StreamTimestamps timestamps;
+                FinishedTracker tracker;
+                OperationLimit limit;
+                Tag tags[EVENT_COUNT];
+                std::chrono::steady_clock::time_point written{};
+                uint64_t sent{ 0 };
+                uint64_t operations{ 0 };
+                bool writing{ false };
+                bool reading{ false };
+                bool closing{ false };
+                bool finishing{ false };
+            };
+
+            void poll(const uint64_t poller)
+            {
+                grpc::CompletionQueue& queue{ *m_queues[poller] };
+                uint64_t remaining{ 0 };
+                for(const auto& state : m_streams)
+                {
+                    remaining += state->poller == poller;
+                }
+
+                void* tag{ nullptr };
+                bool ok{ false };
+                while(remaining > 0 && queue.Next(&tag, &ok))
+                {
+                    Tag& event{ *static_cast<Tag*>(tag) };
+                    if(handle(*event.state, event.event, ok))
+                    {
+                        --remaining;
+                    }
+                }
+                queue.Shutdown();
+                while(queue.Next(&tag, &ok))
+                {
+                }
+            }
+
+            // Returns true once the stream finished.
+            bool handle(StreamState& state, const Event event, const bool ok)
+            {
+                switch(event)
+                {
+                    case START:
+                        if(ok)
+                        {
+                            state.reading = true;
+                            state.stream->Read(&state.response, &state.tags[READ]);
+                            write(state);
+                        }
+                        break;
+                    case WRITE:
+                        state.writing = false;
+                        if(ok)
+                        {
+                            if(!m_options.acknowledged)
+                            {
+                                m_histograms[state.poller].record(
+                                    state.written, std::chrono::steady_clock::now(), m_options.batchSize);
+                            }
+                            write(state);
+                        }
+                        break;
+                    case READ:
+                        state.reading = ok;
+                        if(ok)
+                        {
+                            if(m_options.acknowledged)
+                            {
+                                state.tracker.finished(state.response.finished_size());
+                            }
+                            state.stream->Read(&state.response, &state.tags[READ]);
+                            write(state);
+                        }
+                        break;
+                    case WRITES_DONE:
+                        state.writing = false;
+                        break;
+                    case FINISH:
+                        if(!state.status.ok())
+                        {
+                            ++m_errors;
+                            if(!m_live.empty())
+                            {
+                                m_live[state.poller]->failed();
+                            }
+                            std::cout << "Stream broken. Code: " << state.status.error_code() << ", Details: " << state.status.error_details() << ", Message: " << state.status.error_message() << std::endl;
+                        }
+                        return true;
+                    default:
+                        break;
+                }
+
+                if(!ok && event != FINISH)
+                {
+                    state.closing = true;
+                }
+                if(!state.reading && !state.writing && !state.finishing && (state.closing || event == START))
+                {
+                    state.finishing = true;
+                    state.stream->Finish(&state.status, &state.tags[FINISH]);
+                }
+                return false;
+            }
+
+            void write(StreamState& state)
+            {
+                if(state.writing || state.closing)
+                {
+                    return;
+                }
+
+                const uint64_t inFlight{ state.sent - state.tracker.completed() };
+                if(state.limit.running(state.operations))
+                {
+                    if(m_options.acknowledged && inFlight >= m_options.window)
+                    {
+                        return;
+                    }
+                    m_next(state.request, state.index);
+                    state.written = std::chrono::steady_clock::now();
+                    state.timestamps.sent(state.sent, state.written);
+                    state.writing = true;
+                    ++state.sent;
+                    state.operations += m_options.batchSize;
+                    m_histograms[state.poller].issued(m_options.batchSize);
+                    state.stream->Write(state.request, &state.tags[WRITE]);
+                }
+                else if(!m_options.acknowledged || inFlight == 0)
+                {
+                    state.writing = true;
+                    state.closing = true;
+                    state.stream->WritesDone(&state.tags[WRITES_DONE]);
+                }
+            }
+
+            const Options m_options;
+            Prepare m_prepare;
+            Next m_next;
+            std::vector<std::unique_ptr<grpc::CompletionQueue>> m_queues;
+            std::vector<LatencyHistogram> m_histograms;
+            std::vector<IntervalCounters*> m_live{};
+            std::vector<std::unique_ptr<StreamState>> m_streams{};
+            std::atomic<uint64_t> m_errors{ 0 };
+        };
+    }
+}
+
+#endif //STREAM_ENGINE_H
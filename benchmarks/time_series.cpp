@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <fstream>
+
+#include "benchmarks/time_series.h"
+
+namespace
+{
+    uint64_t percentile(const std::vector<uint64_t>& counts, const uint64_t total, const double percent)
+    {
+        if(total == 0)
+        {
+            return 0;
+        }
+        const uint64_t target{ std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(percent / 100.0 * total))) };
+        uint64_t seen{ 0 };
+        for(uint64_t index{ 0 }; index < counts.size(); ++index)
+        {
+            seen += counts[index];
+            if(seen >= target)
+            {
+                return rogue::benchmarks::IntervalCounters::bucketValue(index);
+            }
+        }
+        return rogue::benchmarks::IntervalCounters::bucketValue(counts.size() - 1);
+    }
+}
+
+rogue::benchmarks::TimeSeries::TimeSeries(const std::chrono::milliseconds interval) :
+    m_interval{ std::max(std::chrono::milliseconds{1}, interval) },
+    m_previous(IntervalCounters::BUCKET_COUNT, 0),
+    m_current(IntervalCounters::BUCKET_COUNT, 0)
+{}
+
+rogue::benchmarks::TimeSeries::~TimeSeries()
+{
+    stop();
+}
+
+rogue::benchmarks::IntervalCounters& rogue::benchmarks::TimeSeries::attach(LatencyHistogram& histogram)
+{
+    m_counters.push_back(std::make_unique<IntervalCounters>());
+    m_histograms.push_back(&histogram);
+    histogram.attach(m_counters.back().get());
+    return *m_counters.back();
+}
+
+void rogue::benchmarks::TimeSeries::start()
+{
+    m_start = std::chrono::steady_clock::now();
+    m_last = m_start;
+    m_reporter = std::thread{ [this](){ report(); } };
+}
+
+void rogue::benchmarks::TimeSeries::stop()
+{
+    if(!m_reporter.joinable())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{ m_lock };
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_reporter.join();
+
+    for(LatencyHistogram* histogram : m_histograms)
+    {
+        histogram->attach(nullptr);
+    }
+}
+
+void rogue::benchmarks::TimeSeries::report()
+{
+    std::unique_lock<std::mutex> lock{ m_lock };
+    for(auto next{ m_start + m_interval }; !m_wake.wait_until(lock, next, [this](){ return m_stopping; }); next += m_interval)
+    {
+        sample(next);
+    }
+    // Partial last interval, unless the run ended right on a boundary.
+    const auto now{ std::chrono::steady_clock::now() };
+    if(now - m_last > m_interval / 10)
+    {
+        sample(now);
+    }
+}
+
+void rogue::benchmarks::TimeSeries::sample(const std::chrono::steady_clock::time_point now)
+{
+    std::fill(m_current.begin(), m_current.end(), 0);
+    uint64_t errors{ 0 };
+    uint64_t inFlight{ 0 };
+    for(const auto& counters : m_counters)
+    {
+        for(uint64_t index{ 0 }; index < IntervalCounters::BUCKET_COUNT; ++index)
+        {
+            m_current[index] += counters->countAt(index);
+        }
+        errors += counters->errors();
+        // Workers that never report issued requests have nothing in flight by definition.
+        const uint64_t issued{ counters->issued() };
+        const uint64_t completed{ counters->completed() };
+        inFlight += issued > completed ? issued - completed : 0;
+    }
+
+    uint64_t total{ 0 };
+    for(uint64_t index{ 0 }; index < IntervalCounters::BUCKET_COUNT; ++index)
+    {
+        const uint64_t current{ m_current[index] };
+        m_current[index] = current - m_previous[index];
+        m_previous[index] = current;
+        total += m_current[index];
+    }
+
+    const double seconds{ std::chrono::duration<double>(now - m_last).count() };
+    m_samples.push_back(Sample{
+        std::chrono::duration<double>(now - m_start).count(),
+        seconds > 0 ? total / seconds : 0,
+        percentile(m_current, total, 50),
+        percentile(m_current, total, 99),
+        errors - m_previousErrors,
+        inFlight });
+    m_previousErrors = errors;
+    m_last = now;
+}
+
+void rogue::benchmarks::TimeSeries::write(const std::string& filename) const
+{
+    std::ofstream output{ filename, std::ios::trunc };
+    output << "seconds,ops_per_second,p50_us,p99_us,errors,in_flight\n";
+    for(const Sample& sample : m_samples)
+    {
+        output << std::format("{:.3f},{:.2f},{:.1f},{:.1f},{},{}\n",
+            sample.seconds, sample.operationsPerSecond, sample.p50 / 1000.0, sample.p99 / 1000.0,
+            sample.errors, sample.inFlight);
+    }
+}
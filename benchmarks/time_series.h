@@ -0,0 +1,78 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmarks/latency_histogram.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Per-interval view of a run so stalls and warm-up show up instead of averaging away.
+        // Attach the worker histograms, start when the workers are released and stop once they
+        // finished. A background thread samples the attached counters every interval.
+        class TimeSeries
+        {
+        public:
+            struct Sample
+            {
+                double seconds; // End of the interval since start.
+                double operationsPerSecond;
+                uint64_t p50; // Nanoseconds, 0 when nothing completed in the interval.
+                uint64_t p99;
+                uint64_t errors;
+                uint64_t inFlight;
+            };
+
+            explicit TimeSeries(const std::chrono::milliseconds interval);
+            ~TimeSeries();
+
+            // Only before start. The histograms must outlive stop, which detaches them again.
+            IntervalCounters& attach(LatencyHistogram& histogram);
+            template<typename Histograms>
+            void attachAll(Histograms& histograms)
+            {
+                for(LatencyHistogram& histogram : histograms)
+                {
+                    attach(histogram);
+                }
+            }
+
+            void start();
+            void stop();
+
+            const std::vector<Sample>& samples() const { return m_samples; }
+            // CSV with one row per interval, latencies in microseconds.
+            void write(const std::string& filename) const;
+
+        private:
+            void report();
+            void sample(const std::chrono::steady_clock::time_point now);
+
+            const std::chrono::milliseconds m_interval;
+            std::vector<LatencyHistogram*> m_histograms{};
+            std::vector<std::unique_ptr<IntervalCounters>> m_counters{};
+            std::vector<uint64_t> m_previous{};
+            std::vector<uint64_t> m_current{};
+            uint64_t m_previousErrors{ 0 };
+            std::chrono::steady_clock::time_point m_start{};
+            std::chrono::steady_clock::time_point m_last{};
+            std::vector<Sample> m_samples{};
+
+            std::mutex m_lock{};
+            std::condition_variable m_wake{};
+            bool m_stopping{ false };
+            std::thread m_reporter{};
+        };
+    }
+}
+
+#endif //TIME_SERIES_H
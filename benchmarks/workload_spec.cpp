@@ -0,0 +1,599 @@
+#include <algorithm>
+#include <charconv>
+#include <format>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "benchmarks/common.h"
+#include "benchmarks/executor.h"
+#include "benchmarks/fast_random.h"
+#include "benchmarks/workload_spec.h"
+
+namespace
+{
+    std::string trim(const std::string& value)
+    {
+        const auto begin{ value.find_first_not_of(" \t\r") };
+        if(begin == std::string::npos)
+        {
+            return "";
+        }
+        const auto end{ value.find_last_not_of(" \t\r") };
+        return value.substr(begin, end - begin + 1);
+    }
+
+    std::vector<std::string> split(const std::string& value)
+    {
+        std::vector<std::string> parts{};
+        std::stringstream stream{ value };
+        std::string part{};
+        while(std::getline(stream, part, ','))
+        {
+            if(!trim(part).empty())
+            {
+                parts.push_back(trim(part));
+            }
+        }
+        return parts;
+    }
+
+    template<typename Number>
+    Number parseNumber(const std::string& key, const std::string& value)
+    {
+        Number number{};
+        const auto [end, error]{ std::from_chars(value.data(), value.data() + value.size(), number) };
+        if(error != std::errc{} || end != value.data() + value.size())
+        {
+            throw std::invalid_argument{ std::format("Invalid value for {}: {}", key, value) };
+        }
+        return number;
+    }
+
+    template<typename Number>
+    std::vector<Number> parseList(const std::string& key, const std::string& value)
+    {
+        std::vector<Number> numbers{};
+        for(const std::string& part : split(value))
+        {
+            numbers.push_back(parseNumber<Number>(key, part));
+        }
+        if(numbers.empty())
+        {
+            throw std::invalid_argument{ std::format("{} needs at least one value.", key) };
+        }
+        // Each value names its own benchmark rows, and the results cannot hold a name twice.
+        std::vector<Number> sorted{ numbers };
+        std::sort(sorted.begin(), sorted.end());
+        if(const auto repeated{ std::adjacent_find(sorted.begin(), sorted.end()) }; repeated != sorted.end())
+        {
+            throw std::invalid_argument{ std::format("{} lists {} more than once.", key, *repeated) };
+        }
+        return numbers;
+    }
+
+    double parseFraction(const std::string& key, const std::string& value)
+    {
+        const double fraction{ parseNumber<double>(key, value) };
+        if(fraction < 0 || fraction > 1)
+        {
+            throw std::invalid_argument{ std::format("{} must be between 0 and 1: {}", key, value) };
+        }
+        return fraction;
+    }
+
+    template<typename Value>
+    std::string join(const std::vector<Value>& values)
+    {
+        std::string joined{};
+        for(const auto& value : values)
+        {
+            joined += std::format("{}{}", joined.empty() ? "" : ",", value);
+        }
+        return joined;
+    }
+
+    std::string distributionName(const rogue::utilities::KeyDistribution distribution)
+    {
+        switch(distribution)
+        {
+            case rogue::utilities::KeyDistribution::UNIFORM: return "uniform";
+            case rogue::utilities::KeyDistribution::SEQUENTIAL: return "sequential";
+            case rogue::utilities::KeyDistribution::SCRAMBLED_ZIPFIAN: return "scrambled";
+            case rogue::utilities::KeyDistribution::HOTSPOT: return "hotspot";
+            case rogue::utilities::KeyDistribution::LATEST: return "latest";
+            default: return "zipfian";
+        }
+    }
+
+    std::string arrivalName(const std::optional<rogue::benchmarks::ArrivalProcess>& process)
+    {
+        if(!process)
+        {
+            return "closed";
+        }
+        return *process == rogue::benchmarks::ArrivalProcess::POISSON ? "poisson" : "fixed";
+    }
+}
+
+bool rogue::benchmarks::WorkloadSpec::runs(const std::string& workload) const
+{
+    return std::find(workloads.begin(), workloads.end(), workload) != workloads.end();
+}
+
+uint64_t rogue::benchmarks::WorkloadSpec::seedFor(const uint64_t worker) const
+{
+    if(seed == 0)
+    {
+        std::random_device randomizer{};
+        return (static_cast<uint64_t>(randomizer()) << 32) | randomizer();
+    }
+    return rogue::utilities::SplitMix64{ seed + worker }();
+}
+
+std::string rogue::benchmarks::WorkloadSpec::fieldValue() const
+{
+    std::string value{};
+    value.reserve(fieldLength);
+    while(value.size() < fieldLength)
+    {
+        value += BYTES_100.substr(0, fieldLength - value.size());
+    }
+    return value;
+}
+
+void rogue::benchmarks::applySetting(WorkloadSpec& spec, const std::string& key, const std::string& value)
+{
+    if(key == "address")
+    {
+        spec.address = value;
+    }
+    else if(key == "recordcount")
+    {
+        spec.recordCount = parseNumber<uint64_t>(key, value);
+        spec.keys.keys = spec.recordCount;
+    }
+    else if(key == "operationcount")
+    {
+        spec.operationCount = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "threadcount")
+    {
+        spec.workers = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "maxexecutiontime")
+    {
+        spec.maxExecutionTime = std::chrono::seconds{ parseNumber<uint64_t>(key, value) };
+    }
+    else if(key == "seed")
+    {
+        spec.seed = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "reportinterval")
+    {
+        spec.reportInterval = std::chrono::milliseconds{ parseNumber<uint64_t>(key, value) };
+    }
+    else if(key == "hardwarecounters")
+    {
+        if(value != "true" && value != "false")
+        {
+            throw std::invalid_argument{ std::format("hardwarecounters must be true or false: {}", value) };
+        }
+        spec.hardwareCounters = value == "true";
+    }
+    else if(key == "allocations")
+    {
+        if(value != "report" && value != "strict")
+        {
+            throw std::invalid_argument{ std::format("allocations must be report or strict: {}", value) };
+        }
+        spec.strictAllocations = value == "strict";
+    }
+    else if(key == "payloadpool")
+    {
+        spec.payloadPool = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "preparedsearch")
+    {
+        if(value != "true" && value != "false")
+        {
+            throw std::invalid_argument{ std::format("preparedsearch must be true or false: {}", value) };
+        }
+        spec.preparedSearch = value == "true";
+    }
+    else if(key == "localserver")
+    {
+        if(value != "none" && value != "sync" && value != "callback" && value != "async")
+        {
+            throw std::invalid_argument{ std::format("localserver must be none, sync, callback, or async: {}", value) };
+        }
+        spec.localServer = value;
+    }
+    else if(key == "serverthreads")
+    {
+        spec.serverThreads = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "transports")
+    {
+        spec.transports = split(value);
+        for(const std::string& transport : spec.transports)
+        {
+            if(transport != "tcp" && transport != "unix" && transport != "inprocess")
+            {
+                throw std::invalid_argument{ std::format("transports must be tcp, unix, or inprocess: {}", transport) };
+            }
+        }
+    }
+    else if(key == "clientstyles")
+    {
+        spec.clientStyles = split(value);
+        for(const std::string& style : spec.clientStyles)
+        {
+            if(style != "sync" && style != "callback" && style != "async")
+            {
+                throw std::invalid_argument{ std::format("clientstyles must be sync, callback, or async: {}", style) };
+            }
+        }
+    }
+    else if(key == "warmupoperations")
+    {
+        spec.warmupOperations = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "warmuptime")
+    {
+        spec.warmupTime = std::chrono::seconds{ parseNumber<uint64_t>(key, value) };
+    }
+    else if(key == "repetitions")
+    {
+        spec.repetitions = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "minrepetitions")
+    {
+        spec.minRepetitions = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "targetprecision")
+    {
+        spec.targetPrecision = parseFraction(key, value);
+    }
+    else if(key == "batchsizes")
+    {
+        spec.batchSizes = parseList<uint64_t>(key, value);
+    }
+    else if(key == "grpcthreads")
+    {
+        spec.grpcThreads = parseList<uint64_t>(key, value);
+    }
+    else if(key == "ports")
+    {
+        spec.ports = parseList<uint64_t>(key, value);
+    }
+    else if(key == "servers")
+    {
+        spec.servers = parseList<uint64_t>(key, value);
+    }
+    else if(key == "workloads")
+    {
+        spec.workloads = split(value);
+    }
+    else if(key == "readproportion")
+    {
+        spec.proportions[0] = parseFraction(key, value);
+    }
+    else if(key == "updateproportion")
+    {
+        spec.proportions[1] = parseFraction(key, value);
+    }
+    else if(key == "insertproportion")
+    {
+        spec.proportions[2] = parseFraction(key, value);
+    }
+    else if(key == "readmodifywriteproportion")
+    {
+        spec.proportions[3] = parseFraction(key, value);
+    }
+    else if(key == "requestdistribution")
+    {
+        spec.keys.distribution = rogue::utilities::keyDistribution(value);
+    }
+    else if(key == "zipfianconstant")
+    {
+        spec.keys.exponent = parseNumber<double>(key, value);
+    }
+    else if(key == "hotspotdatafraction")
+    {
+        spec.keys.hotKeyFraction = parseFraction(key, value);
+    }
+    else if(key == "hotspotopnfraction")
+    {
+        spec.keys.hotOperationFraction = parseFraction(key, value);
+    }
+    else if(key == "arrival")
+    {
+        if(value == "closed")
+        {
+            spec.openLoop.reset();
+        }
+        else if(value == "fixed")
+        {
+            spec.openLoop = ArrivalProcess::FIXED_INTERVAL;
+        }
+        else if(value == "poisson")
+        {
+            spec.openLoop = ArrivalProcess::POISSON;
+        }
+        else
+        {
+            throw std::invalid_argument{ std::format("Unknown arrival process: {}", value) };
+        }
+    }
+    else if(key == "saturationfractions")
+    {
+        spec.saturationFractions = parseList<double>(key, value);
+    }
+    else if(key == "streams")
+    {
+        spec.streams = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "pollers")
+    {
+        spec.pollers = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "streamsperchannel")
+    {
+        spec.streamsPerChannel = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "window")
+    {
+        spec.window = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "fieldcount")
+    {
+        spec.fieldCount = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "fieldlength")
+    {
+        spec.fieldLength = parseNumber<uint64_t>(key, value);
+    }
+    else if(key == "cores")
+    {
+        spec.cores = parseCpuList(value);
+    }
+    else if(key == "numanode")
+    {
+        if(value.empty())
+        {
+            spec.numaNode.reset();
+        }
+        else
+        {
+            spec.numaNode = parseNumber<uint32_t>(key, value);
+        }
+    }
+    else if(key == "grpccores")
+    {
+        spec.grpcCores = parseCpuList(value);
+    }
+    else
+    {
+        throw std::invalid_argument{ std::format("Unknown workload property: {}", key) };
+    }
+}
+
+void rogue::benchmarks::loadWorkloadSpec(WorkloadSpec& spec, const std::string& path)
+{
+    std::ifstream input{ path };
+    if(!input)
+    {
+        throw std::invalid_argument{ std::format("Could not open workload spec: {}", path) };
+    }
+
+    std::string line{};
+    for(uint64_t number{ 1 }; std::getline(input, line); ++number)
+    {
+        line = trim(line.substr(0, line.find('#')));
+        if(line.empty())
+        {
+            continue;
+        }
+        const auto separator{ line.find('=') };
+        if(separator == std::string::npos)
+        {
+            throw std::invalid_argument{ std::format("{}:{}: expected key = value", path, number) };
+        }
+        applySetting(spec, trim(line.substr(0, separator)), trim(line.substr(separator + 1)));
+    }
+}
+
+rogue::benchmarks::WorkloadSpec rogue::benchmarks::parseWorkloadSpec(
+    const int argc,
+    char** argv,
+    WorkloadSpec spec)
+{
+    std::vector<std::pair<std::string, std::string>> overrides{};
+    for(int index{ 1 }; index < argc; ++index)
+    {
+        const std::string argument{ argv[index] };
+        if(!argument.starts_with("--"))
+        {
+            if(!spec.address.empty())
+            {
+                throw std::invalid_argument{ std::format("Unexpected argument: {}", argument) };
+            }
+            spec.address = argument;
+            continue;
+        }
+
+        const auto separator{ argument.find('=') };
+        if(separator == std::string::npos)
+        {
+            throw std::invalid_argument{ std::format("Expected --key=value: {}", argument) };
+        }
+        const std::string key{ argument.substr(2, separator - 2) };
+        const std::string value{ argument.substr(separator + 1) };
+        if(key == "spec")
+        {
+            loadWorkloadSpec(spec, value);
+        }
+        else
+        {
+            overrides.emplace_back(key, value);
+        }
+    }
+    for(const auto& [key, value] : overrides)
+    {
+        applySetting(spec, key, value);
+    }
+
+    if(spec.address.empty())
+    {
+        throw std::invalid_argument{ "Missing server address." };
+    }
+    if(spec.workers < 4)
+    {
+        throw std::invalid_argument{ "threadcount must be at least 4." };
+    }
+    if(spec.operationCount < spec.workers)
+    {
+        throw std::invalid_argument{ "operationcount must be at least threadcount." };
+    }
+    if(spec.recordCount == 0)
+    {
+        throw std::invalid_argument{ "recordcount must be greater than 0." };
+    }
+    if(spec.reportInterval.count() == 0)
+    {
+        throw std::invalid_argument{ "reportinterval must be greater than 0." };
+    }
+    if(spec.repetitions == 0)
+    {
+        throw std::invalid_argument{ "repetitions must be greater than 0." };
+    }
+    if(spec.minRepetitions > spec.repetitions)
+    {
+        throw std::invalid_argument{ "minrepetitions must be at most repetitions." };
+    }
+    if(spec.fieldCount > 10)
+    {
+        throw std::invalid_argument{ "fieldcount must be at most 10." };
+    }
+    if(spec.runs("custom") && spec.proportions[0] + spec.proportions[1] + spec.proportions[2] + spec.proportions[3] <= 0)
+    {
+        throw std::invalid_argument{ "The custom workload needs at least one operation proportion." };
+    }
+    if(std::find(spec.batchSizes.begin(), spec.batchSizes.end(), 0) != spec.batchSizes.end())
+    {
+        throw std::invalid_argument{ "batchsizes must be greater than 0." };
+    }
+    if(spec.streams == 0 || spec.pollers == 0 || spec.streamsPerChannel == 0 || spec.window == 0)
+    {
+        throw std::invalid_argument{ "streams, pollers, streamsperchannel and window must be greater than 0." };
+    }
+    if(spec.operationCount < spec.streams && (spec.runs("async-read") || spec.runs("async-write")))
+    {
+        throw std::invalid_argument{ "operationcount must be at least streams." };
+    }
+    return spec;
+}
+
+std::string rogue::benchmarks::workloadUsage(const std::string& program)
+{
+    return std::format(
+        "Usage: {} [address] [--spec=file] [--key=value]...\n"
+        "Properties (spec file lines are key = value, # starts a comment):\n"
+        "  address, recordcount, operationcount, threadcount, maxexecutiontime (seconds), seed\n"
+        "  reportinterval (milliseconds between time series samples)\n"
+        "  hardwarecounters (true to record cycles, instructions and cache misses per operation)\n"
+        "  allocations (report, strict to fail a run whose steady-state loop allocates)\n"
+        "  payloadpool (pre-serialized Inserts per writer sent as raw bytes, 0 builds every Insert)\n"
+        "  preparedsearch (true to patch ids into a serialized Search instead of building each one)\n"
+        "  localserver (none, sync, callback, async Experiment server run by grpc_benchmarks), serverthreads\n"
+        "  transports (tcp, unix, inprocess transport sweep of grpc_benchmarks)\n"
+        "  clientstyles (sync, callback, async client API matrix)\n"
+        "  warmupoperations, warmuptime (seconds), repetitions, minrepetitions, targetprecision\n"
+        "  workloads (general, read, write, dual, async-read, async-write, a, b, c, d, f, custom)\n"
+        "  readproportion, updateproportion, insertproportion, readmodifywriteproportion\n"
+        "  requestdistribution (zipfian, scrambled, hotspot, latest, uniform, sequential)\n"
+        "  zipfianconstant, hotspotdatafraction, hotspotopnfraction\n"
+        "  arrival (closed, fixed, poisson), saturationfractions\n"
+        "  batchsizes, grpcthreads, ports, servers, fieldcount, fieldlength\n"
+        "  streams, pollers, streamsperchannel, window (async-read and async-write)\n"
+        "  cores, numanode, grpccores (cpu lists such as 0-3,8)\n",
+        program);
+}
+
+std::vector<std::pair<std::string, std::string>> rogue::benchmarks::workloadSettings(const WorkloadSpec& spec)
+{
+    return {
+        { "address", spec.address },
+        { "recordcount", std::format("{}", spec.recordCount) },
+        { "operationcount", std::format("{}", spec.operationCount) },
+        { "threadcount", std::format("{}", spec.workers) },
+        { "maxexecutiontime", std::format("{}", spec.maxExecutionTime.count()) },
+        { "seed", std::format("{}", spec.seed) },
+        { "reportinterval", std::format("{}", spec.reportInterval.count()) },
+        { "hardwarecounters", spec.hardwareCounters ? "true" : "false" },
+        { "allocations", spec.strictAllocations ? "strict" : "report" },
+        { "payloadpool", std::format("{}", spec.payloadPool) },
+        { "preparedsearch", spec.preparedSearch ? "true" : "false" },
+        { "localserver", spec.localServer },
+        { "serverthreads", std::format("{}", spec.serverThreads) },
+        { "transports", join(spec.transports) },
+        { "clientstyles", join(spec.clientStyles) },
+        { "warmupoperations", std::format("{}", spec.warmupOperations) },
+        { "warmuptime", std::format("{}", spec.warmupTime.count()) },
+        { "repetitions", std::format("{}", spec.repetitions) },
+        { "minrepetitions", std::format("{}", spec.minRepetitions) },
+        { "targetprecision", std::format("{}", spec.targetPrecision) },
+        { "workloads", join(spec.workloads) },
+        { "readproportion", std::format("{}", spec.proportions[0]) },
+        { "updateproportion", std::format("{}", spec.proportions[1]) },
+        { "insertproportion", std::format("{}", spec.proportions[2]) },
+        { "readmodifywriteproportion", std::format("{}", spec.proportions[3]) },
+        { "requestdistribution", distributionName(spec.keys.distribution) },
+        { "zipfianconstant", std::format("{}", spec.keys.exponent) },
+        { "hotspotdatafraction", std::format("{}", spec.keys.hotKeyFraction) },
+        { "hotspotopnfraction", std::format("{}", spec.keys.hotOperationFraction) },
+        { "arrival", arrivalName(spec.openLoop) },
+        { "saturationfractions", join(spec.saturationFractions) },
+        { "batchsizes", join(spec.batchSizes) },
+        { "grpcthreads", join(spec.grpcThreads) },
+        { "ports", join(spec.ports) },
+        { "servers", join(spec.servers) },
+        { "streams", std::format("{}", spec.streams) },
+        { "pollers", std::format("{}", spec.pollers) },
+        { "streamsperchannel", std::format("{}", spec.streamsPerChannel) },
+        { "window", std::format("{}", spec.window) },
+        { "fieldcount", std::format("{}", spec.fieldCount) },
+        { "fieldlength", std::format("{}", spec.fieldLength) },
+        { "cores", join(spec.cores) },
+        { "numanode", spec.numaNode ? std::to_string(*spec.numaNode) : "" },
+        { "grpccores", join(spec.grpcCores) }
+    };
+}
+
+void rogue::benchmarks::writeWorkloadSpec(const std::string& filename, const WorkloadSpec& spec)
+{
+    std::ofstream output{ filename, std::ios::trunc };
+    for(const auto& [key, value] : workloadSettings(spec))
+    {
+        output << std::format("{} = {}\n", key, value);
+    }
+}
+
+void rogue::benchmarks::fillFields(google::protobuf::Message& message, const WorkloadSpec& spec)
+{
+    const std::string value{ spec.fieldValue() };
+    const google::protobuf::Descriptor* descriptor{ message.GetDescriptor() };
+    const google::protobuf::Reflection* reflection{ message.GetReflection() };
+    uint64_t filled{ 0 };
+    for(int index{ 0 }; index < descriptor->field_count() && filled < spec.fieldCount; ++index)
+    {
+        const google::protobuf::FieldDescriptor* field{ descriptor->field(index) };
+        if(field->type() == google::protobuf::FieldDescriptor::TYPE_STRING && !field->is_repeated())
+        {
+            reflection->SetString(&message, field, value);
+            ++filled;
+        }
+    }
+}
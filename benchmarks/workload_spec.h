@@ -0,0 +1,138 @@
+#ifndef WORKLOAD_SPEC_H
+#define WORKLOAD_SPEC_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <google/protobuf/message.h>
+
+#include "benchmarks/arrival_schedule.h"
+#include "benchmarks/key_generators.h"
+
+namespace rogue
+{
+    namespace benchmarks
+    {
+        // Everything a benchmark run can vary without recompiling. Loaded from a key=value
+        // spec file and/or --key=value overrides on the command line. Property names follow
+        // the YCSB workload files where there is an equivalent.
+        struct WorkloadSpec
+        {
+            std::string address{};
+            uint64_t recordCount{ 5000000 };
+            uint64_t operationCount{ 5400000 };
+            uint64_t workers{ 50 };
+            std::chrono::seconds maxExecutionTime{ 0 }; // Runs until the operation count when 0.
+            uint64_t seed{ 0 }; // Seeded from std::random_device when 0.
+            std::chrono::milliseconds reportInterval{ 1000 }; // Time series sampling interval.
+            bool hardwareCounters{ false }; // perf_event counters per benchmark, see ResourceCounters.
+            bool strictAllocations{ false }; // Fails a run whose warm hot loop allocates, see SteadyState.
+            uint64_t payloadPool{ 0 }; // Pre-serialized Inserts per writer, see PayloadPool. Off when 0.
+            bool preparedSearch{ false }; // Point lookups patch a serialized Search, see PreparedSearch.
+            // Experiment server grpc_benchmarks starts in-process: none, sync, callback, or async.
+            std::string localServer{ "none" };
+            uint64_t serverThreads{ 0 }; // See ServerOptions::threads.
+            // Transport sweep of grpc_benchmarks: tcp, unix, inprocess. Skipped when empty.
+            std::vector<std::string> transports{};
+            // Client style matrix: sync, callback, async, see ClientStyleRunner. Skipped when empty.
+            std::vector<std::string> clientStyles{};
+
+            // Warm-up and repetitions of the benchmark runner, see repeat.
+            // Operations per warm-up pass, operationCount when 0. No warm-up when both are 0.
+            uint64_t warmupOperations{ 0 };
+            std::chrono::seconds warmupTime{ 0 };
+            uint64_t repetitions{ 1 };
+            uint64_t minRepetitions{ 1 };
+            double targetPrecision{ .02 }; // 95% confidence half-width relative to the mean.
+
+            std::vector<uint64_t> batchSizes{ 1, 10, 100, 1000 };
+            std::vector<uint64_t> grpcThreads{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+            std::vector<uint64_t> ports{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+            std::vector<uint64_t> servers{ 1, 2, 3, 4, 5 };
+
+            std::vector<std::string> workloads{ "general", "read", "write", "dual", "a", "b", "c", "d", "f" };
+            // Operation mix of the "custom" workload: read, update, insert, read-modify-write.
+            std::array<double, 4> proportions{ .5, .5, 0, 0 };
+            rogue::utilities::KeySelection keys{ rogue::utilities::KeyDistribution::ZIPFIAN, recordCount };
+
+            std::optional<ArrivalProcess> openLoop{};
+            std::vector<double> saturationFractions{ .5, .8, .95 };
+
+            // Completion-queue workloads (async-read, async-write), see StreamEngine.
+            uint64_t streams{ 1000 };
+            uint64_t pollers{ 4 };
+            uint64_t streamsPerChannel{ 100 };
+            uint64_t window{ 1 };
+
+            uint64_t fieldCount{ 10 };
+            uint64_t fieldLength{ 50 };
+
+            // Core placement of the executor, see configureExecutor.
+            std::vector<uint32_t> cores{};
+            std::optional<uint32_t> numaNode{};
+            std::vector<uint32_t> grpcCores{};
+
+            bool runs(const std::string& workload) const;
+            // Seed of a worker's random engines. Reproducible across runs when seed is set.
+            uint64_t seedFor(const uint64_t worker) const;
+            // Value of every payload field, fieldLength characters long.
+            std::string fieldValue() const;
+        };
+
+        // Applies a single property, throwing std::invalid_argument for unknown keys or values.
+        void applySetting(WorkloadSpec& spec, const std::string& key, const std::string& value);
+        void loadWorkloadSpec(WorkloadSpec& spec, const std::string& path);
+        // [program] [address] [--spec=file] [--key=value]...
+        // The spec file is applied first so command line overrides always win.
+        WorkloadSpec parseWorkloadSpec(const int argc, char** argv, WorkloadSpec spec = {});
+        std::string workloadUsage(const std::string& program);
+        // Every property of the spec as key, value in the spec file format.
+        std::vector<std::pair<std::string, std::string>> workloadSettings(const WorkloadSpec& spec);
+        // Writes the effective spec in the spec file format so the run can be repeated.
+        void writeWorkloadSpec(const std::string& filename, const WorkloadSpec& spec);
+        // Sets the first fieldcount string fields of the message to fieldlength characters.
+        void fillFields(google::protobuf::Message& message, const WorkloadSpec& spec);
+
+        // Loop condition of a worker: the operation count, or the deadline in duration-based runs.
+        class OperationLimit
+        {
+        public:
+            OperationLimit(
+                const WorkloadSpec& spec,
+                const uint64_t operations) :
+                m_operations{ operations },
+                m_duration{ spec.maxExecutionTime }
+            {}
+
+            void start()
+            {
+                m_deadline = std::chrono::steady_clock::now() + m_duration;
+            }
+
+            bool running(const uint64_t count) const
+            {
+                return m_duration.count() == 0
+                    ? count < m_operations
+                    : std::chrono::steady_clock::now() < m_deadline;
+            }
+
+            // Whether a batch may take another operation. Batches are only cut short by the
+            // operation count, never by the deadline.
+            bool allows(const uint64_t count) const
+            {
+                return m_duration.count() != 0 || count < m_operations;
+            }
+
+        private:
+            const uint64_t m_operations;
+            const std::chrono::seconds m_duration;
+            std::chrono::steady_clock::time_point m_deadline{};
+        };
+    }
+}
+
+#endif //WORKLOAD_SPEC_H
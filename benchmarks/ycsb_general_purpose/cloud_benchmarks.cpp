@@ -1,21 +1,35 @@
+#include <array>
+#include <atomic>
+#include <functional>
 #include <latch>
+#include <optional>
 #include <random>
 #include <grpcpp/grpcpp.h>
 
+#include "benchmarks/allocation_counter.h"
+#include "benchmarks/arrival_schedule.h"
+#include "benchmarks/benchmark_runner.h"
+#include "benchmarks/client_styles.h"
 #include "benchmarks/common.h"
-#include "benchmarks/zipfian_generator.h"
+#include "benchmarks/workload_spec.h"
+#include "benchmarks/key_generators.h"
+#include "benchmarks/message_arena.h"
+#include "benchmarks/payload_pool.h"
+#include "benchmarks/stream_engine.h"
 
 #include "getting_started/roguedb.grpc.pb.h"
 #include "getting_started/test.pb.h"
 #include "protos/dummy.pb.h"
+#include "roguedb_driver/cpp/prepared_search.h"
 
 
 const std::string BENCHMARK_FILE{ "BENCHMARKS.md" };
+const std::string SPEC_FILE{ "BENCHMARKS_SPEC.txt" };
 
-void subscribe(const std::string& ipAddress)
+void subscribe(const rogue::benchmarks::WorkloadSpec& spec)
 {
     std::unique_ptr<rogue::services::RogueDB::Stub> stub{ rogue::services::RogueDB::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials()))};
+        grpc::CreateChannel(std::format("{}:80", spec.address), grpc::InsecureChannelCredentials()))};
     
     grpc::ClientContext context{};
     rogue::services::Response response{};
@@ -24,10 +38,10 @@ void subscribe(const std::string& ipAddress)
     std::this_thread::sleep_for(std::chrono::seconds(2));
 }
 
-void complete(const std::string& ipAddress)
+void complete(const rogue::benchmarks::WorkloadSpec& spec)
 {
     std::unique_ptr<rogue::services::RogueDB::Stub> stub{ rogue::services::RogueDB::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials()))};
+        grpc::CreateChannel(std::format("{}:80", spec.address), grpc::InsecureChannelCredentials()))};
     
     grpc::ClientContext context{};
     rogue::services::Response response{};
@@ -41,11 +55,11 @@ void complete(const std::string& ipAddress)
     }
 }
 
-void initialData(const std::string& ipAddress)
+void initialData(const rogue::benchmarks::WorkloadSpec& spec)
 {
-    // 5M rows of data (eg. 2.5GBs)
+    // recordcount rows of data (eg. 5M rows with 10 fields of 50 bytes is 2.5GBs)
     std::unique_ptr<rogue::services::RogueDB::Stub> stub{ rogue::services::RogueDB::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials()))
+        grpc::CreateChannel(std::format("{}:80", spec.address), grpc::InsecureChannelCredentials()))
     };
     grpc::ClientContext context{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{
@@ -53,25 +67,21 @@ void initialData(const std::string& ipAddress)
 
     std::cout << "Generating initial state." << std::endl;
 
+    rogue::benchmarks::Dummy dummy{};
+    rogue::benchmarks::fillFields(dummy, spec);
+
+    // One request for every round. clear_messages keeps the cleared Anys and their buffers for
+    // add_messages to reuse instead of allocating 1M messages again each round.
+    rogue::benchmarks::MessageArena arena{};
+    rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
+    insert.set_api_key(rogue::benchmarks::API_KEY);
     uint64_t count{ 0 };
-    for(uint64_t round{ 1 }; round <= 5; ++round)
+    for(uint64_t round{ 1 }; count < spec.recordCount; ++round)
     {
-        rogue::services::Insert insert{};
-        insert.set_api_key(rogue::benchmarks::API_KEY);
-        for(; count < round * 1000000;)
+        insert.clear_messages();
+        for(; count < std::min(round * 1000000, spec.recordCount);)
         {
-            rogue::benchmarks::Dummy dummy{};
             dummy.set_id(count++);
-            dummy.set_field1(rogue::benchmarks::BYTES_50);
-            dummy.set_field2(rogue::benchmarks::BYTES_50);
-            dummy.set_field3(rogue::benchmarks::BYTES_50);
-            dummy.set_field4(rogue::benchmarks::BYTES_50);
-            dummy.set_field5(rogue::benchmarks::BYTES_50);
-            dummy.set_field6(rogue::benchmarks::BYTES_50);
-            dummy.set_field7(rogue::benchmarks::BYTES_50);
-            dummy.set_field8(rogue::benchmarks::BYTES_50);
-            dummy.set_field9(rogue::benchmarks::BYTES_50);
-            dummy.set_field10(rogue::benchmarks::BYTES_50);
             insert.add_messages()->PackFrom(dummy);
         }
         
@@ -83,15 +93,15 @@ void initialData(const std::string& ipAddress)
         }
     }
     stream->WritesDone();
-    complete(ipAddress);
+    complete(spec);
     std::cout << "Finished generating initial state." << std::endl;
 }
 
-void validationData(const std::string& ipAddress)
+void validationData(const rogue::benchmarks::WorkloadSpec& spec)
 {
     // 5M rows of data (eg. 2.5GBs)
     std::unique_ptr<rogue::services::RogueDB::Stub> stub{ rogue::services::RogueDB::NewStub(
-        grpc::CreateChannel(std::format("{}:80", ipAddress), grpc::InsecureChannelCredentials()))
+        grpc::CreateChannel(std::format("{}:80", spec.address), grpc::InsecureChannelCredentials()))
     };
     grpc::ClientContext context{};
     std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{
@@ -120,39 +130,213 @@ void validationData(const std::string& ipAddress)
         }
     }
     stream->WritesDone();
-    complete(ipAddress);
+    complete(spec);
     std::cout << "Finished generating initial state." << std::endl;
 }
 
-void generalEvenSplit(const std::string& ipAddress)
+// Adds queries EQUAL point lookups with empty operands, which each request repacks with a key.
+void addPointQueries(rogue::services::Search& search, const uint64_t queries)
+{
+    search.set_api_key(rogue::benchmarks::API_KEY);
+    for(uint64_t count{ 0 }; count < queries; ++count)
+    {
+        rogue::services::Basic& expression{ *search.add_queries()->mutable_basic() };
+        expression.set_logical_operator(rogue::services::LogicalOperator::AND);
+        expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
+        expression.add_operands();
+    }
+}
+
+// Next request of a streamed read: batchSize point lookups for the next keys of the stream.
+// The queries are added on the first request and only repacked afterwards.
+rogue::benchmarks::StreamEngine<rogue::services::Search>::Next pointSearches(
+    const uint64_t batchSize,
+    std::vector<rogue::utilities::KeyBuffer>& keys)
+{
+    return [batchSize, &keys](rogue::services::Search& search, const uint64_t stream)
+    {
+        if(search.queries_size() == 0)
+        {
+            addPointQueries(search, batchSize);
+        }
+
+        rogue::benchmarks::Dummy dummy{};
+        for(uint64_t inner{ 0 }; inner < batchSize; ++inner)
+        {
+            dummy.set_id(keys[stream].next());
+            rogue::benchmarks::repack(*search.mutable_queries(inner)->mutable_basic()->mutable_operands(0), dummy);
+        }
+    };
+}
+
+// Read loop of the preparedsearch mode. The Search of batchSize point lookups is serialized
+// once and only the id of each query is written into it per request.
+void preparedReads(
+    const std::shared_ptr<grpc::Channel>& channel,
+    const uint64_t batchSize,
+    rogue::utilities::KeyBuffer& keys,
+    std::latch& latch,
+    rogue::benchmarks::ArrivalSchedule& schedule,
+    rogue::benchmarks::OperationLimit& limit,
+    rogue::benchmarks::StreamTimestamps& timestamps,
+    rogue::benchmarks::LatencyHistogram& histogram)
+{
+    rogue::services::Search search{};
+    search.set_api_key(rogue::benchmarks::API_KEY);
+    std::vector<rogue::driver::Parameter> parameters{};
+    for(uint64_t index{ 0 }; index < batchSize; ++index)
+    {
+        rogue::services::Basic& expression{ *search.add_queries()->mutable_basic() };
+        expression.set_logical_operator(rogue::services::LogicalOperator::AND);
+        expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
+        expression.add_operands()->PackFrom(rogue::benchmarks::Dummy{});
+        parameters.push_back({ { static_cast<int>(index) }, 0, rogue::benchmarks::Dummy::kIdFieldNumber });
+    }
+    rogue::driver::PreparedSearch prepared{ search, parameters };
+
+    grpc::ClientContext context{};
+    std::unique_ptr<rogue::driver::SearchStream> stream{ rogue::driver::searchStream(*channel, context) };
+    latch.wait();
+    schedule.start();
+    limit.start();
+    std::thread consumer{
+        [&stream, &timestamps, &histogram, batchSize]()
+        {
+            rogue::benchmarks::pinToGrpcCores();
+            rogue::benchmarks::FinishedTracker tracker{ timestamps, histogram, batchSize };
+            rogue::benchmarks::MessageArena arena{};
+            rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
+            while(stream->Read(&readResponse))
+            {
+                tracker.finished(readResponse.finished_size());
+            }
+            grpc::Status status{ stream->Finish() };
+            if(!status.ok())
+            {
+                std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+                throw std::runtime_error{"Could not recover."};
+            }
+        }
+    };
+
+    for(uint64_t count{ 0 }, batch{ 0 }; limit.running(count); ++batch)
+    {
+        for(uint64_t inner{ 0 }; inner < batchSize; ++inner, ++count)
+        {
+            prepared.set(inner, keys.next());
+        }
+        timestamps.sent(batch, schedule.next());
+        histogram.issued(batchSize);
+        stream->Write(prepared.buffer());
+    }
+    stream->WritesDone();
+    consumer.join();
+    std::cout << "finished searches" << std::endl;
+}
+
+// Write loop of the payloadpool mode. Each write is a slot of the pool with its keys patched,
+// sent as raw bytes. Nothing is packed or serialized per write.
+void rawWrites(
+    const std::shared_ptr<grpc::Channel>& channel,
+    rogue::benchmarks::PayloadPool& pool,
+    const uint64_t batchSize,
+    std::atomic<uint64_t>& inserted,
+    std::latch& latch,
+    rogue::benchmarks::ArrivalSchedule& schedule,
+    rogue::benchmarks::OperationLimit& limit,
+    rogue::benchmarks::LatencyHistogram& histogram)
 {
-    subscribe(ipAddress);
-    initialData(ipAddress);
+    rogue::benchmarks::RawInsertStream stream{ channel };
+    latch.wait();
+    schedule.start();
+    limit.start();
+    for(uint64_t count{ 0 }; limit.running(count); count += batchSize)
+    {
+        const grpc::ByteBuffer payload{ pool.next(inserted.fetch_add(batchSize, std::memory_order_relaxed)) };
+        const auto sent{ schedule.next() };
+        if(!stream.write(payload))
+        {
+            grpc::Status status{ stream.finish() };
+            std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+            throw std::runtime_error{"Could not recover."};
+        }
+        histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
+    }
+    grpc::Status status{ stream.finish() };
+    if(!status.ok())
+    {
+        std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+        throw std::runtime_error{"Could not recover."};
+    }
+    std::cout << "finished writes" << std::endl;
+}
+
+// One channel per worker. The arguments differ by the worker index so each channel gets its
+// own connection. Workloads create them on the main thread, which runs on grpccores, before
+// dispatching work, so the threads gRPC starts for them do not inherit a worker's core.
+std::vector<std::shared_ptr<grpc::Channel>> workerChannels(const rogue::benchmarks::WorkloadSpec& spec, const std::string& key)
+{
+    std::vector<std::shared_ptr<grpc::Channel>> channels{};
+    for(uint64_t index{ 0 }; index < spec.workers; ++index)
+    {
+        grpc::ChannelArguments arguments{};
+        arguments.SetInt(key, index);
+        channels.push_back(grpc::CreateCustomChannel(
+            std::format("{}:80", spec.address), 
+            grpc::InsecureChannelCredentials(),
+            arguments));
+        // Connects now instead of on the first call from a worker.
+        channels.back()->GetState(true);
+    }
+    return channels;
+}
+
+rogue::benchmarks::Measurement generalEvenSplit(
+    const rogue::benchmarks::WorkloadSpec& spec, 
+    const rogue::benchmarks::LoadMode& load,
+    rogue::benchmarks::TimeSeries& series)
+{
+    subscribe(spec);
+    initialData(spec);
     std::this_thread::sleep_for(std::chrono::seconds(5));
+    // Next id to insert. Writers claim their ids from it, so latest reads follow the inserts.
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
 
     std::latch latch{ 1 };
-    const uint64_t operationsPerThread{ (rogue::benchmarks::TOTAL_OPERATIONS / 2) / (rogue::benchmarks::TOTAL_WORKERS / 2) };
+    const std::vector<std::shared_ptr<grpc::Channel>> channels{ workerChannels(spec, "dummy") };
+    const uint64_t operationsPerThread{ (spec.operationCount / 2) / (spec.workers / 2) };
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(spec.workers);
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    series.attachAll(histograms);
     
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 2; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers / 2; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
-                
+                const std::shared_ptr<grpc::Channel>& channel{ channels[temp] };
+
+                rogue::utilities::KeyBuffer keys{ 
+                    rogue::utilities::makeKeyGenerator(spec.keys, insertedKeys), spec.seedFor(temp) };
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[temp] };
+                rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread };
+                // The rate is the total of readers and writers, so each worker takes 1 / workers of it.
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, 1, spec.seedFor(temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
+
+                if(spec.preparedSearch)
+                {
+                    preparedReads(channel, 1, keys, latch, schedule, limit, timestamps, histogram);
+                    return;
+                }
+
+                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(channel) };
                 grpc::ClientContext readerContext{};
                 std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
                     readerStub->search(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
                 
-                rogue::services::Search search{};
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& search{ arena.create<rogue::services::Search>() };
                 search.set_api_key(rogue::benchmarks::API_KEY);
                 rogue::services::Query& query{ *search.add_queries() };
                 rogue::services::Basic& expression{ *query.mutable_basic() };
@@ -160,13 +344,21 @@ void generalEvenSplit(const std::string& ipAddress)
                 expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
                 expression.add_operands();
 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, "General Read:Write 50:50 reads" };
                 latch.wait();
+                schedule.start();
+                limit.start();
                 std::thread consumer{
-                    [&stream]()
+                    [&stream, &timestamps, &histogram]()
                     {
-                        rogue::services::Response readResponse{};
+                        rogue::benchmarks::pinToGrpcCores();
+                        rogue::benchmarks::FinishedTracker tracker{ timestamps, histogram, 1 };
+                        rogue::benchmarks::MessageArena arena{};
+                        rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
                         while(stream->Read(&readResponse))
-                        {}
+                        {
+                            tracker.finished(readResponse.finished_size());
+                        }
                         grpc::Status status{ stream->Finish() };
                         if(!status.ok())
                         {
@@ -177,68 +369,77 @@ void generalEvenSplit(const std::string& ipAddress)
                 };
 
                 rogue::benchmarks::Dummy dummy{};
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
-
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
+                for(uint64_t count{ 0 }; limit.running(count); ++count)
                 {
-                    dummy.set_id(zipfianGenerator());
-                    search.mutable_queries(0)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+                    steady.building();
+                    dummy.set_id(keys.next());
+                    rogue::benchmarks::repack(*search.mutable_queries(0)->mutable_basic()->mutable_operands(0), dummy);
+                    steady.built();
+                    timestamps.sent(count, schedule.next());
+                    histogram.issued(1);
                     stream->Write(search);
                 }
+                steady.finish();
                 stream->WritesDone();
                 consumer.join();
                 std::cout << "finished reads" << std::endl;
             });
     }
     
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 2; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers / 2; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                const std::shared_ptr<grpc::Channel>& channel{ channels[temp] };
                 
+                rogue::benchmarks::Dummy dummy{};
+                rogue::benchmarks::fillFields(dummy, spec);
+                rogue::benchmarks::LatencyHistogram& histogram{ 
+                    histograms[(spec.workers / 2) + temp] };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, 1, spec.seedFor((spec.workers / 2) + temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
+
+                if(spec.payloadPool > 0)
+                {
+                    rogue::benchmarks::PayloadPool pool{ 
+                        dummy, rogue::benchmarks::Dummy::kIdFieldNumber, 1, spec.payloadPool };
+                    rawWrites(channel, pool, 1, insertedKeys, latch, schedule, limit, histogram);
+                    return;
+                }
+
+                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(channel) };
                 grpc::ClientContext writeContext{};
-                rogue::services::Response writeResponse{};
                 std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{ 
                     writeStub->insert(&writeContext) };
                 
-                rogue::services::Insert insert{};
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
                 insert.set_api_key(rogue::benchmarks::API_KEY);
                 insert.add_messages();
-                
-                rogue::benchmarks::Dummy dummy{};
-                dummy.set_field1(rogue::benchmarks::BYTES_50);
-                dummy.set_field2(rogue::benchmarks::BYTES_50);
-                dummy.set_field3(rogue::benchmarks::BYTES_50);
-                dummy.set_field4(rogue::benchmarks::BYTES_50);
-                dummy.set_field5(rogue::benchmarks::BYTES_50);
-                dummy.set_field6(rogue::benchmarks::BYTES_50);
-                dummy.set_field7(rogue::benchmarks::BYTES_50);
-                dummy.set_field8(rogue::benchmarks::BYTES_50);
-                dummy.set_field9(rogue::benchmarks::BYTES_50);
-                dummy.set_field10(rogue::benchmarks::BYTES_50);
 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, "General Read:Write 50:50 writes" };
                 latch.wait();
-                const uint64_t adjusted{ rogue::benchmarks::STARTING_DATA + (temp * operationsPerThread) };
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
+                schedule.start();
+                limit.start();
+                for(uint64_t count{ 0 }; limit.running(count); ++count)
                 {
-                    dummy.set_id(count + adjusted);
-                    insert.mutable_messages(0)->PackFrom(dummy);
+                    steady.building();
+                    dummy.set_id(insertedKeys.fetch_add(1, std::memory_order_relaxed));
+                    rogue::benchmarks::repack(*insert.mutable_messages(0), dummy);
+                    // Insert sends no response. Latency is from the intended send time until
+                    // the stream accepts the write.
+                    steady.built();
+                    const auto sent{ schedule.next() };
                     if(!stream->Write(insert))
                     {
                         grpc::Status status{ stream->Finish() };
                         std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
                         throw std::runtime_error{"Could not recover."};
                     }
+                    histogram.record(sent, std::chrono::steady_clock::now());
                 }
+                steady.finish();
                 stream->WritesDone();
                 std::cout << "finished writes" << std::endl;
             });
@@ -246,67 +447,83 @@ void generalEvenSplit(const std::string& ipAddress)
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
     latch.count_down();
-    rogue::benchmarks::threadpool.wait();
+    rogue::benchmarks::executor().wait();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
 
-    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, 
-        "General Read:Write 50:50", start, finish, 
-        operationsPerThread * rogue::benchmarks::TOTAL_WORKERS / 2, 
-        operationsPerThread * rogue::benchmarks::TOTAL_WORKERS / 2);
+    return rogue::benchmarks::Measurement{ start, finish, 
+        rogue::benchmarks::countOperations(histograms, 0, spec.workers / 2), 
+        rogue::benchmarks::countOperations(histograms, spec.workers / 2, spec.workers),
+        rogue::benchmarks::mergeHistograms(histograms), usage };
 }
 
-void readOnlyBulk(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement readOnlyBulk(
+    const rogue::benchmarks::WorkloadSpec& spec, 
+    const uint64_t batchSize, 
+    const rogue::benchmarks::LoadMode& load,
+    rogue::benchmarks::TimeSeries& series)
 {
-    subscribe(ipAddress);
-    initialData(ipAddress);
+    subscribe(spec);
+    initialData(spec);
     std::this_thread::sleep_for(std::chrono::seconds(5));
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
     std::latch latch{ 1 };
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / rogue::benchmarks::TOTAL_WORKERS };
+    const std::vector<std::shared_ptr<grpc::Channel>> channels{ workerChannels(spec, "dummy") };
+    const uint64_t operationsPerThread{ spec.operationCount / spec.workers };
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(spec.workers);
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    series.attachAll(histograms);
     
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
-    
+                const std::shared_ptr<grpc::Channel>& channel{ channels[temp] };
+
+                rogue::utilities::KeyBuffer keys{ 
+                    rogue::utilities::makeKeyGenerator(spec.keys, insertedKeys), spec.seedFor(temp) };
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[temp] };
+                rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread / batchSize + 1 };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, batchSize, spec.seedFor(temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
+
+                if(spec.preparedSearch)
+                {
+                    preparedReads(channel, batchSize, keys, latch, schedule, limit, timestamps, histogram);
+                    return;
+                }
+
+                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(channel) };
                 grpc::ClientContext readerContext{};
                 std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
                     readerStub->search(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
                 
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                for(uint32_t count{ 0 }; count < batchSize; ++count)
-                {
-                    rogue::services::Query* query{ search.add_queries() };
-                    rogue::services::Basic& expression{ *query->mutable_basic() };
-                    expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                    expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                    expression.add_operands();
-                }
-    
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+                addPointQueries(search, batchSize);
                 rogue::benchmarks::Dummy dummy{};
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
                 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, std::format("Read Only Bulk {} searches", batchSize) };
                 latch.wait();
+                schedule.start();
+                limit.start();
 
                 std::thread consumer{
-                    [&stream]()
+                    [&stream, &timestamps, &histogram, batchSize]()
                     {
-                        rogue::services::Response readResponse{};
+                        rogue::benchmarks::pinToGrpcCores();
+                        rogue::benchmarks::FinishedTracker tracker{ timestamps, histogram, batchSize };
+                        rogue::benchmarks::MessageArena arena{};
+                        rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
                         while(stream->Read(&readResponse))
-                        {}
+                        {
+                            tracker.finished(readResponse.finished_size());
+                        }
                         grpc::Status status{ stream->Finish() };
                         if(!status.ok())
                         {
@@ -315,17 +532,22 @@ void readOnlyBulk(const std::string& ipAddress, const uint64_t batchSize)
                         }
                     }
                 };
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                for(uint64_t count{ 0 }, batch{ 0 }; limit.running(count); ++batch)
                 {
+                    steady.building();
                     for(uint64_t inner{ 0 }; inner < batchSize; ++inner, ++count)
                     {
-                        dummy.set_id(zipfianGenerator());
-                        search.mutable_queries(inner)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+                        dummy.set_id(keys.next());
+                        rogue::benchmarks::repack(*search.mutable_queries(inner)->mutable_basic()->mutable_operands(0), dummy);
                     }
 
+                    steady.built();
+                    timestamps.sent(batch, schedule.next());
+                    histogram.issued(batchSize);
                     stream->Write(search);
                 }
 
+                steady.finish();
                 stream->WritesDone();
                 std::cout << "finished searches" << std::endl;
                 consumer.join();
@@ -334,51 +556,62 @@ void readOnlyBulk(const std::string& ipAddress, const uint64_t batchSize)
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
     latch.count_down();
-    rogue::benchmarks::threadpool.wait();
+    rogue::benchmarks::executor().wait();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
 
-    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, std::format("Read Only Bulk {}", batchSize), start, finish, operationsPerThread * rogue::benchmarks::TOTAL_WORKERS, 0);
+    return rogue::benchmarks::Measurement{ start, finish, 
+        rogue::benchmarks::countOperations(histograms, 0, spec.workers), 0, rogue::benchmarks::mergeHistograms(histograms), usage };
 }
 
-void writeOnlyBulk(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement writeOnlyBulk(
+    const rogue::benchmarks::WorkloadSpec& spec, 
+    const uint64_t batchSize, 
+    const rogue::benchmarks::LoadMode& load,
+    rogue::benchmarks::TimeSeries& series)
 {
-    subscribe(ipAddress);
-    initialData(ipAddress);
+    subscribe(spec);
+    initialData(spec);
     std::this_thread::sleep_for(std::chrono::seconds(5));
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
     std::latch latch{ 1 };
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / rogue::benchmarks::TOTAL_WORKERS };
+    const std::vector<std::shared_ptr<grpc::Channel>> channels{ workerChannels(spec, "dummy") };
+    const uint64_t operationsPerThread{ spec.operationCount / spec.workers };
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(spec.workers);
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    series.attachAll(histograms);
     
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                const std::shared_ptr<grpc::Channel>& channel{ channels[temp] };
+                
+                rogue::benchmarks::Dummy dummy{};
+                rogue::benchmarks::fillFields(dummy, spec);
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[temp] };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, batchSize, spec.seedFor(temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
 
+                if(spec.payloadPool > 0)
+                {
+                    rogue::benchmarks::PayloadPool pool{ dummy, rogue::benchmarks::Dummy::kIdFieldNumber, batchSize, spec.payloadPool };
+                    rawWrites(channel, pool, batchSize, insertedKeys, latch, schedule, limit, histogram);
+                    return;
+                }
+
+                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(channel) };
                 grpc::ClientContext writeContext{};
                 std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{ 
                     writeStub->insert(&writeContext) };
-                
-                rogue::benchmarks::Dummy dummy{};
-                dummy.set_field1(rogue::benchmarks::BYTES_50);
-                dummy.set_field2(rogue::benchmarks::BYTES_50);
-                dummy.set_field3(rogue::benchmarks::BYTES_50);
-                dummy.set_field4(rogue::benchmarks::BYTES_50);
-                dummy.set_field5(rogue::benchmarks::BYTES_50);
-                dummy.set_field6(rogue::benchmarks::BYTES_50);
-                dummy.set_field7(rogue::benchmarks::BYTES_50);
-                dummy.set_field8(rogue::benchmarks::BYTES_50);
-                dummy.set_field9(rogue::benchmarks::BYTES_50);
-                dummy.set_field10(rogue::benchmarks::BYTES_50);
-
-                rogue::services::Insert insert{};
+
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
                 insert.set_api_key(rogue::benchmarks::API_KEY);
                 insert.mutable_messages()->Reserve(batchSize);
                 for(uint64_t index{ 0 }; index < batchSize; ++index)
@@ -386,23 +619,31 @@ void writeOnlyBulk(const std::string& ipAddress, const uint64_t batchSize)
                     insert.add_messages();
                 }
 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, std::format("Write Only Bulk {} writes", batchSize) };
                 latch.wait();
-                const uint64_t adjusted{ rogue::benchmarks::STARTING_DATA + (operationsPerThread * temp) };
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                schedule.start();
+                limit.start();
+                for(uint64_t count{ 0 }; limit.running(count);)
                 {
+                    steady.building();
+                    const uint64_t first{ insertedKeys.fetch_add(batchSize, std::memory_order_relaxed) };
                     for(uint64_t index{ 0 }; index < batchSize; ++index, ++count)
                     {
-                        dummy.set_id(count + adjusted);
-                        insert.mutable_messages(index)->PackFrom(dummy);
+                        dummy.set_id(first + index);
+                        rogue::benchmarks::repack(*insert.mutable_messages(index), dummy);
                     }
 
+                    steady.built();
+                    const auto sent{ schedule.next() };
                     if(!stream->Write(insert))
                     {
                         grpc::Status status{ stream->Finish() };
                         std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
                         throw std::runtime_error{"Could not recover."};
                     }
+                    histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
                 }
+                steady.finish();
                 stream->WritesDone();
                 std::cout << "finished writes" << std::endl;
             });
@@ -410,124 +651,331 @@ void writeOnlyBulk(const std::string& ipAddress, const uint64_t batchSize)
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
     latch.count_down();
-    rogue::benchmarks::threadpool.wait();
+    rogue::benchmarks::executor().wait();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
 
-    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, std::format("Write Only Bulk {}", batchSize), start, finish, 0, rogue::benchmarks::TOTAL_OPERATIONS);
+    return rogue::benchmarks::Measurement{ start, finish, 
+        0, rogue::benchmarks::countOperations(histograms, 0, spec.workers), rogue::benchmarks::mergeHistograms(histograms), usage };
+}
+
+// One stub per streamsperchannel streams. Distinct channel arguments keep gRPC from
+// sharing a single connection between the stubs.
+std::vector<std::unique_ptr<rogue::services::RogueDB::Stub>> streamStubs(const rogue::benchmarks::WorkloadSpec& spec)
+{
+    std::vector<std::unique_ptr<rogue::services::RogueDB::Stub>> stubs{};
+    for(uint64_t index{ 0 }; index < (spec.streams + spec.streamsPerChannel - 1) / spec.streamsPerChannel; ++index)
+    {
+        grpc::ChannelArguments arguments{};
+        arguments.SetInt("dummy", index);
+        stubs.push_back(rogue::services::RogueDB::NewStub(
+            grpc::CreateCustomChannel(
+                std::format("{}:80", spec.address), 
+                grpc::InsecureChannelCredentials(),
+                arguments)));
+    }
+    return stubs;
 }
 
-void readWriteBulk(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement asyncReadBulk(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t batchSize, rogue::benchmarks::TimeSeries& series)
 {
-    subscribe(ipAddress);
-    initialData(ipAddress);
+    subscribe(spec);
+    initialData(spec);
     std::this_thread::sleep_for(std::chrono::seconds(5));
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
+    const std::vector<std::unique_ptr<rogue::services::RogueDB::Stub>> stubs{ streamStubs(spec) };
 
-    std::latch latch{ 1 };
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / rogue::benchmarks::TOTAL_WORKERS };
+    std::vector<rogue::utilities::KeyBuffer> keys{};
+    keys.reserve(spec.streams);
+    for(uint64_t index{ 0 }; index < spec.streams; ++index)
+    {
+        keys.emplace_back(rogue::utilities::makeKeyGenerator(spec.keys, insertedKeys), spec.seedFor(index));
+    }
+
+    using Engine = rogue::benchmarks::StreamEngine<rogue::services::Search>;
+    Engine engine{ 
+        spec, 
+        Engine::Options{ spec.streams, spec.pollers, spec.operationCount / spec.streams, batchSize, spec.window, true },
+        [&](grpc::ClientContext* context, grpc::CompletionQueue* queue, const uint64_t stream)
+        {
+            return stubs[stream / spec.streamsPerChannel]->PrepareAsyncsearch(context, queue);
+        },
+        pointSearches(batchSize, keys) };
 
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 2; ++index)
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    engine.attach(series);
+
+    const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
+    engine.run();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
+    const auto finish{ std::chrono::high_resolution_clock::now() };
+    if(engine.errors() > 0)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        throw std::runtime_error{"Could not recover."};
+    }
+
+    const rogue::benchmarks::LatencyHistogram histogram{ engine.histogram() };
+    return rogue::benchmarks::Measurement{ start, finish, histogram.count(), 0, histogram, usage };
+}
+
+rogue::benchmarks::Measurement asyncWriteBulk(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t batchSize, rogue::benchmarks::TimeSeries& series)
+{
+    subscribe(spec);
+    initialData(spec);
+    std::this_thread::sleep_for(std::chrono::seconds(5));
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
+    const std::vector<std::unique_ptr<rogue::services::RogueDB::Stub>> stubs{ streamStubs(spec) };
+    const uint64_t operationsPerStream{ spec.operationCount / spec.streams };
+
+    rogue::benchmarks::Dummy payload{};
+    rogue::benchmarks::fillFields(payload, spec);
+    std::vector<rogue::benchmarks::Dummy> dummies(spec.streams, payload);
+
+    using Engine = rogue::benchmarks::StreamEngine<rogue::services::Insert>;
+    Engine engine{ 
+        spec, 
+        Engine::Options{ spec.streams, spec.pollers, operationsPerStream, batchSize, spec.window, false },
+        [&](grpc::ClientContext* context, grpc::CompletionQueue* queue, const uint64_t stream)
+        {
+            return stubs[stream / spec.streamsPerChannel]->PrepareAsyncinsert(context, queue);
+        },
+        [&](rogue::services::Insert& insert, const uint64_t stream)
+        {
+            if(insert.messages_size() == 0)
+            {
+                insert.set_api_key(rogue::benchmarks::API_KEY);
+                insert.mutable_messages()->Reserve(batchSize);
+                for(uint64_t index{ 0 }; index < batchSize; ++index)
+                {
+                    insert.add_messages();
+                }
+            }
+
+            const uint64_t first{ insertedKeys.fetch_add(batchSize, std::memory_order_relaxed) };
+            for(uint64_t index{ 0 }; index < batchSize; ++index)
+            {
+                dummies[stream].set_id(first + index);
+                rogue::benchmarks::repack(*insert.mutable_messages(index), dummies[stream]);
+            }
+        } };
+
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    engine.attach(series);
+
+    const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
+    engine.run();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
+    const auto finish{ std::chrono::high_resolution_clock::now() };
+    if(engine.errors() > 0)
+    {
+        throw std::runtime_error{"Could not recover."};
+    }
+
+    const rogue::benchmarks::LatencyHistogram histogram{ engine.histogram() };
+    return rogue::benchmarks::Measurement{ start, finish, 0, histogram.count(), histogram, usage };
+}
+
+// readStreams search streams next to writeStreams insert streams, with the requests of
+// asyncReadBulk and asyncWriteBulk, all driven in the given client style. Mixed runs split
+// the pollers between the two so neither waits for executor threads.
+rogue::benchmarks::Measurement clientStyleBulk(
+    const rogue::benchmarks::WorkloadSpec& spec, 
+    const rogue::benchmarks::ClientStyle style,
+    const uint64_t batchSize,
+    const uint64_t readStreams,
+    const uint64_t writeStreams,
+    rogue::benchmarks::TimeSeries& series)
+{
+    subscribe(spec);
+    initialData(spec);
+    std::this_thread::sleep_for(std::chrono::seconds(5));
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
+    const std::vector<std::unique_ptr<rogue::services::RogueDB::Stub>> stubs{ streamStubs(spec) };
+    const uint64_t operationsPerStream{ spec.operationCount / spec.streams };
+    const uint64_t pollers{ readStreams > 0 && writeStreams > 0 ? std::max<uint64_t>(spec.pollers / 2, 1) : spec.pollers };
+    // Insert streams come after the search streams on the channels.
+    const auto stub = [&](const uint64_t stream){ return stubs[stream / spec.streamsPerChannel].get(); };
+
+    std::vector<rogue::utilities::KeyBuffer> keys{};
+    keys.reserve(readStreams);
+    for(uint64_t index{ 0 }; index < readStreams; ++index)
+    {
+        keys.emplace_back(rogue::utilities::makeKeyGenerator(spec.keys, insertedKeys), spec.seedFor(index));
+    }
+
+    using Reader = rogue::benchmarks::ClientStyleRunner<rogue::services::Search>;
+    Reader reader{ 
+        spec, 
+        Reader::Engine::Options{ readStreams, pollers, operationsPerStream, batchSize, spec.window, true },
+        style,
+        rogue::benchmarks::ClientCalls<rogue::services::Search>{
+            [&](grpc::ClientContext* context, const uint64_t stream){ return stub(stream)->search(context); },
+            [&](grpc::ClientContext* context, auto* reactor, const uint64_t stream){ stub(stream)->async()->search(context, reactor); },
+            [&](grpc::ClientContext* context, grpc::CompletionQueue* queue, const uint64_t stream){ return stub(stream)->PrepareAsyncsearch(context, queue); } },
+        pointSearches(batchSize, keys) };
+
+    rogue::benchmarks::Dummy payload{};
+    rogue::benchmarks::fillFields(payload, spec);
+    std::vector<rogue::benchmarks::Dummy> dummies(writeStreams, payload);
+    using Writer = rogue::benchmarks::ClientStyleRunner<rogue::services::Insert>;
+    Writer writer{ 
+        spec, 
+        Writer::Engine::Options{ writeStreams, pollers, operationsPerStream, batchSize, spec.window, false },
+        style,
+        rogue::benchmarks::ClientCalls<rogue::services::Insert>{
+            [&](grpc::ClientContext* context, const uint64_t stream){ return stub(readStreams + stream)->insert(context); },
+            [&](grpc::ClientContext* context, auto* reactor, const uint64_t stream){ stub(readStreams + stream)->async()->insert(context, reactor); },
+            [&](grpc::ClientContext* context, grpc::CompletionQueue* queue, const uint64_t stream){ return stub(readStreams + stream)->PrepareAsyncinsert(context, queue); } },
+        [&](rogue::services::Insert& insert, const uint64_t stream)
+        {
+            if(insert.messages_size() == 0)
+            {
+                insert.set_api_key(rogue::benchmarks::API_KEY);
+                insert.mutable_messages()->Reserve(batchSize);
+                for(uint64_t index{ 0 }; index < batchSize; ++index)
+                {
+                    insert.add_messages();
+                }
+            }
+
+            const uint64_t first{ insertedKeys.fetch_add(batchSize, std::memory_order_relaxed) };
+            for(uint64_t index{ 0 }; index < batchSize; ++index)
+            {
+                dummies[stream].set_id(first + index);
+                rogue::benchmarks::repack(*insert.mutable_messages(index), dummies[stream]);
+            }
+        } };
+
+    reader.attach(series);
+    writer.attach(series);
+
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    const auto start{ std::chrono::high_resolution_clock::now() };
+    counters.start();
+    series.start();
+    std::thread writing{ [&](){ writer.run(); } };
+    reader.run();
+    writing.join();
+    series.stop();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    const auto finish{ std::chrono::high_resolution_clock::now() };
+    if(reader.errors() + writer.errors() > 0)
+    {
+        throw std::runtime_error{"Could not recover."};
+    }
+
+    rogue::benchmarks::LatencyHistogram histogram{ reader.histogram() };
+    histogram.merge(writer.histogram());
+    return rogue::benchmarks::Measurement{ start, finish, reader.histogram().count(), writer.histogram().count(), histogram, usage };
+}
+
+void readWriteBulk(const rogue::benchmarks::WorkloadSpec& spec, const uint64_t batchSize)
+{
+    subscribe(spec);
+    initialData(spec);
+    std::this_thread::sleep_for(std::chrono::seconds(5));
+    std::atomic<uint64_t> insertedKeys{ spec.recordCount };
+
+    std::latch latch{ 1 };
+    const std::vector<std::shared_ptr<grpc::Channel>> channels{ workerChannels(spec, "dummy") };
+    const uint64_t operationsPerThread{ spec.operationCount / spec.workers };
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(spec.workers);
+    rogue::benchmarks::TimeSeries series{ spec.reportInterval };
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    series.attachAll(histograms);
+
+    for(uint64_t index{ 0 }; index < spec.workers / 2; ++index)
+    {
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(channels[temp]) };
 
                 grpc::ClientContext writeContext{};
                 std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{ 
                     writeStub->insert(&writeContext) };
                 
                 rogue::benchmarks::Dummy dummy{};
-                dummy.set_field1(rogue::benchmarks::BYTES_50);
-                dummy.set_field2(rogue::benchmarks::BYTES_50);
-                dummy.set_field3(rogue::benchmarks::BYTES_50);
-                dummy.set_field4(rogue::benchmarks::BYTES_50);
-                dummy.set_field5(rogue::benchmarks::BYTES_50);
-                dummy.set_field6(rogue::benchmarks::BYTES_50);
-                dummy.set_field7(rogue::benchmarks::BYTES_50);
-                dummy.set_field8(rogue::benchmarks::BYTES_50);
-                dummy.set_field9(rogue::benchmarks::BYTES_50);
-                dummy.set_field10(rogue::benchmarks::BYTES_50);
-
-                rogue::services::Insert insert{};
+                rogue::benchmarks::fillFields(dummy, spec);
+
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
                 insert.set_api_key(rogue::benchmarks::API_KEY);
                 insert.mutable_messages()->Reserve(operationsPerThread);
                 for(uint64_t index{ 0 }; index < operationsPerThread; ++index)
                 {
                     insert.add_messages();
                 }
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[temp] };
 
                 latch.wait();
-                const uint64_t adjusted{ rogue::benchmarks::STARTING_DATA + (operationsPerThread * temp) };
                 for(uint64_t count{ 0 }; count < operationsPerThread;)
                 {
+                    const uint64_t first{ insertedKeys.fetch_add(batchSize, std::memory_order_relaxed) };
                     for(uint64_t index{ 0 }; index < batchSize; ++index, ++count)
                     {
-                        dummy.set_id(count + adjusted);
-                        insert.mutable_messages(index)->PackFrom(dummy);
+                        dummy.set_id(first + index);
+                        rogue::benchmarks::repack(*insert.mutable_messages(index), dummy);
                     }
 
+                    const auto sent{ std::chrono::steady_clock::now() };
                     if(!stream->Write(insert))
                     {
                         grpc::Status status{ stream->Finish() };
                         std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
                         throw std::runtime_error{"Could not recover."};
                     }
+                    histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
                 }
                 stream->WritesDone();
                 std::cout << "finished writes" << std::endl;
             });
     }
 
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 2; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers / 2; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(channels[temp]) };
                 
                 grpc::ClientContext readerContext{};
                 std::shared_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
                     readerStub->search(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
-                
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
                 
-                for(uint64_t count{ 0 }; count < operationsPerThread; ++count)
-                {
-                    rogue::services::Query* query{ search.add_queries() };
-                    rogue::services::Basic& expression{ *query->mutable_basic() };
-                    expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                    expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                    expression.add_operands();
-                }
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+                addPointQueries(search, operationsPerThread);
 
                 rogue::benchmarks::Dummy dummy{};
                 
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
+                rogue::utilities::KeyBuffer keys{ 
+                    rogue::utilities::makeKeyGenerator(spec.keys, insertedKeys), spec.seedFor((spec.workers / 2) + temp) };
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[(spec.workers / 2) + temp] };
+                rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread / batchSize + 1 };
                 
                 latch.wait();
                 std::thread consumer{
-                    [&stream]()
+                    [&stream, &timestamps, &histogram, batchSize]()
                     {
-                        rogue::services::Response readResponse{};
+                        rogue::benchmarks::pinToGrpcCores();
+                        rogue::benchmarks::FinishedTracker tracker{ timestamps, histogram, batchSize };
+                        rogue::benchmarks::MessageArena arena{};
+                        rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
                         while(stream->Read(&readResponse))
-                        {}
+                        {
+                            tracker.finished(readResponse.finished_size());
+                        }
                         grpc::Status status{ stream->Finish() };
                         if(!status.ok())
                         {
@@ -537,14 +985,16 @@ void readWriteBulk(const std::string& ipAddress, const uint64_t batchSize)
                     }
                 };
 
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                for(uint64_t count{ 0 }, batch{ 0 }; count < operationsPerThread; ++batch)
                 {
                     for(uint64_t inner{ 0 }; inner < batchSize; ++inner, ++count)
                     {
-                        dummy.set_id(zipfianGenerator());
-                        search.mutable_queries(inner)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+                        dummy.set_id(keys.next());
+                        rogue::benchmarks::repack(*search.mutable_queries(inner)->mutable_basic()->mutable_operands(0), dummy);
                     }
 
+                    timestamps.sent(batch);
+                    histogram.issued(batchSize);
                     stream->Write(search);
                 }
 
@@ -556,52 +1006,68 @@ void readWriteBulk(const std::string& ipAddress, const uint64_t batchSize)
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
     latch.count_down();
-    rogue::benchmarks::threadpool.wait();
+    rogue::benchmarks::executor().wait();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
 
-    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, "Even Batch Split", start, finish, operationsPerThread * rogue::benchmarks::TOTAL_WORKERS, operationsPerThread * rogue::benchmarks::TOTAL_WORKERS);
+    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, "Even Batch Split", start, finish, 
+        operationsPerThread * spec.workers, operationsPerThread * spec.workers,
+        rogue::benchmarks::mergeHistograms(histograms), &series, &usage);
 }
 
-void dualMessageBulk(const std::string& ipAddress, const uint64_t batchSize)
+rogue::benchmarks::Measurement dualMessageBulk(
+    const rogue::benchmarks::WorkloadSpec& spec, 
+    const uint64_t batchSize, 
+    const rogue::benchmarks::LoadMode& load,
+    rogue::benchmarks::TimeSeries& series)
 {
-    subscribe(ipAddress);
-    initialData(ipAddress);
+    subscribe(spec);
+    initialData(spec);
     std::this_thread::sleep_for(std::chrono::seconds(5));
+    // Each type has its own ids, so latest reads of either follow the inserts of that type.
+    std::atomic<uint64_t> insertedDummies{ spec.recordCount };
+    std::atomic<uint64_t> insertedTests{ spec.recordCount };
 
     std::latch latch{ 1 };
-    const uint64_t operationsPerThread{ rogue::benchmarks::TOTAL_OPERATIONS / rogue::benchmarks::TOTAL_WORKERS };
-
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 4; ++index)
+    const std::vector<std::shared_ptr<grpc::Channel>> channels{ workerChannels(spec, "dummy") };
+    const std::vector<std::shared_ptr<grpc::Channel>> testChannels{ workerChannels(spec, "test") };
+    const uint64_t operationsPerThread{ spec.operationCount / spec.workers };
+    const uint64_t groupSize{ spec.workers / 4 };
+    std::vector<rogue::benchmarks::LatencyHistogram> histograms(spec.workers);
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    series.attachAll(histograms);
+
+    for(uint64_t index{ 0 }; index < spec.workers / 4; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                const std::shared_ptr<grpc::Channel>& channel{ channels[temp] };
+                
+                rogue::benchmarks::Dummy dummy{};
+                rogue::benchmarks::fillFields(dummy, spec);
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[temp] };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, batchSize, spec.seedFor(temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
 
+                if(spec.payloadPool > 0)
+                {
+                    rogue::benchmarks::PayloadPool pool{ dummy, rogue::benchmarks::Dummy::kIdFieldNumber, batchSize, spec.payloadPool };
+                    rawWrites(channel, pool, batchSize, insertedDummies, latch, schedule, limit, histogram);
+                    return;
+                }
+
+                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(channel) };
                 grpc::ClientContext writeContext{};
                 std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{ 
                     writeStub->insert(&writeContext) };
-                
-                rogue::benchmarks::Dummy dummy{};
-                dummy.set_field1(rogue::benchmarks::BYTES_50);
-                dummy.set_field2(rogue::benchmarks::BYTES_50);
-                dummy.set_field3(rogue::benchmarks::BYTES_50);
-                dummy.set_field4(rogue::benchmarks::BYTES_50);
-                dummy.set_field5(rogue::benchmarks::BYTES_50);
-                dummy.set_field6(rogue::benchmarks::BYTES_50);
-                dummy.set_field7(rogue::benchmarks::BYTES_50);
-                dummy.set_field8(rogue::benchmarks::BYTES_50);
-                dummy.set_field9(rogue::benchmarks::BYTES_50);
-                dummy.set_field10(rogue::benchmarks::BYTES_50);
-
-                rogue::services::Insert insert{};
+
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
                 insert.set_api_key(rogue::benchmarks::API_KEY);
                 insert.mutable_messages()->Reserve(batchSize);
                 for(uint64_t index{ 0 }; index < batchSize; ++index)
@@ -609,51 +1075,65 @@ void dualMessageBulk(const std::string& ipAddress, const uint64_t batchSize)
                     insert.add_messages();
                 }
 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, std::format("Dual Message Bulk {} Dummy writes", batchSize) };
                 latch.wait();
-                const uint64_t adjusted{ rogue::benchmarks::STARTING_DATA + (temp * operationsPerThread) };
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                schedule.start();
+                limit.start();
+                for(uint64_t count{ 0 }; limit.running(count);)
                 {
+                    steady.building();
+                    const uint64_t first{ insertedDummies.fetch_add(batchSize, std::memory_order_relaxed) };
                     for(uint64_t index{ 0 }; index < batchSize; ++index, ++count)
                     {
-                        dummy.set_id(count + adjusted);
-                        insert.mutable_messages(index)->PackFrom(dummy);
+                        dummy.set_id(first + index);
+                        rogue::benchmarks::repack(*insert.mutable_messages(index), dummy);
                     }
 
+                    steady.built();
+                    const auto sent{ schedule.next() };
                     if(!stream->Write(insert))
                     {
                         grpc::Status status{ stream->Finish() };
                         std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
                         throw std::runtime_error{"Could not recover."};
                     }
+                    histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
                 }
+                steady.finish();
                 stream->WritesDone();
                 std::cout << "finished writes" << std::endl;
             });
     }
 
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 4; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers / 4; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("test", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
-
-                grpc::ClientContext writeContext{};
-                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{ 
-                    writeStub->insert(&writeContext) };
+                const std::shared_ptr<grpc::Channel>& channel{ testChannels[temp] };
                 
                 rogue::utilities::Test dummy{};
                 dummy.set_attribute1(0);
                 dummy.set_attribute2(0);
                 dummy.set_attribute3(false);
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[groupSize + temp] };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, batchSize, spec.seedFor(groupSize + temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
+
+                if(spec.payloadPool > 0)
+                {
+                    rogue::benchmarks::PayloadPool pool{ dummy, rogue::utilities::Test::kAttribute1FieldNumber, batchSize, spec.payloadPool };
+                    rawWrites(channel, pool, batchSize, insertedTests, latch, schedule, limit, histogram);
+                    return;
+                }
 
-                rogue::services::Insert insert{};
+                std::unique_ptr<rogue::services::RogueDB::Stub> writeStub{ rogue::services::RogueDB::NewStub(channel) };
+                grpc::ClientContext writeContext{};
+                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> stream{ 
+                    writeStub->insert(&writeContext) };
+
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
                 insert.set_api_key(rogue::benchmarks::API_KEY);
                 insert.mutable_messages()->Reserve(batchSize);
                 for(uint64_t index{ 0 }; index < batchSize; ++index)
@@ -661,71 +1141,75 @@ void dualMessageBulk(const std::string& ipAddress, const uint64_t batchSize)
                     insert.add_messages();
                 }
 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, std::format("Dual Message Bulk {} Test writes", batchSize) };
                 latch.wait();
-                const uint64_t adjusted{ rogue::benchmarks::STARTING_DATA + (temp * operationsPerThread) };
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                schedule.start();
+                limit.start();
+                for(uint64_t count{ 0 }; limit.running(count);)
                 {
+                    steady.building();
+                    const uint64_t first{ insertedTests.fetch_add(batchSize, std::memory_order_relaxed) };
                     for(uint64_t index{ 0 }; index < batchSize; ++index, ++count)
                     {
-                        dummy.set_attribute1(count + adjusted);
-                        insert.mutable_messages(index)->PackFrom(dummy);
+                        dummy.set_attribute1(first + index);
+                        rogue::benchmarks::repack(*insert.mutable_messages(index), dummy);
                     }
 
+                    steady.built();
+                    const auto sent{ schedule.next() };
                     if(!stream->Write(insert))
                     {
                         grpc::Status status{ stream->Finish() };
                         std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
                         throw std::runtime_error{"Could not recover."};
                     }
+                    histogram.record(sent, std::chrono::steady_clock::now(), batchSize);
                 }
+                steady.finish();
                 stream->WritesDone();
                 std::cout << "finished writes" << std::endl;
             });
     }
     
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 4; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers / 4; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("dummy", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(channels[temp]) };
                 
                 grpc::ClientContext readerContext{};
                 std::shared_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
                     readerStub->search(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
                 
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                for(uint32_t count{ 0 }; count < batchSize; ++count)
-                {
-                    rogue::services::Query* query{ search.add_queries() };
-                    rogue::services::Basic& expression{ *query->mutable_basic() };
-                    expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                    expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                    expression.add_operands();
-                }
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+                addPointQueries(search, batchSize);
     
                 rogue::benchmarks::Dummy dummy{};
                 
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
+                rogue::utilities::KeyBuffer keys{ 
+                    rogue::utilities::makeKeyGenerator(spec.keys, insertedDummies), spec.seedFor((2 * groupSize) + temp) };
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[(2 * groupSize) + temp] };
+                rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread / batchSize + 1 };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, batchSize, spec.seedFor((2 * groupSize) + temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
                 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, std::format("Dual Message Bulk {} Dummy searches", batchSize) };
                 latch.wait();
+                schedule.start();
+                limit.start();
                 std::thread consumer{
-                    [&stream]()
+                    [&stream, &timestamps, &histogram, batchSize]()
                     {
-                        rogue::services::Response readResponse{};
+                        rogue::benchmarks::pinToGrpcCores();
+                        rogue::benchmarks::FinishedTracker tracker{ timestamps, histogram, batchSize };
+                        rogue::benchmarks::MessageArena arena{};
+                        rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
                         while(stream->Read(&readResponse))
-                        {}
+                        {
+                            tracker.finished(readResponse.finished_size());
+                        }
                         grpc::Status status{ stream->Finish() };
                         if(!status.ok())
                         {
@@ -734,67 +1218,68 @@ void dualMessageBulk(const std::string& ipAddress, const uint64_t batchSize)
                         }
                     }
                 };
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                for(uint64_t count{ 0 }, batch{ 0 }; limit.running(count); ++batch)
                 {
-                    for(uint64_t inner{ 0 }; inner < batchSize && count < operationsPerThread; ++inner, ++count)
+                    steady.building();
+                    for(uint64_t inner{ 0 }; inner < batchSize && limit.allows(count); ++inner, ++count)
                     {
-                        dummy.set_id(zipfianGenerator());
-                        search.mutable_queries(inner)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+                        dummy.set_id(keys.next());
+                        rogue::benchmarks::repack(*search.mutable_queries(inner)->mutable_basic()->mutable_operands(0), dummy);
                     }
+                    steady.built();
+                    timestamps.sent(batch, schedule.next());
+                    histogram.issued(batchSize);
                     stream->Write(search);
                 }
 
+                steady.finish();
                 stream->WritesDone();
                 consumer.join();
                 std::cout << "finished reads" << std::endl;
             });
     }
     
-    for(uint64_t index{ 0 }; index < rogue::benchmarks::TOTAL_WORKERS / 4; ++index)
+    for(uint64_t index{ 0 }; index < spec.workers / 4; ++index)
     {
-        rogue::benchmarks::threadpool.detach_task(
+        rogue::benchmarks::executor().detach_task(
             [&, temp = index]()
             {
-                grpc::ChannelArguments arguments{};
-                arguments.SetInt("test", temp);
-                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(
-                    grpc::CreateCustomChannel(
-                        std::format("{}:80", ipAddress), 
-                        grpc::InsecureChannelCredentials(),
-                        arguments)) };
+                std::unique_ptr<rogue::services::RogueDB::Stub> readerStub{ rogue::services::RogueDB::NewStub(testChannels[temp]) };
 
                 grpc::ClientContext readerContext{};
                 std::shared_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> stream{
                     readerStub->search(&readerContext) };
-                std::random_device randomizer{};
-                std::mt19937 generator{ randomizer() };
                 
-                rogue::services::Search search{};
-                search.set_api_key(rogue::benchmarks::API_KEY);
-                
-                for(uint32_t count{ 0 }; count < batchSize; ++count)
-                {
-                    rogue::services::Query* query{ search.add_queries() };
-                    rogue::services::Basic& expression{ *query->mutable_basic() };
-                    expression.set_logical_operator(rogue::services::LogicalOperator::AND);
-                    expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
-                    expression.add_operands();
-                }
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+                addPointQueries(search, batchSize);
     
                 rogue::utilities::Test dummy{};
                 dummy.set_attribute2(0);
                 dummy.set_attribute3(false);
                 
-                rogue::utilities::ZipfianGenerator zipfian{rogue::benchmarks::STARTING_DATA, .9};
-                rogue::concepts::Generator<uint64_t> zipfianGenerator{ zipfian.generate(generator) };
+                rogue::utilities::KeyBuffer keys{ 
+                    rogue::utilities::makeKeyGenerator(spec.keys, insertedTests), spec.seedFor((3 * groupSize) + temp) };
+                rogue::benchmarks::LatencyHistogram& histogram{ histograms[(3 * groupSize) + temp] };
+                rogue::benchmarks::StreamTimestamps timestamps{ operationsPerThread / batchSize + 1 };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, batchSize, spec.seedFor((3 * groupSize) + temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
                 
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, std::format("Dual Message Bulk {} Test searches", batchSize) };
                 latch.wait();
+                schedule.start();
+                limit.start();
                 std::thread consumer{
-                    [&stream]()
+                    [&stream, &timestamps, &histogram, batchSize]()
                     {
-                        rogue::services::Response readResponse{};
+                        rogue::benchmarks::pinToGrpcCores();
+                        rogue::benchmarks::FinishedTracker tracker{ timestamps, histogram, batchSize };
+                        rogue::benchmarks::MessageArena arena{};
+                        rogue::services::Response& readResponse{ arena.create<rogue::services::Response>() };
                         while(stream->Read(&readResponse))
-                        {}
+                        {
+                            tracker.finished(readResponse.finished_size());
+                        }
                         grpc::Status status{ stream->Finish() };
                         if(!status.ok())
                         {
@@ -804,16 +1289,21 @@ void dualMessageBulk(const std::string& ipAddress, const uint64_t batchSize)
                     }
                 };
 
-                for(uint64_t count{ 0 }; count < operationsPerThread;)
+                for(uint64_t count{ 0 }, batch{ 0 }; limit.running(count); ++batch)
                 {
-                    for(uint64_t inner{ 0 }; inner < batchSize && count < operationsPerThread; ++inner, ++count)
+                    steady.building();
+                    for(uint64_t inner{ 0 }; inner < batchSize && limit.allows(count); ++inner, ++count)
                     {
-                        dummy.set_attribute1(zipfianGenerator());
-                        search.mutable_queries(inner)->mutable_basic()->mutable_operands(0)->PackFrom(dummy);
+                        dummy.set_attribute1(keys.next());
+                        rogue::benchmarks::repack(*search.mutable_queries(inner)->mutable_basic()->mutable_operands(0), dummy);
                     }
+                    steady.built();
+                    timestamps.sent(batch, schedule.next());
+                    histogram.issued(batchSize);
                     stream->Write(search);
                 }
 
+                steady.finish();
                 stream->WritesDone();
                 consumer.join();
                 std::cout << "finished reads" << std::endl;
@@ -822,31 +1312,368 @@ void dualMessageBulk(const std::string& ipAddress, const uint64_t batchSize)
 
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
     const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
+    latch.count_down();
+    rogue::benchmarks::executor().wait();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
+    const auto finish{ std::chrono::high_resolution_clock::now() };
+
+    return rogue::benchmarks::Measurement{ start, finish, 
+        rogue::benchmarks::countOperations(histograms, 2 * groupSize, 4 * groupSize), 
+        rogue::benchmarks::countOperations(histograms, 0, 2 * groupSize),
+        rogue::benchmarks::mergeHistograms(histograms), usage };
+}
+
+enum YcsbOperation : uint32_t
+{
+    READ = 0,
+    UPDATE = 1,
+    INSERT = 2,
+    READ_MODIFY_WRITE = 3,
+    YCSB_OPERATION_COUNT = 4
+};
+
+struct YcsbWorkload
+{
+    std::string id; // Selected by the workloads property of the spec.
+    std::string name;
+    std::array<double, YCSB_OPERATION_COUNT> proportions; // READ, UPDATE, INSERT, READ_MODIFY_WRITE
+    bool latest; // Request distribution skewed towards the most recent inserts, otherwise the selected one.
+};
+
+// YCSB core workloads. E (short ranges) is excluded until range scans are benchmarked.
+const std::vector<YcsbWorkload> YCSB_WORKLOADS{
+    { "a", "YCSB A Update Heavy", { .5, .5, 0, 0 }, false },
+    { "b", "YCSB B Read Mostly", { .95, .05, 0, 0 }, false },
+    { "c", "YCSB C Read Only", { 1, 0, 0, 0 }, false },
+    { "d", "YCSB D Read Latest", { .95, 0, .05, 0 }, true },
+    { "f", "YCSB F Read Modify Write", { .5, 0, 0, .5 }, false }
+};
+
+// Latencies of each operation type in the last run of a YCSB workload. The runner only pools
+// the overall workload, so these are logged once it is done.
+struct YcsbOperations
+{
+    std::chrono::system_clock::time_point start{};
+    std::chrono::system_clock::time_point finish{};
+    std::array<rogue::benchmarks::LatencyHistogram, YCSB_OPERATION_COUNT> latencies{};
+};
+
+rogue::benchmarks::Measurement ycsbWorkload(
+    const rogue::benchmarks::WorkloadSpec& spec, 
+    const YcsbWorkload& workload, 
+    const rogue::benchmarks::LoadMode& load,
+    YcsbOperations& operations,
+    rogue::benchmarks::TimeSeries& series)
+{
+    subscribe(spec);
+    initialData(spec);
+    std::this_thread::sleep_for(std::chrono::seconds(5));
+
+    std::latch latch{ 1 };
+    const std::vector<std::shared_ptr<grpc::Channel>> channels{ workerChannels(spec, "dummy") };
+    const uint64_t operationsPerThread{ spec.operationCount / spec.workers };
+    std::vector<std::array<rogue::benchmarks::LatencyHistogram, YCSB_OPERATION_COUNT>> histograms(
+        spec.workers);
+    rogue::benchmarks::ResourceCounters counters{ spec.hardwareCounters };
+    for(auto& histogram : histograms)
+    {
+        series.attachAll(histogram);
+    }
+    std::atomic<uint64_t> nextInsert{ spec.recordCount };
+
+    for(uint64_t index{ 0 }; index < spec.workers; ++index)
+    {
+        rogue::benchmarks::executor().detach_task(
+            [&, temp = index]()
+            {
+                std::unique_ptr<rogue::services::RogueDB::Stub> stub{ rogue::services::RogueDB::NewStub(channels[temp]) };
+
+                grpc::ClientContext searchContext{};
+                grpc::ClientContext updateContext{};
+                grpc::ClientContext insertContext{};
+                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>> searchStream{
+                    stub->search(&searchContext) };
+                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Update, rogue::services::Response>> updateStream{
+                    stub->update(&updateContext) };
+                std::unique_ptr<grpc::ClientReaderWriter<rogue::services::Insert, rogue::services::Response>> insertStream{
+                    stub->insert(&insertContext) };
+                std::mt19937 generator{ static_cast<std::mt19937::result_type>(spec.seedFor(spec.workers + temp)) };
+
+                rogue::benchmarks::MessageArena arena{};
+                rogue::services::Search& search{ arena.create<rogue::services::Search>() };
+                search.set_api_key(rogue::benchmarks::API_KEY);
+                rogue::services::Basic& expression{ *search.add_queries()->mutable_basic() };
+                expression.set_logical_operator(rogue::services::LogicalOperator::AND);
+                expression.add_comparisons(rogue::services::ComparisonOperator::EQUAL);
+                expression.add_operands();
+
+                rogue::services::Update& update{ arena.create<rogue::services::Update>() };
+                update.set_api_key(rogue::benchmarks::API_KEY);
+                update.add_messages();
+
+                rogue::services::Insert& insert{ arena.create<rogue::services::Insert>() };
+                insert.set_api_key(rogue::benchmarks::API_KEY);
+                insert.add_messages();
+
+                rogue::benchmarks::Dummy key{};
+                rogue::benchmarks::Dummy dummy{};
+                rogue::benchmarks::fillFields(dummy, spec);
+
+                std::discrete_distribution<uint32_t> operations{ 
+                    workload.proportions.begin(), workload.proportions.end() };
+                rogue::utilities::KeySelection selection{ spec.keys };
+                if(workload.latest)
+                {
+                    selection.distribution = rogue::utilities::KeyDistribution::LATEST;
+                }
+                rogue::utilities::KeyBuffer keys{ 
+                    rogue::utilities::makeKeyGenerator(selection, nextInsert), spec.seedFor(temp) };
+
+                rogue::services::Response& response{ arena.create<rogue::services::Response>() };
+                rogue::benchmarks::SteadyState steady{ spec.strictAllocations, workload.name };
+                const auto read = [&](const uint64_t id)
+                {
+                    steady.building();
+                    key.set_id(id);
+                    rogue::benchmarks::repack(*search.mutable_queries(0)->mutable_basic()->mutable_operands(0), key);
+                    steady.built();
+                    searchStream->Write(search);
+                    do
+                    {
+                        if(!searchStream->Read(&response))
+                        {
+                            grpc::Status status{ searchStream->Finish() };
+                            std::cout << "Read stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+                            throw std::runtime_error{"Could not recover."};
+                        }
+                    } while(response.finished_size() == 0);
+                };
+                const auto write = [&](auto& stream, auto& request, const uint64_t id)
+                {
+                    steady.building();
+                    dummy.set_id(id);
+                    rogue::benchmarks::repack(*request.mutable_messages(0), dummy);
+                    steady.built();
+                    if(!stream->Write(request))
+                    {
+                        grpc::Status status{ stream->Finish() };
+                        std::cout << "Write stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+                        throw std::runtime_error{"Could not recover."};
+                    }
+                };
+
+                std::array<rogue::benchmarks::LatencyHistogram, YCSB_OPERATION_COUNT>& histogram{ histograms[temp] };
+                rogue::benchmarks::ArrivalSchedule schedule{ load, spec.workers, 1, spec.seedFor(temp) };
+                rogue::benchmarks::OperationLimit limit{ spec, operationsPerThread };
+
+                latch.wait();
+                schedule.start();
+                limit.start();
+                for(uint64_t count{ 0 }; limit.running(count); ++count)
+                {
+                    const uint32_t operation{ operations(generator) };
+                    const auto sent{ schedule.next() };
+                    switch(operation)
+                    {
+                        case READ:
+                            read(keys.next());
+                            break;
+                        case UPDATE:
+                            write(updateStream, update, keys.next());
+                            break;
+                        case INSERT:
+                            write(insertStream, insert, nextInsert.fetch_add(1, std::memory_order_relaxed));
+                            break;
+                        case READ_MODIFY_WRITE:
+                        {
+                            const uint64_t id{ keys.next() };
+                            read(id);
+                            write(updateStream, update, id);
+                            break;
+                        }
+                    }
+                    histogram[operation].record(sent, std::chrono::steady_clock::now());
+                }
+
+                steady.finish();
+                searchStream->WritesDone();
+                updateStream->WritesDone();
+                insertStream->WritesDone();
+                for(grpc::Status status : { searchStream->Finish(), updateStream->Finish(), insertStream->Finish() })
+                {
+                    if(!status.ok())
+                    {
+                        std::cout << "Stream broken. Code: " << status.error_code() << ", Details: " << status.error_details() << ", Message: " << status.error_message() << std::endl;
+                        throw std::runtime_error{"Could not recover."};
+                    }
+                }
+                std::cout << "finished operations" << std::endl;
+            });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto start{ std::chrono::high_resolution_clock::now() };
+    series.start();
+    counters.start();
     latch.count_down();
-    rogue::benchmarks::threadpool.wait();
+    rogue::benchmarks::executor().wait();
+    const rogue::benchmarks::ResourceUsage usage{ counters.stop() };
+    series.stop();
     const auto finish{ std::chrono::high_resolution_clock::now() };
 
-    rogue::benchmarks::logBenchmark(BENCHMARK_FILE, 
-        std::format("Dual Message Bulk {}", batchSize), 
-        start, finish, 
-        operationsPerThread * rogue::benchmarks::TOTAL_WORKERS / 2, 
-        operationsPerThread * rogue::benchmarks::TOTAL_WORKERS / 2);
+    operations = YcsbOperations{ start, finish };
+    rogue::benchmarks::LatencyHistogram overall{};
+    uint64_t readOperations{ 0 };
+    uint64_t writeOperations{ 0 };
+    for(uint32_t operation{ 0 }; operation < YCSB_OPERATION_COUNT; ++operation)
+    {
+        rogue::benchmarks::LatencyHistogram& merged{ operations.latencies[operation] };
+        for(const auto& histogram : histograms)
+        {
+            merged.merge(histogram[operation]);
+        }
+        readOperations += operation == READ || operation == READ_MODIFY_WRITE ? merged.count() : 0;
+        writeOperations += operation == READ ? 0 : merged.count();
+        overall.merge(merged);
+    }
+    return rogue::benchmarks::Measurement{ start, finish, readOperations, writeOperations, overall, usage };
+}
+
+// One row per operation type as YCSB reports them, from the last run of the workload.
+void logOperations(const YcsbWorkload& workload, const rogue::benchmarks::LoadMode& load, const YcsbOperations& operations)
+{
+    const std::array<std::string, YCSB_OPERATION_COUNT> operationNames{ "Read", "Update", "Insert", "Read Modify Write" };
+    for(uint32_t operation{ 0 }; operation < YCSB_OPERATION_COUNT; ++operation)
+    {
+        const rogue::benchmarks::LatencyHistogram& latencies{ operations.latencies[operation] };
+        if(latencies.count() == 0)
+        {
+            continue;
+        }
+        const uint64_t reads{ operation == READ || operation == READ_MODIFY_WRITE ? latencies.count() : 0 };
+        const uint64_t writes{ operation == READ ? 0 : latencies.count() };
+        rogue::benchmarks::logBenchmark(BENCHMARK_FILE, 
+            load.label(std::format("{} - {}", workload.name, operationNames[operation])), 
+            operations.start, operations.finish, reads, writes, latencies);
+    }
 }
 
 int main(int argc, char** argv)
 {
+    rogue::benchmarks::WorkloadSpec spec{};
+    try
+    {
+        spec = rogue::benchmarks::parseWorkloadSpec(argc, argv);
+    }
+    catch(const std::invalid_argument& error)
+    {
+        std::cerr << error.what() << std::endl << rogue::benchmarks::workloadUsage(argv[0]);
+        return 1;
+    }
+    rogue::benchmarks::configureExecutor(spec);
+    rogue::benchmarks::describeRun(spec);
+
     std::filesystem::remove(BENCHMARK_FILE);
+    std::filesystem::remove(rogue::benchmarks::repetitionsFile(BENCHMARK_FILE));
+    std::filesystem::remove(rogue::benchmarks::resourcesFile(BENCHMARK_FILE));
     rogue::benchmarks::initialLog(BENCHMARK_FILE);
-    const std::string ipAddress{ argv[1] };
+    rogue::benchmarks::writeWorkloadSpec(SPEC_FILE, spec);
+
+    // Every configuration goes through the runner, so warm-up and repetitions apply as in
+    // grpc_benchmarks. Each run loads its initial data again, outside its measured part.
+    const auto measure = [&](const std::string& benchmark, const auto& run)
+    {
+        return rogue::benchmarks::repeat(spec, BENCHMARK_FILE, benchmark, run);
+    };
+
+    // Open-loop sweep (arrival = fixed | poisson): each workload first runs closed-loop to find
+    // its saturation throughput. It then gets re-run at a constant arrival rate of each of the
+    // saturation fractions of that throughput.
+    const auto sweep = [&](const std::function<double(const rogue::benchmarks::LoadMode&)>& workload)
+    {
+        const double saturation{ workload(rogue::benchmarks::LoadMode{}) };
+        if(spec.openLoop)
+        {
+            for(const double fraction : spec.saturationFractions)
+            {
+                workload(rogue::benchmarks::LoadMode{ *spec.openLoop, saturation * fraction });
+            }
+        }
+    };
 
-    generalEvenSplit(ipAddress);
+    if(spec.runs("general"))
+    {
+        sweep([&](const auto& load){ return measure(load.label("General Read:Write 50:50"), 
+            [&](const auto& phase, auto& series){ return generalEvenSplit(phase, load, series); }); });
+    }
     
-    const std::vector<uint64_t> batchSizes{ 1, 10, 100, 1000 };
-    for(const auto& batchSize : batchSizes)
+    for(const auto& batchSize : spec.batchSizes)
+    {
+        if(spec.runs("read"))
+        {
+            sweep([&](const auto& load){ return measure(load.label(std::format("Read Only Bulk {}", batchSize)), 
+                [&](const auto& phase, auto& series){ return readOnlyBulk(phase, batchSize, load, series); }); });
+        }
+        if(spec.runs("write"))
+        {
+            sweep([&](const auto& load){ return measure(load.label(std::format("Write Only Bulk {}", batchSize)), 
+                [&](const auto& phase, auto& series){ return writeOnlyBulk(phase, batchSize, load, series); }); });
+        }
+        if(spec.runs("dual"))
+        {
+            sweep([&](const auto& load){ return measure(load.label(std::format("Dual Message Bulk {}", batchSize)), 
+                [&](const auto& phase, auto& series){ return dualMessageBulk(phase, batchSize, load, series); }); });
+        }
+        // Closed-loop only: the stream count and window set the load.
+        if(spec.runs("async-read"))
+        {
+            measure(std::format("Async Read Bulk {} ({} Streams, {} Pollers)", batchSize, spec.streams, spec.pollers), 
+                [&](const auto& phase, auto& series){ return asyncReadBulk(phase, batchSize, series); });
+        }
+        if(spec.runs("async-write"))
+        {
+            measure(std::format("Async Write Bulk {} ({} Streams, {} Pollers)", batchSize, spec.streams, spec.pollers), 
+                [&](const auto& phase, auto& series){ return asyncWriteBulk(phase, batchSize, series); });
+        }
+        for(const std::string& name : spec.clientStyles)
+        {
+            const rogue::benchmarks::ClientStyle style{ rogue::benchmarks::parseClientStyle(name) };
+            const uint64_t streams{ rogue::benchmarks::styleStreams(style, spec.streams, spec.pollers) };
+            const std::array<std::pair<std::string, uint64_t>, 3> workloads{ {
+                { "Read Only", spec.streams }, { "Write Only", 0 }, { "Mixed", spec.streams / 2 } } };
+            for(const auto& [workload, readStreams] : workloads)
+            {
+                measure(std::format("{} {} Bulk {} ({} Streams)", rogue::benchmarks::clientStyleName(style), workload, batchSize, streams), 
+                    [&](const auto& phase, auto& series){ return clientStyleBulk(phase, style, batchSize, readStreams, spec.streams - readStreams, series); });
+            }
+        }
+    }
+
+    const auto ycsb = [&](const YcsbWorkload& workload)
+    {
+        sweep([&](const auto& load)
+        {
+            YcsbOperations operations{};
+            const double throughput{ measure(load.label(workload.name), 
+                [&](const auto& phase, auto& series){ return ycsbWorkload(phase, workload, load, operations, series); }) };
+            logOperations(workload, load, operations);
+            return throughput;
+        });
+    };
+    for(const auto& workload : YCSB_WORKLOADS)
+    {
+        if(spec.runs(workload.id))
+        {
+            ycsb(workload);
+        }
+    }
+
+    if(spec.runs("custom"))
     {
-        readOnlyBulk(ipAddress, batchSize);
-        writeOnlyBulk(ipAddress, batchSize);
-        dualMessageBulk(ipAddress, batchSize);
+        ycsb(YcsbWorkload{ "custom", "YCSB Custom", spec.proportions, false });
     }
 
     return 0;
@@ -20,8 +20,6 @@ namespace rogue
             double m_normalizationConstant; // Typically a harmonic number
             std::uniform_real_distribution<double> m_distribution;
             static constexpr double m_epsilon{ 1e-8 };
-            std::random_device randomizer{};
-            std::mt19937 generator{ randomizer() };
 
             static double exponentialMinus1OverX(const double x)
             {
@@ -65,11 +63,12 @@ namespace rogue
                 m_distribution{ m_generalizedHarmonicNumber, m_normalizationConstant }
             {}
 
-            uint64_t next()
+            template<typename Engine>
+            uint64_t next(Engine& rng)
             {
                 while(true)
                 {
-                    const double u{ m_distribution(generator) };
+                    const double u{ m_distribution(rng) };
                     const double x{ inverseHarmonic(u) };
                     const uint64_t k = std::max(
                         uint64_t{1}, std::min(
@@ -85,15 +84,7 @@ namespace rogue
             {
                 while(true)
                 {
-                    const double u{ m_distribution(rng) };
-                    const double x{ inverseHarmonic(u) };
-                    const uint64_t k = std::max(
-                        uint64_t{1}, std::min(
-                            m_numberOfElements, static_cast<uint64_t>(std::round(x))));
-                    if(u >= harmonic(k + .5) - hat(k))
-                    {
-                        co_yield k;
-                    }
+                    co_yield next(rng);
                 }
             }
             
@@ -1,5 +1,6 @@
 #include <format>
 #include <fstream>
+#include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 #include <jwt-cpp/jwt.h>
 
@@ -63,9 +64,16 @@ int main(int argc, char** argv)
     rogue::services::Test test{};
     test.set_attribute1(10);
     
-    rogue::services::Insert request{}; // Insert API
-    // rogue::services::Update update{}; // Update API
-    // rogue::services::Remove remove{}; // Remove API
+    // Requests built on an arena allocate their messages from one block, freed together.
+    // Clients sending many requests should reuse one request and its arena, calling
+    // clear_messages between writes, instead of building a new request each time.
+    google::protobuf::Arena arena{};
+    rogue::services::Insert& request{
+        *google::protobuf::Arena::Create<rogue::services::Insert>(&arena) }; // Insert API
+    // rogue::services::Update& update{
+    //     *google::protobuf::Arena::Create<rogue::services::Update>(&arena) }; // Update API
+    // rogue::services::Remove& remove{
+    //     *google::protobuf::Arena::Create<rogue::services::Remove>(&arena) }; // Remove API
     
     request.set_api_key(API_KEY);
 
@@ -96,7 +104,8 @@ int main(int argc, char** argv)
 
     {
         // Example of a basic index query.
-        rogue::services::Search search{};
+        rogue::services::Search& search{
+            *google::protobuf::Arena::Create<rogue::services::Search>(&arena) };
         search.set_api_key(API_KEY);
         
         // For Test, attribute1, attribute2, and attribute3 form the index.
@@ -121,7 +130,8 @@ int main(int argc, char** argv)
         (*expression.add_operands()).PackFrom(test);
 
         grpc::ClientContext context{};
-        rogue::services::Response response{};
+        rogue::services::Response& response{
+            *google::protobuf::Arena::Create<rogue::services::Response>(&arena) };
         std::shared_ptr<grpc::ClientReaderWriter<
             rogue::services::Search, rogue::services::Response>> stream{
                 roguedb->search(&context) };
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "roguedb_driver/cpp/async_search.h"
+
+namespace
+{
+    // A stream that broke with no Searches on it is opened again only after this long, so an
+    // unreachable server is not dialed in a tight loop.
+    constexpr std::chrono::seconds RECONNECT_DELAY{ 1 };
+}
+
+void rogue::driver::SearchMultiplexer::Awaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    searches.search(std::move(query), [this, handle](QueryResult found){
+        result = std::move(found);
+        handle.resume();
+    });
+}
+
+rogue::driver::SearchMultiplexer::SearchMultiplexer(Client& client, std::string apiKey, const SearchOptions& options) :
+    m_client{ client },
+    m_apiKey{ std::move(apiKey) },
+    m_options{ options },
+    m_balancer{ std::max<uint64_t>(options.streams, 1), client.pool().options().balancing }
+{
+    if(options.window == 0 || options.maxQueries == 0)
+    {
+        throw std::invalid_argument{ "A search stream needs room for at least one query." };
+    }
+    for(uint64_t index{ 0 }; index < m_balancer.size(); ++index)
+    {
+        m_streams.push_back(std::make_unique<Stream>());
+        m_streams.back()->call = m_client.search();
+    }
+    for(uint64_t index{ 0 }; index < m_streams.size(); ++index)
+    {
+        Stream& stream{ *m_streams[index] };
+        stream.writer = std::thread{ [this, &stream](){ write(stream); } };
+        stream.reader = std::thread{ [this, &stream, index](){ read(stream, index); } };
+    }
+}
+
+rogue::driver::SearchMultiplexer::~SearchMultiplexer()
+{
+    m_stopping.store(true);
+    for(auto& stream : m_streams)
+    {
+        std::lock_guard<std::mutex> lock{ stream->lock };
+        stream->changed.notify_all();
+    }
+    for(auto& stream : m_streams)
+    {
+        stream->writer.join();
+        stream->reader.join();
+    }
+}
+
+void rogue::driver::SearchMultiplexer::search(rogue::services::Query query, Callback done)
+{
+    const uint64_t index{ m_balancer.pick() };
+    m_balancer.started(index);
+    Stream& stream{ *m_streams[index] };
+    {
+        std::lock_guard<std::mutex> lock{ stream.lock };
+        stream.queue.push_back(Submitted{ std::move(query), std::move(done) });
+    }
+    stream.changed.notify_all();
+}
+
+std::future<rogue::driver::QueryResult> rogue::driver::SearchMultiplexer::search(rogue::services::Query query)
+{
+    auto promise{ std::make_shared<std::promise<QueryResult>>() };
+    std::future<QueryResult> result{ promise->get_future() };
+    search(std::move(query), [promise](QueryResult found){ promise->set_value(std::move(found)); });
+    return result;
+}
+
+// Packs every waiting query, up to maxQueries, into the next Search once the window has room.
+// The Search is in flight before it is written, so its responses always find it.
+void rogue::driver::SearchMultiplexer::write(Stream& stream)
+{
+    rogue::services::Search search{};
+    search.set_api_key(m_apiKey);
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{ stream.lock };
+            stream.changed.wait(lock, [this, &stream](){
+                return (!stream.queue.empty() && stream.inFlight.size() < m_options.window)
+                    || (m_stopping.load() && stream.queue.empty() && stream.inFlight.empty());
+            });
+        }
+
+        std::lock_guard<std::mutex> writing{ stream.writing };
+        bool stopping{ false };
+        {
+            std::lock_guard<std::mutex> lock{ stream.lock };
+            stopping = stream.queue.empty();
+            if(!stopping)
+            {
+                InFlight& inFlight{ stream.inFlight.emplace_back() };
+                while(!stream.queue.empty() && static_cast<uint64_t>(search.queries_size()) < m_options.maxQueries)
+                {
+                    *search.add_queries() = std::move(stream.queue.front().query);
+                    inFlight.callers.push_back(std::move(stream.queue.front().done));
+                    stream.queue.pop_front();
+                }
+                inFlight.results.resize(inFlight.callers.size());
+                inFlight.finished.assign(inFlight.callers.size(), false);
+                inFlight.remaining = inFlight.callers.size();
+            }
+        }
+        if(stopping)
+        {
+            stream.call->stream->WritesDone();
+            stream.closed = true;
+            return;
+        }
+        // A failed write shows up on the reader, which fails the Search with the stream.
+        stream.call->stream->Write(search);
+        search.clear_queries();
+    }
+}
+
+void rogue::driver::SearchMultiplexer::read(Stream& stream, const uint64_t index)
+{
+    rogue::services::Response response{};
+    std::vector<Completion> completions{};
+    while(true)
+    {
+        if(stream.call->stream->Read(&response))
+        {
+            {
+                std::lock_guard<std::mutex> lock{ stream.lock };
+                resolve(stream, response, completions);
+            }
+            stream.changed.notify_all();
+            complete(completions, index);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> writing{ stream.writing };
+            grpc::Status status{ stream.call->stream->Finish() };
+            if(stream.closed)
+            {
+                return;
+            }
+            if(status.ok())
+            {
+                status = grpc::Status{ grpc::StatusCode::UNAVAILABLE, "Search stream closed." };
+            }
+
+            std::unique_lock<std::mutex> lock{ stream.lock };
+            const bool idle{ stream.inFlight.empty() };
+            for(InFlight& search : stream.inFlight)
+            {
+                for(uint64_t id{ 0 }; id < search.callers.size(); ++id)
+                {
+                    if(!search.finished[id])
+                    {
+                        completions.push_back(Completion{ std::move(search.callers[id]), QueryResult{ status, std::move(search.results[id].messages) } });
+                    }
+                }
+            }
+            stream.inFlight.clear();
+            stream.changed.notify_all();
+            if(idle)
+            {
+                stream.changed.wait_for(lock, RECONNECT_DELAY, [this](){ return m_stopping.load(); });
+            }
+            lock.unlock();
+            stream.call = m_client.search();
+        }
+        complete(completions, index);
+    }
+}
+
+// Ids are positions within a Search, so each is credited to the oldest Search in flight that
+// has not finished it yet.
+void rogue::driver::SearchMultiplexer::resolve(Stream& stream, rogue::services::Response& response, std::vector<Completion>& completions)
+{
+    const auto owner{ [&stream](const uint64_t id) -> InFlight* {
+        for(InFlight& search : stream.inFlight)
+        {
+            if(id < search.finished.size() && !search.finished[id])
+            {
+                return &search;
+            }
+        }
+        return nullptr;
+    } };
+
+    for(auto& [id, messages] : *response.mutable_results())
+    {
+        InFlight* search{ owner(id) };
+        if(search == nullptr)
+        {
+            continue;
+        }
+        std::vector<google::protobuf::Any>& found{ search->results[id].messages };
+        for(google::protobuf::Any& message : *messages.mutable_messages())
+        {
+            found.push_back(std::move(message));
+        }
+    }
+    for(const uint64_t id : response.finished())
+    {
+        InFlight* search{ owner(id) };
+        if(search == nullptr)
+        {
+            continue;
+        }
+        search->finished[id] = true;
+        --search->remaining;
+        completions.push_back(Completion{ std::move(search->callers[id]), std::move(search->results[id]) });
+    }
+    while(!stream.inFlight.empty() && stream.inFlight.front().remaining == 0)
+    {
+        stream.inFlight.pop_front();
+    }
+    response.Clear();
+}
+
+void rogue::driver::SearchMultiplexer::complete(std::vector<Completion>& completions, const uint64_t index)
+{
+    for(Completion& completion : completions)
+    {
+        m_balancer.finished(index);
+        completion.done(std::move(completion.result));
+    }
+    completions.clear();
+}
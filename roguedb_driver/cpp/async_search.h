@@ -0,0 +1,139 @@
+#ifndef ASYNC_SEARCH_H
+#define ASYNC_SEARCH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <google/protobuf/any.pb.h>
+#include <grpcpp/grpcpp.h>
+
+#include "roguedb_driver/cpp/channel_pool.h"
+#include "roguedb_driver/cpp/client.h"
+
+namespace rogue
+{
+    namespace driver
+    {
+        struct SearchOptions
+        {
+            // Search streams shared by every caller.
+            uint64_t streams{ 4 };
+            // Searches written to a stream before the oldest one finished.
+            uint64_t window{ 8 };
+            // Queries of concurrent callers packed into one Search.
+            uint64_t maxQueries{ 1000 };
+        };
+
+        // Everything RogueDB returned for one query. Results are only complete when the status
+        // is OK.
+        struct QueryResult
+        {
+            grpc::Status status{};
+            std::vector<google::protobuf::Any> messages{};
+        };
+
+        // Runs single queries of many callers over a few shared search streams. Queries waiting
+        // for a stream are packed into one Search, so each caller's query gets the id of its
+        // position there. Searches are pipelined up to window per stream, and a caller is
+        // resolved as soon as its id is finished, without waiting for the rest of its Search.
+        //
+        // Responses only carry ids within a Search, so they are matched to the oldest Search
+        // on the stream with that id unfinished. That relies on RogueDB answering the Searches
+        // of a stream in order, as it does.
+        //
+        // Callbacks and awaiting coroutines run on the stream's reader thread, and must hand
+        // off any long work. A broken stream fails its outstanding queries with its status and
+        // is opened again for the queries after them.
+        class SearchMultiplexer
+        {
+        public:
+            using Callback = std::function<void(QueryResult)>;
+
+            struct Awaiter
+            {
+                SearchMultiplexer& searches;
+                rogue::services::Query query;
+                QueryResult result{};
+
+                bool await_ready() const noexcept { return false; }
+                void await_suspend(std::coroutine_handle<> handle);
+                QueryResult await_resume() { return std::move(result); }
+            };
+
+            SearchMultiplexer(Client& client, std::string apiKey, const SearchOptions& options = {});
+            // Waits for every query submitted so far.
+            ~SearchMultiplexer();
+            SearchMultiplexer(const SearchMultiplexer&) = delete;
+            SearchMultiplexer& operator=(const SearchMultiplexer&) = delete;
+
+            // Thread-safe.
+            void search(rogue::services::Query query, Callback done);
+            std::future<QueryResult> search(rogue::services::Query query);
+            // const QueryResult result{ co_await searches.awaitable(query) };
+            Awaiter awaitable(rogue::services::Query query) { return Awaiter{ *this, std::move(query) }; }
+
+        private:
+            struct Submitted
+            {
+                rogue::services::Query query;
+                Callback done;
+            };
+
+            // A Search written and not yet finished, by query id.
+            struct InFlight
+            {
+                std::vector<Callback> callers{};
+                std::vector<QueryResult> results{};
+                std::vector<bool> finished{};
+                uint64_t remaining{ 0 };
+            };
+
+            struct Completion
+            {
+                Callback done;
+                QueryResult result;
+            };
+
+            struct Stream
+            {
+                // Held while writing, and by the reader to replace a broken call.
+                std::mutex writing{};
+                std::unique_ptr<Client::SearchCall> call{};
+                bool closed{ false };
+
+                std::mutex lock{};
+                std::condition_variable changed{};
+                std::deque<Submitted> queue{};
+                std::deque<InFlight> inFlight{};
+
+                std::thread writer{};
+                std::thread reader{};
+            };
+
+            void write(Stream& stream);
+            void read(Stream& stream, const uint64_t index);
+            // Matches a Response to the Searches in flight. Finished callers are moved to completions.
+            void resolve(Stream& stream, rogue::services::Response& response, std::vector<Completion>& completions);
+            void complete(std::vector<Completion>& completions, const uint64_t index);
+
+            Client& m_client;
+            const std::string m_apiKey;
+            const SearchOptions m_options;
+            // Queries submitted to a stream and not yet resolved.
+            Balancer m_balancer;
+            std::vector<std::unique_ptr<Stream>> m_streams{};
+            std::atomic<bool> m_stopping{ false };
+        };
+    }
+}
+
+#endif //ASYNC_SEARCH_H
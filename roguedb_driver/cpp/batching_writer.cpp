@@ -0,0 +1,29 @@
+#include "roguedb_driver/cpp/batching_writer.h"
+
+rogue::driver::BatchingWriter::BatchingWriter(Client& client, const std::string& apiKey, const BatchOptions& options) :
+    m_inserts{ options, apiKey, [&client](const rogue::services::Insert& request){ return client.insert(request); } },
+    m_updates{ options, apiKey, [&client](const rogue::services::Update& request){ return client.update(request); } },
+    m_removes{ options, apiKey, [&client](const rogue::services::Remove& request){ return client.remove(request); } }
+{}
+
+std::future<grpc::Status> rogue::driver::BatchingWriter::insert(const google::protobuf::Message& message)
+{
+    return m_inserts.enqueue(message);
+}
+
+std::future<grpc::Status> rogue::driver::BatchingWriter::update(const google::protobuf::Message& message)
+{
+    return m_updates.enqueue(message);
+}
+
+std::future<grpc::Status> rogue::driver::BatchingWriter::remove(const google::protobuf::Message& message)
+{
+    return m_removes.enqueue(message);
+}
+
+void rogue::driver::BatchingWriter::flush()
+{
+    m_inserts.flush();
+    m_updates.flush();
+    m_removes.flush();
+}
@@ -0,0 +1,376 @@
+#ifndef BATCHING_WRITER_H
+#define BATCHING_WRITER_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+
+#include "roguedb_driver/cpp/client.h"
+
+namespace rogue
+{
+    namespace driver
+    {
+        struct BatchOptions
+        {
+            // A batch is written once it holds maxMessages messages or maxBytes bytes, or once
+            // its oldest message waited linger.
+            uint64_t maxMessages{ 1000 };
+            uint64_t maxBytes{ 3 << 20 }; // Below gRPC's default 4MB limit on received messages.
+            std::chrono::microseconds linger{ 1000 };
+            // Batches are built and written by this many threads per write method, each
+            // draining its own queue.
+            uint64_t flushers{ 2 };
+            // Keeps the time a batch takes to write near the target by shrinking the message
+            // limit while writes are slower and growing it while full batches write faster,
+            // between minMessages and maxMessages. Time spent queued is left out, as smaller
+            // batches would only lengthen a backlog. Fixed when 0.
+            std::chrono::microseconds targetLatency{ 0 };
+            uint64_t minMessages{ 10 };
+        };
+
+        // Lock-free queue of many producers and one consumer. push never waits, pop returns
+        // nullptr when empty or while a push is halfway through.
+        template<typename Value>
+        class MpscQueue
+        {
+        public:
+            struct Node
+            {
+                std::atomic<Node*> next{ nullptr };
+                Value value{};
+            };
+
+            MpscQueue() :
+                m_head{ &m_stub },
+                m_tail{ &m_stub }
+            {}
+
+            ~MpscQueue()
+            {
+                while(Node* node{ pop() })
+                {
+                    delete node;
+                }
+            }
+
+            MpscQueue(const MpscQueue&) = delete;
+            MpscQueue& operator=(const MpscQueue&) = delete;
+
+            void push(Node* node)
+            {
+                node->next.store(nullptr, std::memory_order_relaxed);
+                Node* previous{ m_head.exchange(node, std::memory_order_acq_rel) };
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            // Consumer only. The caller owns the returned node.
+            Node* pop()
+            {
+                Node* tail{ m_tail };
+                Node* next{ tail->next.load(std::memory_order_acquire) };
+                if(tail == &m_stub)
+                {
+                    if(next == nullptr)
+                    {
+                        return nullptr;
+                    }
+                    m_tail = next;
+                    tail = next;
+                    next = next->next.load(std::memory_order_acquire);
+                }
+                if(next != nullptr)
+                {
+                    m_tail = next;
+                    return tail;
+                }
+                if(tail != m_head.load(std::memory_order_acquire))
+                {
+                    return nullptr;
+                }
+                push(&m_stub);
+                next = tail->next.load(std::memory_order_acquire);
+                if(next != nullptr)
+                {
+                    m_tail = next;
+                    return tail;
+                }
+                return nullptr;
+            }
+
+        private:
+            std::atomic<Node*> m_head;
+            Node* m_tail;
+            Node m_stub{};
+        };
+
+        // Gathers single messages for one write method into Requests (Insert, Update, Remove).
+        // Each flusher owns a queue. Producers stick to one queue per thread, so they rarely
+        // share one with another thread and never wait on the flusher.
+        template<typename Request>
+        class WriteBatcher
+        {
+        public:
+            using Write = std::function<grpc::Status(const Request&)>;
+
+            WriteBatcher(const BatchOptions& options, std::string apiKey, Write write) :
+                m_options{ options },
+                m_apiKey{ std::move(apiKey) },
+                m_write{ std::move(write) },
+                m_limit{ options.maxMessages }
+            {
+                if(options.maxMessages == 0 || options.maxBytes == 0)
+                {
+                    throw std::invalid_argument{ "A batch needs room for at least one message." };
+                }
+                for(uint64_t index{ 0 }; index < std::max<uint64_t>(options.flushers, 1); ++index)
+                {
+                    m_flushers.push_back(std::make_unique<Flusher>());
+                }
+                for(auto& flusher : m_flushers)
+                {
+                    flusher->thread = std::thread{ [this, target = flusher.get()](){ run(*target); } };
+                }
+            }
+
+            // Writes every queued message before returning.
+            ~WriteBatcher()
+            {
+                m_stopping.store(true);
+                for(auto& flusher : m_flushers)
+                {
+                    wake(*flusher);
+                }
+                for(auto& flusher : m_flushers)
+                {
+                    flusher->thread.join();
+                }
+            }
+
+            WriteBatcher(const WriteBatcher&) = delete;
+            WriteBatcher& operator=(const WriteBatcher&) = delete;
+
+            // Completes with the status of the write that carried the message. Writes are not
+            // acknowledged, so OK means it was sent, see Client::complete.
+            std::future<grpc::Status> enqueue(const google::protobuf::Message& message)
+            {
+                auto* node{ new typename Queue::Node{} };
+                node->value.message.PackFrom(message);
+                node->value.enqueued = std::chrono::steady_clock::now();
+                std::future<grpc::Status> done{ node->value.done.get_future() };
+
+                m_enqueued.fetch_add(1, std::memory_order_relaxed);
+                Flusher& flusher{ *m_flushers[producer() % m_flushers.size()] };
+                flusher.queue.push(node);
+                // Pairs with the fence in await, so either the flusher sees the message or
+                // this sees the flusher asleep.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(flusher.sleeping.load())
+                {
+                    wake(flusher);
+                }
+                return done;
+            }
+
+            // Writes everything enqueued before the call without waiting for linger, and
+            // returns once it is written.
+            void flush()
+            {
+                const uint64_t target{ m_enqueued.load() };
+                m_flushing.fetch_add(1);
+                for(auto& flusher : m_flushers)
+                {
+                    wake(*flusher);
+                }
+                for(uint64_t written{ m_written.load() }; written < target; written = m_written.load())
+                {
+                    m_written.wait(written);
+                }
+                m_flushing.fetch_sub(1);
+            }
+
+            // Current message limit of a batch, see BatchOptions::targetLatency.
+            uint64_t limit() const { return m_limit.load(std::memory_order_relaxed); }
+
+        private:
+            struct Entry
+            {
+                google::protobuf::Any message{};
+                std::chrono::steady_clock::time_point enqueued{};
+                std::promise<grpc::Status> done{};
+            };
+
+            using Queue = MpscQueue<Entry>;
+
+            struct Flusher
+            {
+                Queue queue{};
+                std::atomic<bool> sleeping{ false };
+                std::mutex lock{};
+                std::condition_variable wake{};
+                std::thread thread{};
+            };
+
+            static uint64_t producer()
+            {
+                static std::atomic<uint64_t> producers{ 0 };
+                thread_local const uint64_t index{ producers.fetch_add(1, std::memory_order_relaxed) };
+                return index;
+            }
+
+            void wake(Flusher& flusher)
+            {
+                std::lock_guard<std::mutex> lock{ flusher.lock };
+                flusher.wake.notify_one();
+            }
+
+            // Sleeps until a message is queued or the batcher stops, and returns the next
+            // message if any. While a batch is open (lingering), also returns at its deadline
+            // and as soon as a flush is requested. The flags are checked under the lock that
+            // wake takes, so a stop or flush cannot slip in between the check and the wait.
+            typename Queue::Node* await(Flusher& flusher, const bool lingering, const std::chrono::steady_clock::time_point deadline = {})
+            {
+                typename Queue::Node* node{ flusher.queue.pop() };
+                if(node != nullptr)
+                {
+                    return node;
+                }
+                const auto ready = [&]()
+                {
+                    return (node = flusher.queue.pop()) != nullptr
+                        || m_stopping.load()
+                        || (lingering && m_flushing.load() > 0);
+                };
+
+                std::unique_lock<std::mutex> lock{ flusher.lock };
+                flusher.sleeping.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(lingering)
+                {
+                    flusher.wake.wait_until(lock, deadline, ready);
+                }
+                else
+                {
+                    flusher.wake.wait(lock, ready);
+                }
+                flusher.sleeping.store(false);
+                return node;
+            }
+
+            void run(Flusher& flusher)
+            {
+                Request request{};
+                request.set_api_key(m_apiKey);
+                std::vector<std::promise<grpc::Status>> done{};
+                while(true)
+                {
+                    typename Queue::Node* node{ await(flusher, false) };
+                    if(node == nullptr)
+                    {
+                        if(m_stopping.load())
+                        {
+                            return;
+                        }
+                        continue;
+                    }
+
+                    const auto deadline{ node->value.enqueued + m_options.linger };
+                    const uint64_t limit{ m_limit.load(std::memory_order_relaxed) };
+                    uint64_t bytes{ 0 };
+                    while(node != nullptr)
+                    {
+                        bytes += node->value.message.ByteSizeLong();
+                        *request.add_messages() = std::move(node->value.message);
+                        done.push_back(std::move(node->value.done));
+                        delete node;
+                        if(static_cast<uint64_t>(request.messages_size()) >= limit || bytes >= m_options.maxBytes)
+                        {
+                            break;
+                        }
+                        node = await(flusher, true, deadline);
+                    }
+
+                    const auto writing{ std::chrono::steady_clock::now() };
+                    const grpc::Status status{ m_write(request) };
+                    adapt(std::chrono::steady_clock::now() - writing, done.size() >= limit);
+                    for(auto& promise : done)
+                    {
+                        promise.set_value(status);
+                    }
+                    m_written.fetch_add(done.size());
+                    m_written.notify_all();
+                    done.clear();
+                    request.clear_messages();
+                }
+            }
+
+            void adapt(const std::chrono::steady_clock::duration latency, const bool full)
+            {
+                if(m_options.targetLatency.count() == 0)
+                {
+                    return;
+                }
+                const uint64_t minimum{ std::clamp(m_options.minMessages, uint64_t{1}, m_options.maxMessages) };
+                const uint64_t limit{ m_limit.load(std::memory_order_relaxed) };
+                if(latency > m_options.targetLatency)
+                {
+                    m_limit.store(std::max(minimum, limit * 3 / 4), std::memory_order_relaxed);
+                }
+                else if(full)
+                {
+                    m_limit.store(std::min(m_options.maxMessages, limit + limit / 8 + 1), std::memory_order_relaxed);
+                }
+            }
+
+            const BatchOptions m_options;
+            const std::string m_apiKey;
+            const Write m_write;
+            std::atomic<uint64_t> m_limit;
+            std::vector<std::unique_ptr<Flusher>> m_flushers{};
+            std::atomic<uint64_t> m_enqueued{ 0 };
+            std::atomic<uint64_t> m_written{ 0 };
+            std::atomic<uint64_t> m_flushing{ 0 };
+            std::atomic<bool> m_stopping{ false };
+        };
+
+        // Single-row writes of many threads, batched onto a Client's write streams, eg.
+        //
+        //     rogue::driver::BatchingWriter writer{ client, API_KEY, { .linger = std::chrono::milliseconds{ 2 } } };
+        //     std::future<grpc::Status> written{ writer.insert(row) };
+        class BatchingWriter
+        {
+        public:
+            BatchingWriter(Client& client, const std::string& apiKey, const BatchOptions& options = {});
+
+            std::future<grpc::Status> insert(const google::protobuf::Message& message);
+            std::future<grpc::Status> update(const google::protobuf::Message& message);
+            std::future<grpc::Status> remove(const google::protobuf::Message& message);
+            // Writes everything enqueued so far without waiting for linger.
+            void flush();
+
+            const WriteBatcher<rogue::services::Insert>& inserts() const { return m_inserts; }
+            const WriteBatcher<rogue::services::Update>& updates() const { return m_updates; }
+            const WriteBatcher<rogue::services::Remove>& removes() const { return m_removes; }
+
+        private:
+            WriteBatcher<rogue::services::Insert> m_inserts;
+            WriteBatcher<rogue::services::Update> m_updates;
+            WriteBatcher<rogue::services::Remove> m_removes;
+        };
+    }
+}
+
+#endif //BATCHING_WRITER_H
@@ -0,0 +1,109 @@
+#include <stdexcept>
+
+#include "roguedb_driver/cpp/channel_pool.h"
+
+namespace
+{
+    // Distinguishes the channels of a pool, see ChannelPool.
+    constexpr char CHANNEL_INDEX[]{ "rogue.driver.channel_index" };
+}
+
+rogue::driver::Balancer::Balancer(const uint64_t slots, const Balancing balancing) :
+    m_size{ std::max<uint64_t>(slots, 1) },
+    m_balancing{ balancing },
+    m_inFlight{ std::make_unique<std::atomic<uint64_t>[]>(m_size) }
+{}
+
+uint64_t rogue::driver::Balancer::pick()
+{
+    const uint64_t start{ m_next.fetch_add(1, std::memory_order_relaxed) % m_size };
+    if(m_balancing == Balancing::ROUND_ROBIN)
+    {
+        return start;
+    }
+
+    // Counts may change during the scan, so the pick is a good one rather than the best.
+    uint64_t best{ start };
+    uint64_t fewest{ m_inFlight[start].load(std::memory_order_relaxed) };
+    for(uint64_t offset{ 1 }; offset < m_size && fewest > 0; ++offset)
+    {
+        const uint64_t slot{ (start + offset) % m_size };
+        const uint64_t inFlight{ m_inFlight[slot].load(std::memory_order_relaxed) };
+        if(inFlight < fewest)
+        {
+            best = slot;
+            fewest = inFlight;
+        }
+    }
+    return best;
+}
+
+void rogue::driver::Balancer::started(const uint64_t slot)
+{
+    m_inFlight[slot].fetch_add(1, std::memory_order_relaxed);
+}
+
+void rogue::driver::Balancer::finished(const uint64_t slot)
+{
+    m_inFlight[slot].fetch_sub(1, std::memory_order_relaxed);
+}
+
+rogue::driver::ChannelPool::Lease::Lease(ChannelPool& pool, const uint64_t slot) :
+    m_pool{ &pool },
+    m_slot{ slot }
+{
+    m_pool->m_balancer.started(m_slot);
+}
+
+rogue::driver::ChannelPool::Lease::~Lease()
+{
+    if(m_pool != nullptr)
+    {
+        m_pool->m_balancer.finished(m_slot);
+    }
+}
+
+rogue::driver::ChannelPool::Lease::Lease(Lease&& other) noexcept :
+    m_pool{ std::exchange(other.m_pool, nullptr) },
+    m_slot{ other.m_slot }
+{}
+
+const std::shared_ptr<grpc::Channel>& rogue::driver::ChannelPool::Lease::channel() const
+{
+    return m_pool->m_channels[m_slot];
+}
+
+rogue::services::RogueDB::Stub& rogue::driver::ChannelPool::Lease::stub() const
+{
+    return *m_pool->m_stubs[m_slot];
+}
+
+rogue::driver::ChannelPool::ChannelPool(PoolOptions options) :
+    m_options{ std::move(options) },
+    m_balancer{ m_options.channels, m_options.balancing }
+{
+    if(m_options.target.empty())
+    {
+        throw std::invalid_argument{ "A pool needs a target." };
+    }
+    for(uint64_t index{ 0 }; index < m_balancer.size(); ++index)
+    {
+        grpc::ChannelArguments arguments{ m_options.arguments };
+        arguments.SetInt(CHANNEL_INDEX, static_cast<int>(index));
+        m_channels.push_back(grpc::CreateCustomChannel(m_options.target, m_options.credentials, arguments));
+        m_stubs.push_back(rogue::services::RogueDB::NewStub(m_channels.back()));
+    }
+}
+
+rogue::driver::ChannelPool::Lease rogue::driver::ChannelPool::acquire()
+{
+    return Lease{ *this, m_balancer.pick() };
+}
+
+void rogue::driver::ChannelPool::prepare(grpc::ClientContext& context) const
+{
+    for(const auto& [key, value] : m_options.metadata)
+    {
+        context.AddMetadata(key, value);
+    }
+}
@@ -0,0 +1,273 @@
+#ifndef CHANNEL_POOL_H
+#define CHANNEL_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+
+#include "getting_started/roguedb.grpc.pb.h"
+
+namespace rogue
+{
+    namespace driver
+    {
+        // How a call picks its channel or stream.
+        enum class Balancing
+        {
+            // The next one in turn.
+            ROUND_ROBIN,
+            // The one with the fewest calls in flight, ties broken in turn.
+            LEAST_IN_FLIGHT
+        };
+
+        struct PoolOptions
+        {
+            // eg. 127.0.0.1:80 or c-[identifier].roguedb.dev:443
+            std::string target{};
+            std::shared_ptr<grpc::ChannelCredentials> credentials{ grpc::InsecureChannelCredentials() };
+            // Channels, each with its own connection.
+            uint64_t channels{ 4 };
+            // Long-lived streams of every write method on each channel.
+            uint64_t streamsPerChannel{ 1 };
+            Balancing balancing{ Balancing::LEAST_IN_FLIGHT };
+            // Added to the context of every call, eg. { "authorization", "Bearer [jwt]" }.
+            // Keys must be lowercase.
+            std::vector<std::pair<std::string, std::string>> metadata{};
+            grpc::ChannelArguments arguments{};
+        };
+
+        // Picks among a fixed set of slots without locks. Each slot counts the calls in flight
+        // on it, which LEAST_IN_FLIGHT reads and both policies keep up to date.
+        class Balancer
+        {
+        public:
+            Balancer(const uint64_t slots, const Balancing balancing);
+
+            uint64_t pick();
+            void started(const uint64_t slot);
+            void finished(const uint64_t slot);
+            uint64_t size() const { return m_size; }
+
+        private:
+            const uint64_t m_size;
+            const Balancing m_balancing;
+            std::unique_ptr<std::atomic<uint64_t>[]> m_inFlight;
+            std::atomic<uint64_t> m_next{ 0 };
+        };
+
+        // channels distinct channels to one target. gRPC shares a connection between channels
+        // created with equal arguments, so each gets a distinct channel index argument and
+        // with it a connection of its own, which lifts the per-connection limit on concurrent
+        // streams and spreads the load over the server's threads.
+        class ChannelPool
+        {
+        public:
+            // A channel picked for one or more calls, counted in flight until destroyed.
+            class Lease
+            {
+            public:
+                Lease(ChannelPool& pool, const uint64_t slot);
+                ~Lease();
+                Lease(Lease&& other) noexcept;
+                Lease(const Lease&) = delete;
+                Lease& operator=(const Lease&) = delete;
+                Lease& operator=(Lease&&) = delete;
+
+                const std::shared_ptr<grpc::Channel>& channel() const;
+                rogue::services::RogueDB::Stub& stub() const;
+
+            private:
+                ChannelPool* m_pool;
+                uint64_t m_slot;
+            };
+
+            explicit ChannelPool(PoolOptions options);
+            ChannelPool(const ChannelPool&) = delete;
+            ChannelPool& operator=(const ChannelPool&) = delete;
+
+            Lease acquire();
+            // Adds the metadata of the options to a context before its call starts.
+            void prepare(grpc::ClientContext& context) const;
+
+            const PoolOptions& options() const { return m_options; }
+            uint64_t size() const { return m_channels.size(); }
+            const std::shared_ptr<grpc::Channel>& channel(const uint64_t index) const { return m_channels[index]; }
+            rogue::services::RogueDB::Stub& stub(const uint64_t index) const { return *m_stubs[index]; }
+
+        private:
+            const PoolOptions m_options;
+            std::vector<std::shared_ptr<grpc::Channel>> m_channels{};
+            std::vector<std::unique_ptr<rogue::services::RogueDB::Stub>> m_stubs{};
+            Balancer m_balancer;
+        };
+
+        // streamsPerChannel long-lived streams of one write method (insert, update, remove) on
+        // every channel of a pool. Each write takes a stream to itself: a balanced pick, then
+        // the first free stream from there, claimed with a single atomic exchange. A stream the
+        // server closed is finished and replaced by the writer that noticed, so one bad request
+        // costs only its own stream. Streams open on their first write. While every stream is
+        // busy, a writer retries a few rounds and then sleeps until one is released.
+        template<typename Request>
+        class WriteStreams
+        {
+        public:
+            using Stream = grpc::ClientReaderWriter<Request, rogue::services::Response>;
+            // Opens a stream on a channel of the pool, eg.
+            // [](ChannelPool& pool, uint64_t channel, grpc::ClientContext* context){ return pool.stub(channel).insert(context); }
+            using Open = std::unique_ptr<Stream>(*)(ChannelPool&, const uint64_t, grpc::ClientContext*);
+
+            WriteStreams(ChannelPool& pool, const Open open) :
+                m_pool{ pool },
+                m_open{ open },
+                m_balancer{ pool.size() * std::max<uint64_t>(pool.options().streamsPerChannel, 1), pool.options().balancing },
+                m_slots(m_balancer.size())
+            {
+                // Streams are opened by their first write.
+                for(auto& slot : m_slots)
+                {
+                    slot = std::make_unique<Slot>();
+                }
+            }
+
+            ~WriteStreams()
+            {
+                close();
+            }
+
+            WriteStreams(const WriteStreams&) = delete;
+            WriteStreams& operator=(const WriteStreams&) = delete;
+
+            // Blocks while the stream applies flow control. Returns the status the server closed
+            // the stream with when the write failed, OK otherwise. Writes are not acknowledged,
+            // so an OK status only means the request was sent.
+            grpc::Status write(const Request& request, const grpc::WriteOptions& options = {})
+            {
+                const uint64_t index{ claim() };
+                Slot& slot{ *m_slots[index] };
+                if(!slot.stream)
+                {
+                    reopen(slot, index);
+                }
+                m_balancer.started(index);
+                grpc::Status status{ grpc::Status::OK };
+                if(!slot.stream->Write(request, options))
+                {
+                    status = slot.stream->Finish();
+                    if(status.ok())
+                    {
+                        status = grpc::Status{ grpc::StatusCode::UNAVAILABLE, "Write stream closed." };
+                    }
+                    reopen(slot, index);
+                }
+                m_balancer.finished(index);
+                slot.busy.store(false, std::memory_order_release);
+                m_released.fetch_add(1);
+                if(m_waiting.load() > 0)
+                {
+                    m_released.notify_one();
+                }
+                return status;
+            }
+
+            // Half-closes every stream and waits for its status. The first error is returned.
+            // Not safe while writes are in progress. Later writes open the streams again.
+            grpc::Status close()
+            {
+                grpc::Status first{ grpc::Status::OK };
+                for(auto& slot : m_slots)
+                {
+                    if(!slot->stream)
+                    {
+                        continue;
+                    }
+                    slot->stream->WritesDone();
+                    const grpc::Status status{ slot->stream->Finish() };
+                    if(first.ok() && !status.ok())
+                    {
+                        first = status;
+                    }
+                    slot->stream.reset();
+                    slot->context.reset();
+                }
+                return first;
+            }
+
+            uint64_t size() const { return m_slots.size(); }
+
+        private:
+            struct Slot
+            {
+                std::atomic<bool> busy{ false };
+                std::unique_ptr<grpc::ClientContext> context{};
+                std::unique_ptr<Stream> stream{};
+            };
+
+            // Rounds over the slots before a writer sleeps until a slot is released, so
+            // writers stalled on flow control do not each burn a core.
+            static constexpr uint64_t SPINS{ 16 };
+
+            uint64_t claim()
+            {
+                for(uint64_t round{ 0 };; ++round)
+                {
+                    const bool sleeping{ round >= SPINS };
+                    if(sleeping)
+                    {
+                        m_waiting.fetch_add(1);
+                    }
+                    // Read before the scan, so a release after it wakes the wait below.
+                    const uint64_t released{ m_released.load() };
+                    const uint64_t start{ m_balancer.pick() };
+                    for(uint64_t offset{ 0 }; offset < m_slots.size(); ++offset)
+                    {
+                        const uint64_t index{ (start + offset) % m_slots.size() };
+                        if(!m_slots[index]->busy.load(std::memory_order_relaxed)
+                            && !m_slots[index]->busy.exchange(true, std::memory_order_acquire))
+                        {
+                            if(sleeping)
+                            {
+                                m_waiting.fetch_sub(1);
+                            }
+                            return index;
+                        }
+                    }
+
+                    if(sleeping)
+                    {
+                        m_released.wait(released);
+                        m_waiting.fetch_sub(1);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            // Streams are spread over the channels, stream i on channel i % channels.
+            void reopen(Slot& slot, const uint64_t index)
+            {
+                slot.stream.reset();
+                slot.context = std::make_unique<grpc::ClientContext>();
+                m_pool.prepare(*slot.context);
+                slot.stream = m_open(m_pool, index % m_pool.size(), slot.context.get());
+            }
+
+            ChannelPool& m_pool;
+            const Open m_open;
+            Balancer m_balancer;
+            std::vector<std::unique_ptr<Slot>> m_slots;
+            // Counts releases, so a sleeping claim wakes on any of them.
+            std::atomic<uint64_t> m_released{ 0 };
+            std::atomic<uint64_t> m_waiting{ 0 };
+        };
+    }
+}
+
+#endif //CHANNEL_POOL_H
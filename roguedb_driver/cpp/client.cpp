@@ -0,0 +1,111 @@
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/support/sync_stream.h>
+
+#include "roguedb_driver/cpp/client.h"
+
+namespace
+{
+    constexpr char INSERT_METHOD[]{ "/rogue.services.RogueDB/insert" };
+    constexpr char UPDATE_METHOD[]{ "/rogue.services.RogueDB/update" };
+    constexpr char REMOVE_METHOD[]{ "/rogue.services.RogueDB/remove" };
+
+    using SerializedStreams = rogue::driver::WriteStreams<grpc::ByteBuffer>;
+
+    template<const char* METHOD>
+    std::unique_ptr<SerializedStreams::Stream> openSerialized(
+        rogue::driver::ChannelPool& pool,
+        const uint64_t channel,
+        grpc::ClientContext* context)
+    {
+        return std::unique_ptr<SerializedStreams::Stream>{
+            grpc::internal::ClientReaderWriterFactory<grpc::ByteBuffer, rogue::services::Response>::Create(
+                pool.channel(channel).get(),
+                grpc::internal::RpcMethod{ METHOD, grpc::internal::RpcMethod::BIDI_STREAMING },
+                context) };
+    }
+
+    template<typename Request>
+    grpc::Status writeSerialized(SerializedStreams& streams, const Request& request)
+    {
+        grpc::ByteBuffer buffer{};
+        bool owned{ false };
+        const grpc::Status status{ grpc::SerializationTraits<Request>::Serialize(request, &buffer, &owned) };
+        return status.ok() ? streams.write(buffer) : status;
+    }
+}
+
+rogue::driver::Client::Client(PoolOptions options, std::string apiKey) :
+    m_pool{ std::move(options) },
+    m_apiKey{ std::move(apiKey) },
+    m_inserts{ m_pool, openSerialized<INSERT_METHOD> },
+    m_updates{ m_pool, openSerialized<UPDATE_METHOD> },
+    m_removes{ m_pool, openSerialized<REMOVE_METHOD> }
+{}
+
+rogue::driver::Client::~Client() = default;
+
+grpc::Status rogue::driver::Client::insert(const rogue::services::Insert& insert)
+{
+    return writeSerialized(m_inserts, insert);
+}
+
+grpc::Status rogue::driver::Client::insert(const grpc::ByteBuffer& insert)
+{
+    return m_inserts.write(insert);
+}
+
+grpc::Status rogue::driver::Client::update(const rogue::services::Update& update)
+{
+    return writeSerialized(m_updates, update);
+}
+
+grpc::Status rogue::driver::Client::update(const grpc::ByteBuffer& update)
+{
+    return m_updates.write(update);
+}
+
+grpc::Status rogue::driver::Client::remove(const rogue::services::Remove& remove)
+{
+    return writeSerialized(m_removes, remove);
+}
+
+grpc::Status rogue::driver::Client::remove(const grpc::ByteBuffer& remove)
+{
+    return m_removes.write(remove);
+}
+
+grpc::Status rogue::driver::Client::complete()
+{
+    for(const grpc::Status& status : { m_inserts.close(), m_updates.close(), m_removes.close() })
+    {
+        if(!status.ok())
+        {
+            return status;
+        }
+    }
+
+    const ChannelPool::Lease lease{ m_pool.acquire() };
+    grpc::ClientContext context{};
+    m_pool.prepare(context);
+    rogue::services::Insert request{};
+    request.set_api_key(m_apiKey);
+    rogue::services::Response response{};
+    return lease.stub().complete(&context, request, &response);
+}
+
+grpc::Status rogue::driver::Client::subscribe(const rogue::services::Subscribe& subscribe)
+{
+    const ChannelPool::Lease lease{ m_pool.acquire() };
+    grpc::ClientContext context{};
+    m_pool.prepare(context);
+    rogue::services::Response response{};
+    return lease.stub().subscribe(&context, subscribe, &response);
+}
+
+std::unique_ptr<rogue::driver::Client::SearchCall> rogue::driver::Client::search()
+{
+    auto call{ std::make_unique<SearchCall>(m_pool.acquire()) };
+    m_pool.prepare(call->context);
+    call->stream = call->lease.stub().search(&call->context);
+    return call;
+}
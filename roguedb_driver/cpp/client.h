@@ -0,0 +1,73 @@
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <memory>
+#include <string>
+#include <grpcpp/grpcpp.h>
+
+#include "getting_started/roguedb.grpc.pb.h"
+#include "roguedb_driver/cpp/channel_pool.h"
+
+namespace rogue
+{
+    namespace driver
+    {
+        // RogueDB over a ChannelPool. Writes from any number of threads share the pool's
+        // long-lived insert, update, and remove streams, which carry serialized requests.
+        // Searches open a stream on a pooled channel. Requests carry their own api key, as with
+        // the generated stubs.
+        class Client
+        {
+        public:
+            using SearchStream = grpc::ClientReaderWriter<rogue::services::Search, rogue::services::Response>;
+
+            // A search stream with the context and channel it runs on. Write Searches and read
+            // Responses as with the generated stub. The channel counts it in flight until the
+            // call is destroyed.
+            struct SearchCall
+            {
+                explicit SearchCall(ChannelPool::Lease lease) :
+                    lease{ std::move(lease) }
+                {}
+
+                ChannelPool::Lease lease;
+                grpc::ClientContext context{};
+                std::unique_ptr<SearchStream> stream{};
+            };
+
+            // The api key is only used for the requests the client builds itself, see complete.
+            Client(PoolOptions options, std::string apiKey);
+            ~Client();
+            Client(const Client&) = delete;
+            Client& operator=(const Client&) = delete;
+
+            // Thread-safe. A non-OK status is the one the server closed the stream with, which
+            // may have been caused by an earlier write on the same stream.
+            grpc::Status insert(const rogue::services::Insert& insert);
+            grpc::Status update(const rogue::services::Update& update);
+            grpc::Status remove(const rogue::services::Remove& remove);
+            // Serialized requests, eg. from RowEncoder::release, written without serializing again.
+            grpc::Status insert(const grpc::ByteBuffer& insert);
+            grpc::Status update(const grpc::ByteBuffer& update);
+            grpc::Status remove(const grpc::ByteBuffer& remove);
+
+            // Closes the write streams so the server has received every write, then waits for
+            // RogueDB to apply them. Not safe while writes are in progress.
+            grpc::Status complete();
+            grpc::Status subscribe(const rogue::services::Subscribe& subscribe);
+            std::unique_ptr<SearchCall> search();
+
+            ChannelPool& pool() { return m_pool; }
+
+        private:
+            ChannelPool m_pool;
+            const std::string m_apiKey;
+            // Typed requests are serialized before they are written, as gRPC would.
+            WriteStreams<grpc::ByteBuffer> m_inserts;
+            WriteStreams<grpc::ByteBuffer> m_updates;
+            WriteStreams<grpc::ByteBuffer> m_removes;
+        };
+    }
+}
+
+#endif //CLIENT_H
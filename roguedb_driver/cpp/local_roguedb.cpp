@@ -0,0 +1,757 @@
+#include <algorithm>
+#include <format>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/compiler/parser.h>
+#include <google/protobuf/io/tokenizer.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+#include "roguedb_driver/cpp/local_roguedb.h"
+#include "roguedb_driver/cpp/ordered_index.h"
+
+#include "getting_started/roguedb.grpc.pb.h"
+
+namespace
+{
+    using Any = google::protobuf::Any;
+    using Messages = google::protobuf::RepeatedPtrField<Any>;
+    using ComparisonOperator = rogue::services::ComparisonOperator;
+
+    constexpr char INDEX_ANNOTATION[]{ "index-" };
+
+    class SchemaErrors final : public google::protobuf::io::ErrorCollector
+    {
+    public:
+        void RecordError(int line, google::protobuf::io::ColumnNumber column, absl::string_view message) override
+        {
+            if(m_error.empty())
+            {
+                m_error = std::format("line {}, column {}: {}", line + 1, column + 1, std::string{ message });
+            }
+        }
+
+        const std::string& error() const { return m_error; }
+
+    private:
+        std::string m_error{};
+    };
+
+    // A subscribed message type. Rows outlive the table when a subscribe keeps the type
+    // with the same key, and the pool outlives requests still using the old descriptors.
+    struct Table
+    {
+        std::shared_ptr<const google::protobuf::DescriptorPool> pool;
+        const google::protobuf::Descriptor* descriptor;
+        std::string typeUrl;
+        rogue::driver::KeyLayout layout;
+        std::shared_ptr<rogue::driver::OrderedIndex> rows;
+    };
+
+    // N of the //index-N comment behind a field.
+    std::optional<uint64_t> indexPosition(const google::protobuf::FieldDescriptor& field)
+    {
+        google::protobuf::SourceLocation location{};
+        if(!field.GetSourceLocation(&location))
+        {
+            return std::nullopt;
+        }
+        const size_t start{ location.trailing_comments.find(INDEX_ANNOTATION) };
+        if(start == std::string::npos)
+        {
+            return std::nullopt;
+        }
+        try
+        {
+            return std::stoull(location.trailing_comments.substr(start + sizeof(INDEX_ANNOTATION) - 1));
+        }
+        catch(const std::logic_error&)
+        {
+            return std::nullopt;
+        }
+    }
+
+    class Catalog
+    {
+    public:
+        Catalog(std::vector<std::string> builtIn, const uint64_t shards) :
+            m_builtIn{ std::move(builtIn) },
+            m_shards{ shards }
+        {
+            const grpc::Status status{ subscribe({}) };
+            if(!status.ok())
+            {
+                throw std::invalid_argument{ status.error_message() };
+            }
+        }
+
+        // Builds every schema into a new pool and only then swaps the tables, so a failure
+        // leaves the previous schemas in place.
+        grpc::Status subscribe(const google::protobuf::RepeatedPtrField<std::string>& schemas)
+        {
+            std::vector<const std::string*> files{};
+            for(const std::string& schema : m_builtIn)
+            {
+                files.push_back(&schema);
+            }
+            for(const std::string& schema : schemas)
+            {
+                files.push_back(&schema);
+            }
+
+            auto pool{ std::make_shared<google::protobuf::DescriptorPool>() };
+            std::vector<const google::protobuf::Descriptor*> types{};
+            for(uint64_t index{ 0 }; index < files.size(); ++index)
+            {
+                const std::string label{ index < m_builtIn.size()
+                    ? std::format("Built-in schema {}", index)
+                    : std::format("Schema {}", index - m_builtIn.size()) };
+                google::protobuf::io::ArrayInputStream input{ files[index]->data(), static_cast<int>(files[index]->size()) };
+                SchemaErrors errors{};
+                google::protobuf::io::Tokenizer tokenizer{ &input, &errors };
+                google::protobuf::compiler::Parser parser{};
+                parser.RecordErrorsTo(&errors);
+                google::protobuf::FileDescriptorProto file{};
+                if(!parser.Parse(&tokenizer, &file))
+                {
+                    return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, std::format("{} does not parse, {}", label, errors.error()) };
+                }
+                file.set_name(std::format("schema_{}.proto", index));
+                for(const std::string& dependency : file.dependency())
+                {
+                    if(!import(*pool, dependency))
+                    {
+                        return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, std::format("{} imports unknown {}.", label, dependency) };
+                    }
+                }
+                const google::protobuf::FileDescriptor* built{ pool->BuildFile(file) };
+                if(built == nullptr)
+                {
+                    return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, std::format("{} does not build.", label) };
+                }
+                for(int type{ 0 }; type < built->message_type_count(); ++type)
+                {
+                    collect(*built->message_type(type), types);
+                }
+            }
+
+            std::unordered_map<std::string, std::shared_ptr<const Table>> tables{};
+            std::unique_lock lock{ m_mutex };
+            for(const google::protobuf::Descriptor* type : types)
+            {
+                const std::string name{ type->full_name() };
+                std::vector<std::pair<uint64_t, const google::protobuf::FieldDescriptor*>> annotated{};
+                for(int field{ 0 }; field < type->field_count(); ++field)
+                {
+                    const std::optional<uint64_t> position{ indexPosition(*type->field(field)) };
+                    if(position)
+                    {
+                        annotated.emplace_back(*position, type->field(field));
+                    }
+                }
+                if(annotated.empty())
+                {
+                    continue;
+                }
+                std::sort(annotated.begin(), annotated.end());
+                std::vector<const google::protobuf::FieldDescriptor*> fields{};
+                for(const auto& [position, field] : annotated)
+                {
+                    fields.push_back(field);
+                }
+
+                std::optional<rogue::driver::KeyLayout> layout{};
+                try
+                {
+                    layout.emplace(std::move(fields));
+                }
+                catch(const std::invalid_argument& error)
+                {
+                    return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, error.what() };
+                }
+                const auto previous{ m_tables.find(name) };
+                tables[name] = std::make_shared<const Table>(Table{
+                    pool,
+                    type,
+                    std::format("type.googleapis.com/{}", name),
+                    *layout,
+                    previous != m_tables.end() && previous->second->layout.matches(*layout)
+                        ? previous->second->rows
+                        : std::make_shared<rogue::driver::OrderedIndex>(m_shards) });
+            }
+            m_tables = std::move(tables);
+            return grpc::Status::OK;
+        }
+
+        // Null for types that are not subscribed or have no index.
+        std::shared_ptr<const Table> table(const std::string& typeUrl) const
+        {
+            const std::string name{ typeUrl.substr(typeUrl.rfind('/') + 1) };
+            std::shared_lock lock{ m_mutex };
+            const auto found{ m_tables.find(name) };
+            return found == m_tables.end() ? nullptr : found->second;
+        }
+
+    private:
+        // Copies an imported file, eg. google/protobuf/timestamp.proto, from the files compiled
+        // into the server. The pool has no underlay, so schemas may define types that are also
+        // compiled in, such as rogue.services.Test.
+        static bool import(google::protobuf::DescriptorPool& pool, const std::string& name)
+        {
+            if(pool.FindFileByName(name) != nullptr)
+            {
+                return true;
+            }
+            const google::protobuf::FileDescriptor* compiled{ google::protobuf::DescriptorPool::generated_pool()->FindFileByName(name) };
+            if(compiled == nullptr)
+            {
+                return false;
+            }
+            for(int dependency{ 0 }; dependency < compiled->dependency_count(); ++dependency)
+            {
+                if(!import(pool, std::string{ compiled->dependency(dependency)->name() }))
+                {
+                    return false;
+                }
+            }
+            google::protobuf::FileDescriptorProto file{};
+            compiled->CopyTo(&file);
+            return pool.BuildFile(file) != nullptr;
+        }
+
+        static void collect(const google::protobuf::Descriptor& type, std::vector<const google::protobuf::Descriptor*>& types)
+        {
+            types.push_back(&type);
+            for(int nested{ 0 }; nested < type.nested_type_count(); ++nested)
+            {
+                collect(*type.nested_type(nested), types);
+            }
+        }
+
+        const std::vector<std::string> m_builtIn;
+        const uint64_t m_shards;
+        mutable std::shared_mutex m_mutex{};
+        std::unordered_map<std::string, std::shared_ptr<const Table>> m_tables{};
+    };
+
+    struct Row
+    {
+        std::shared_ptr<const Table> table;
+        std::string value;
+    };
+
+    // Rows by type name and key, so results come out in key order and sets of rows from
+    // different expressions combine by key.
+    using Rows = std::map<std::string, Row>;
+
+    // One comparison of a Basic. Compares the whole key, or a single field when field is set.
+    struct Condition
+    {
+        ComparisonOperator comparison;
+        std::optional<rogue::driver::KeyLayout> field;
+        std::string value;
+
+        bool indexed() const
+        {
+            return !field && comparison != ComparisonOperator::NOT_EQUAL;
+        }
+
+        bool matches(const std::string& key, const std::string& row) const
+        {
+            const std::string compared{ field ? field->key(row) : key };
+            switch(comparison)
+            {
+                case ComparisonOperator::EQUAL:
+                    return compared == value;
+                case ComparisonOperator::NOT_EQUAL:
+                    return compared != value;
+                case ComparisonOperator::LESSER:
+                    return compared < value;
+                case ComparisonOperator::LESSER_EQUAL:
+                    return compared <= value;
+                case ComparisonOperator::GREATER:
+                    return compared > value;
+                case ComparisonOperator::GREATER_EQUAL:
+                    return compared >= value;
+                default:
+                    return false;
+            }
+        }
+
+        // Narrows range to the keys an indexed condition allows.
+        void narrow(rogue::driver::KeyRange& range) const
+        {
+            const bool lower{ comparison == ComparisonOperator::EQUAL
+                || comparison == ComparisonOperator::GREATER
+                || comparison == ComparisonOperator::GREATER_EQUAL };
+            const bool upper{ comparison == ComparisonOperator::EQUAL
+                || comparison == ComparisonOperator::LESSER
+                || comparison == ComparisonOperator::LESSER_EQUAL };
+            const bool inclusive{ comparison != ComparisonOperator::GREATER && comparison != ComparisonOperator::LESSER };
+            if(lower && (!range.lower || value > *range.lower || (value == *range.lower && !inclusive)))
+            {
+                range.lower = value;
+                range.lowerInclusive = inclusive;
+            }
+            if(upper && (!range.upper || value < *range.upper || (value == *range.upper && !inclusive)))
+            {
+                range.upper = value;
+                range.upperInclusive = inclusive;
+            }
+        }
+    };
+
+    // Conditions of a Basic on the table of its operands.
+    struct Selection
+    {
+        std::shared_ptr<const Table> table{};
+        std::vector<Condition> conditions{};
+    };
+
+    class Service final : public rogue::services::RogueDB::Service
+    {
+    public:
+        explicit Service(const rogue::driver::LocalOptions& options) :
+            m_catalog{ options.schemas, options.shards },
+            m_maxResults{ std::max<uint64_t>(options.maxResults, 1) },
+            m_apiKey{ options.apiKey }
+        {}
+
+        grpc::Status insert(grpc::ServerContext*, grpc::ServerReaderWriter<rogue::services::Response, rogue::services::Insert>* stream) override
+        {
+            return writes(stream, Operation::INSERT);
+        }
+
+        grpc::Status update(grpc::ServerContext*, grpc::ServerReaderWriter<rogue::services::Response, rogue::services::Update>* stream) override
+        {
+            return writes(stream, Operation::UPDATE);
+        }
+
+        grpc::Status remove(grpc::ServerContext*, grpc::ServerReaderWriter<rogue::services::Response, rogue::services::Remove>* stream) override
+        {
+            return writes(stream, Operation::REMOVE);
+        }
+
+        grpc::Status search(grpc::ServerContext*, grpc::ServerReaderWriter<rogue::services::Response, rogue::services::Search>* stream) override
+        {
+            rogue::services::Search search{};
+            rogue::services::Response response{};
+            while(stream->Read(&search))
+            {
+                grpc::Status status{ authorize(search.api_key()) };
+                if(!status.ok())
+                {
+                    return status;
+                }
+                response.Clear();
+                uint64_t count{ 0 };
+                for(int query{ 0 }; query < search.queries_size(); ++query)
+                {
+                    Messages* messages{ (*response.mutable_results())[query].mutable_messages() };
+                    bool open{ true };
+                    status = results(search.queries(query), [&](const Table& table, std::string& value)
+                    {
+                        if(count == m_maxResults)
+                        {
+                            open = stream->Write(response);
+                            if(!open)
+                            {
+                                return false;
+                            }
+                            response.Clear();
+                            count = 0;
+                            messages = (*response.mutable_results())[query].mutable_messages();
+                        }
+                        Any* message{ messages->Add() };
+                        message->set_type_url(table.typeUrl);
+                        message->set_value(std::move(value));
+                        ++count;
+                        return true;
+                    });
+                    if(!open)
+                    {
+                        return grpc::Status{ grpc::StatusCode::CANCELLED, "Stream closed." };
+                    }
+                    if(!status.ok())
+                    {
+                        return status;
+                    }
+                    response.add_finished(query);
+                }
+                if(!stream->Write(response))
+                {
+                    return grpc::Status{ grpc::StatusCode::CANCELLED, "Stream closed." };
+                }
+            }
+            return grpc::Status::OK;
+        }
+
+        grpc::Status subscribe(grpc::ServerContext*, const rogue::services::Subscribe* request, rogue::services::Response*) override
+        {
+            const grpc::Status status{ authorize(request->api_key()) };
+            return status.ok() ? m_catalog.subscribe(request->schemas()) : status;
+        }
+
+        grpc::Status rest_insert(grpc::ServerContext*, const rogue::services::Insert* request, rogue::services::Response*) override
+        {
+            return write(*request, Operation::INSERT);
+        }
+
+        grpc::Status rest_update(grpc::ServerContext*, const rogue::services::Update* request, rogue::services::Response*) override
+        {
+            return write(*request, Operation::UPDATE);
+        }
+
+        grpc::Status rest_remove(grpc::ServerContext*, const rogue::services::Remove* request, rogue::services::Response*) override
+        {
+            return write(*request, Operation::REMOVE);
+        }
+
+        grpc::Status rest_search(grpc::ServerContext*, const rogue::services::Search* request, rogue::services::Response* response) override
+        {
+            grpc::Status status{ authorize(request->api_key()) };
+            for(int query{ 0 }; status.ok() && query < request->queries_size(); ++query)
+            {
+                Messages* messages{ (*response->mutable_results())[query].mutable_messages() };
+                status = results(request->queries(query), [messages](const Table& table, std::string& value)
+                {
+                    Any* message{ messages->Add() };
+                    message->set_type_url(table.typeUrl);
+                    message->set_value(std::move(value));
+                    return true;
+                });
+                response->add_finished(query);
+            }
+            return status;
+        }
+
+        grpc::Status complete(grpc::ServerContext*, const rogue::services::Insert* request, rogue::services::Response*) override
+        {
+            return authorize(request->api_key());
+        }
+
+    private:
+        enum class Operation
+        {
+            INSERT,
+            UPDATE,
+            REMOVE
+        };
+
+        grpc::Status authorize(const std::string& apiKey) const
+        {
+            return m_apiKey.empty() || apiKey == m_apiKey
+                ? grpc::Status::OK
+                : grpc::Status{ grpc::StatusCode::UNAUTHENTICATED, "Invalid api key." };
+        }
+
+        template<typename Request>
+        grpc::Status writes(grpc::ServerReaderWriter<rogue::services::Response, Request>* stream, const Operation operation)
+        {
+            Request request{};
+            while(stream->Read(&request))
+            {
+                const grpc::Status status{ write(request, operation) };
+                if(!status.ok())
+                {
+                    return status;
+                }
+            }
+            return grpc::Status::OK;
+        }
+
+        template<typename Request>
+        grpc::Status write(const Request& request, const Operation operation)
+        {
+            const grpc::Status status{ authorize(request.api_key()) };
+            if(!status.ok())
+            {
+                return status;
+            }
+            for(const Any& message : request.messages())
+            {
+                const std::shared_ptr<const Table> table{ m_catalog.table(message.type_url()) };
+                if(!table)
+                {
+                    return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, std::format("{} is not subscribed with an index.", message.type_url()) };
+                }
+                std::string key{};
+                try
+                {
+                    key = table->layout.key(message.value());
+                }
+                catch(const std::invalid_argument& error)
+                {
+                    return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, std::format("{}: {}", message.type_url(), error.what()) };
+                }
+                switch(operation)
+                {
+                    case Operation::INSERT:
+                        table->rows->put(key, message.value());
+                        break;
+                    case Operation::UPDATE:
+                        table->rows->replace(key, message.value());
+                        break;
+                    case Operation::REMOVE:
+                        table->rows->remove(key);
+                        break;
+                }
+            }
+            return grpc::Status::OK;
+        }
+
+        // Calls emit(table, value) for every row of the query in key order, until it returns
+        // false. A Basic without OR streams from the index a page at a time, so a scan holds
+        // at most maxResults rows. Other queries combine their rows by key first.
+        template<typename Emit>
+        grpc::Status results(const rogue::services::Query& query, Emit&& emit) const
+        {
+            try
+            {
+                if(query.expression_case() == rogue::services::Query::kBasic && query.basic().logical_operator() != rogue::services::LogicalOperator::OR)
+                {
+                    const Selection selected{ selection(query.basic()) };
+                    if(selected.table)
+                    {
+                        select(*selected.table, selected.conditions,
+                            [&](const std::string&, std::string& row){ return emit(*selected.table, row); });
+                    }
+                    return grpc::Status::OK;
+                }
+                for(auto& [key, row] : evaluate(query))
+                {
+                    if(!emit(*row.table, row.value))
+                    {
+                        break;
+                    }
+                }
+                return grpc::Status::OK;
+            }
+            catch(const std::invalid_argument& error)
+            {
+                return grpc::Status{ grpc::StatusCode::INVALID_ARGUMENT, error.what() };
+            }
+        }
+
+        Rows evaluate(const rogue::services::Query& query) const
+        {
+            switch(query.expression_case())
+            {
+                case rogue::services::Query::kBasic:
+                    return evaluate(query.basic());
+                case rogue::services::Query::kComplex:
+                    return evaluate(query.complex());
+                case rogue::services::Query::kCompositional:
+                    throw std::invalid_argument{ "Compositional expressions are not supported." };
+                default:
+                    throw std::invalid_argument{ "Empty expression." };
+            }
+        }
+
+        Rows evaluate(const rogue::services::Complex& complex) const
+        {
+            Rows rows{};
+            for(int index{ 0 }; index < complex.expressions_size(); ++index)
+            {
+                Rows next{ evaluate(complex.expressions(index)) };
+                if(complex.logical_operator() == rogue::services::LogicalOperator::OR)
+                {
+                    rows.merge(next);
+                }
+                else if(index == 0)
+                {
+                    rows = std::move(next);
+                }
+                else
+                {
+                    std::erase_if(rows, [&next](const auto& row){ return !next.contains(row.first); });
+                }
+            }
+            return rows;
+        }
+
+        // OR runs every condition on its own and merges the rows.
+        Rows evaluate(const rogue::services::Basic& basic) const
+        {
+            Rows rows{};
+            const Selection selected{ selection(basic) };
+            if(!selected.table)
+            {
+                return rows;
+            }
+            const std::string prefix{ std::format("{}{}", selected.table->descriptor->full_name(), '\0') };
+            const auto add = [&](const std::string& key, std::string& row)
+            {
+                rows.emplace(prefix + key, Row{ selected.table, std::move(row) });
+                return true;
+            };
+            if(basic.logical_operator() == rogue::services::LogicalOperator::OR)
+            {
+                for(const Condition& condition : selected.conditions)
+                {
+                    select(*selected.table, { condition }, add);
+                }
+                return rows;
+            }
+            select(*selected.table, selected.conditions, add);
+            return rows;
+        }
+
+        // Parses the operands of a Basic into conditions on their table. Without operands,
+        // the table is null.
+        Selection selection(const rogue::services::Basic& basic) const
+        {
+            Selection selected{};
+            if(basic.operands_size() == 0)
+            {
+                return selected;
+            }
+            if(basic.comparisons_size() != basic.operands_size() || (basic.fields_size() != 0 && basic.fields_size() != basic.operands_size()))
+            {
+                throw std::invalid_argument{ "A Basic needs one comparison, and one field if any, per operand." };
+            }
+            selected.table = m_catalog.table(basic.operands(0).type_url());
+            const std::shared_ptr<const Table>& table{ selected.table };
+            if(!table)
+            {
+                throw std::invalid_argument{ std::format("{} is not subscribed with an index.", basic.operands(0).type_url()) };
+            }
+
+            std::vector<Condition>& conditions{ selected.conditions };
+            for(int index{ 0 }; index < basic.operands_size(); ++index)
+            {
+                const Any& operand{ basic.operands(index) };
+                if(operand.type_url() != basic.operands(0).type_url())
+                {
+                    throw std::invalid_argument{ "Operands of a Basic must share their type." };
+                }
+                const ComparisonOperator comparison{ basic.comparisons(index) };
+                if(comparison == ComparisonOperator::COMPARISON_OPERATOR_UNKNOWN || !rogue::services::ComparisonOperator_IsValid(comparison))
+                {
+                    throw std::invalid_argument{ "Unknown comparison." };
+                }
+                Condition& condition{ conditions.emplace_back(Condition{ comparison, std::nullopt, {} }) };
+                if(basic.fields_size() != 0)
+                {
+                    const google::protobuf::FieldDescriptor* field{ table->descriptor->FindFieldByNumber(basic.fields(index)) };
+                    if(field == nullptr)
+                    {
+                        throw std::invalid_argument{ std::format("{} has no field {}.", table->descriptor->full_name(), basic.fields(index)) };
+                    }
+                    condition.field.emplace(std::vector<const google::protobuf::FieldDescriptor*>{ field });
+                }
+                condition.value = condition.field ? condition.field->key(operand.value()) : table->layout.key(operand.value());
+            }
+
+            return selected;
+        }
+
+        // Calls visit(key, row) for the rows of the table that meet every condition, in key
+        // order, until it returns false. AND scans the key range the indexed conditions allow
+        // and filters by the others. Rows are copied out of the index a page of maxResults at
+        // a time and visited with no lock held, so visit may block, eg. on the stream.
+        template<typename Visit>
+        void select(const Table& table, const std::vector<Condition>& conditions, Visit&& visit) const
+        {
+            rogue::driver::KeyRange range{};
+            std::vector<const Condition*> filters{};
+            for(const Condition& condition : conditions)
+            {
+                if(condition.indexed())
+                {
+                    condition.narrow(range);
+                }
+                else
+                {
+                    filters.push_back(&condition);
+                }
+            }
+
+            std::vector<std::pair<std::string, std::string>> page{};
+            while(true)
+            {
+                page.clear();
+                table.rows->scan(range,
+                    [&](const std::string& key, const std::string& row)
+                    {
+                        for(const Condition* filter : filters)
+                        {
+                            if(!filter->matches(key, row))
+                            {
+                                return true;
+                            }
+                        }
+                        page.emplace_back(key, row);
+                        return page.size() < m_maxResults;
+                    });
+                if(page.empty())
+                {
+                    return;
+                }
+                range.lower = page.back().first;
+                range.lowerInclusive = false;
+                for(auto& [key, row] : page)
+                {
+                    if(!visit(key, row))
+                    {
+                        return;
+                    }
+                }
+                if(page.size() < m_maxResults)
+                {
+                    return;
+                }
+            }
+        }
+
+        Catalog m_catalog;
+        const uint64_t m_maxResults;
+        const std::string m_apiKey;
+    };
+}
+
+rogue::driver::LocalRogueDB::LocalRogueDB(const LocalOptions& options) :
+    m_service{ std::make_unique<Service>(options) }
+{
+    grpc::ServerBuilder builder{};
+    for(const uint32_t port : options.ports)
+    {
+        builder.AddListeningPort(std::format("{}:{}", options.address, port), grpc::InsecureServerCredentials());
+    }
+    if(options.threads > 0)
+    {
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::NUM_CQS, static_cast<int>(options.threads));
+        builder.SetSyncServerOption(grpc::ServerBuilder::SyncServerOption::MAX_POLLERS, static_cast<int>(options.threads));
+    }
+    builder.RegisterService(m_service.get());
+    m_server = builder.BuildAndStart();
+    if(!m_server)
+    {
+        throw std::runtime_error{ std::format("Could not listen on {}.", options.address) };
+    }
+}
+
+rogue::driver::LocalRogueDB::~LocalRogueDB()
+{
+    shutdown();
+}
+
+void rogue::driver::LocalRogueDB::wait()
+{
+    m_server->Wait();
+}
+
+void rogue::driver::LocalRogueDB::shutdown()
+{
+    if(m_stopped)
+    {
+        return;
+    }
+    m_stopped = true;
+    m_server->Shutdown();
+}
@@ -0,0 +1,65 @@
+#ifndef LOCAL_ROGUEDB_H
+#define LOCAL_ROGUEDB_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+
+namespace rogue
+{
+    namespace driver
+    {
+        struct LocalOptions
+        {
+            std::string address{ "0.0.0.0" };
+            std::vector<uint32_t> ports{ 80 };
+            // Shards every table aims for, see OrderedIndex.
+            uint64_t shards{ 64 };
+            // Results per Response before a partial Response is sent.
+            uint64_t maxResults{ 1000 };
+            // Requests with any other api key are rejected. Any key is accepted when empty.
+            std::string apiKey{};
+            // Contents of .proto files available as if built into the service. Subscribe
+            // never removes them or their data.
+            std::vector<std::string> schemas{};
+            // Completion queues and maximum pollers of gRPC's sync server. Its default when 0.
+            uint64_t threads{ 0 };
+        };
+
+        // In-memory stand-in for RogueDB on the same gRPC contract, for testing clients
+        // without the hosted service. Data lives only as long as the server.
+        //  - subscribe parses the schemas and keys each message type by its fields annotated
+        //    //index-N, in order of N. Types without annotations are rejected. A failed
+        //    subscribe changes nothing, and types left out lose their data.
+        //  - insert writes, update overwrites existing rows only, remove deletes by key. None
+        //    of them respond and errors end the stream with a status.
+        //  - search answers Basic queries, and Complex ones made of them. Without fields, an
+        //    operand compares by the whole key. With fields, operand i compares only by field
+        //    fields[i]. Results go out in Responses of at most maxResults messages each, the
+        //    last of a Search listing its finished queries. A Basic without OR is streamed
+        //    from the index a Response at a time, so a range scan is never held in full.
+        //  - The rest_ methods do the same unary, with every result in one Response.
+        //  - complete returns at once, since writes are applied before they are acknowledged.
+        class LocalRogueDB
+        {
+        public:
+            explicit LocalRogueDB(const LocalOptions& options);
+            ~LocalRogueDB();
+            LocalRogueDB(const LocalRogueDB&) = delete;
+            LocalRogueDB& operator=(const LocalRogueDB&) = delete;
+
+            // Blocks until shutdown.
+            void wait();
+            void shutdown();
+
+        private:
+            std::unique_ptr<grpc::Service> m_service{};
+            std::unique_ptr<grpc::Server> m_server{};
+            bool m_stopped{ false };
+        };
+    }
+}
+
+#endif //LOCAL_ROGUEDB_H
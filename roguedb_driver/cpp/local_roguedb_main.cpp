@@ -0,0 +1,128 @@
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "roguedb_driver/cpp/local_roguedb.h"
+
+namespace
+{
+    std::vector<std::string> split(const std::string& list)
+    {
+        std::vector<std::string> parts{};
+        std::stringstream stream{ list };
+        for(std::string part{}; std::getline(stream, part, ',');)
+        {
+            if(!part.empty())
+            {
+                parts.push_back(part);
+            }
+        }
+        return parts;
+    }
+
+    // Contents of a .proto file, or of every .proto file below a directory.
+    void readSchemas(const std::filesystem::path& path, std::vector<std::string>& schemas)
+    {
+        if(std::filesystem::is_directory(path))
+        {
+            for(const auto& entry : std::filesystem::recursive_directory_iterator{ path })
+            {
+                if(!entry.is_directory() && entry.path().extension() == ".proto")
+                {
+                    readSchemas(entry.path(), schemas);
+                }
+            }
+            return;
+        }
+        std::ifstream file{ path };
+        if(!file)
+        {
+            throw std::invalid_argument{ std::format("Cannot read {}.", path.string()) };
+        }
+        std::stringstream buffer{};
+        buffer << file.rdbuf();
+        schemas.push_back(buffer.str());
+    }
+
+    rogue::driver::LocalOptions parseOptions(int argc, char** argv)
+    {
+        rogue::driver::LocalOptions options{};
+        for(int index{ 1 }; index < argc; ++index)
+        {
+            const std::string argument{ argv[index] };
+            if(argument.starts_with("--ports="))
+            {
+                options.ports.clear();
+                for(const std::string& port : split(argument.substr(8)))
+                {
+                    options.ports.push_back(static_cast<uint32_t>(std::stoul(port)));
+                }
+            }
+            else if(argument.starts_with("--shards="))
+            {
+                options.shards = std::stoull(argument.substr(9));
+            }
+            else if(argument.starts_with("--maxresults="))
+            {
+                options.maxResults = std::stoull(argument.substr(13));
+            }
+            else if(argument.starts_with("--apikey="))
+            {
+                options.apiKey = argument.substr(9);
+            }
+            else if(argument.starts_with("--schemas="))
+            {
+                for(const std::string& path : split(argument.substr(10)))
+                {
+                    readSchemas(path, options.schemas);
+                }
+            }
+            else if(argument.starts_with("--threads="))
+            {
+                options.threads = std::stoull(argument.substr(10));
+            }
+            else if(argument.starts_with("--"))
+            {
+                throw std::invalid_argument{ std::format("Unknown option: {}", argument) };
+            }
+            else
+            {
+                options.address = argument;
+            }
+        }
+        if(options.ports.empty())
+        {
+            throw std::invalid_argument{ "ports must not be empty." };
+        }
+        return options;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    rogue::driver::LocalOptions options{};
+    try
+    {
+        options = parseOptions(argc, argv);
+        rogue::driver::LocalRogueDB server{ options };
+        std::cout << "Serving RogueDB on " << options.address << " port(s)";
+        for(const uint32_t port : options.ports)
+        {
+            std::cout << " " << port;
+        }
+        std::cout << std::endl;
+        server.wait();
+    }
+    catch(const std::exception& error)
+    {
+        std::cerr << error.what() << std::endl
+            << "Usage: " << argv[0] << " [address] [--ports=80] [--schemas=file.proto,directory] [--shards=64]"
+            << " [--maxresults=1000] [--apikey=key] [--threads=0]" << std::endl;
+        return 2;
+    }
+    return 0;
+}
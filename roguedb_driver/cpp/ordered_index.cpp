@@ -0,0 +1,347 @@
+#include <algorithm>
+#include <bit>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <google/protobuf/io/coded_stream.h>
+
+#include "roguedb_driver/cpp/ordered_index.h"
+
+namespace
+{
+    using FieldDescriptor = google::protobuf::FieldDescriptor;
+
+    constexpr uint32_t VARINT{ 0 };
+    constexpr uint32_t FIXED64{ 1 };
+    constexpr uint32_t LENGTH_DELIMITED{ 2 };
+    constexpr uint32_t FIXED32{ 5 };
+
+    void appendBigEndian(std::string& key, const uint64_t value)
+    {
+        for(int shift{ 56 }; shift >= 0; shift -= 8)
+        {
+            key.push_back(static_cast<char>((value >> shift) & 0xFF));
+        }
+    }
+
+    void appendSigned(std::string& key, const int64_t value)
+    {
+        appendBigEndian(key, static_cast<uint64_t>(value) ^ (uint64_t{1} << 63));
+    }
+
+    void appendDouble(std::string& key, const double value)
+    {
+        const uint64_t bits{ std::bit_cast<uint64_t>(value == 0 ? 0.0 : value) };
+        appendBigEndian(key, (bits >> 63) != 0 ? ~bits : bits ^ (uint64_t{1} << 63));
+    }
+
+    // 0x00 becomes 0x00 0xFF and the end is 0x00 0x01, so a prefix orders before any longer
+    // string and later fields never bleed into the comparison.
+    void appendString(std::string& key, const std::string_view value)
+    {
+        for(const char character : value)
+        {
+            key.push_back(character);
+            if(character == '\0')
+            {
+                key.push_back('\xFF');
+            }
+        }
+        key.push_back('\0');
+        key.push_back('\x01');
+    }
+
+    uint32_t wireType(const FieldDescriptor::Type type)
+    {
+        switch(type)
+        {
+            case FieldDescriptor::TYPE_FIXED64:
+            case FieldDescriptor::TYPE_SFIXED64:
+            case FieldDescriptor::TYPE_DOUBLE:
+                return FIXED64;
+            case FieldDescriptor::TYPE_FIXED32:
+            case FieldDescriptor::TYPE_SFIXED32:
+            case FieldDescriptor::TYPE_FLOAT:
+                return FIXED32;
+            case FieldDescriptor::TYPE_STRING:
+            case FieldDescriptor::TYPE_BYTES:
+                return LENGTH_DELIMITED;
+            default:
+                return VARINT;
+        }
+    }
+
+    // Raw wire value of one key field, the last one seen as the parser would keep it.
+    struct Value
+    {
+        uint64_t number{ 0 };
+        std::string_view bytes{};
+    };
+
+    void appendValue(std::string& key, const FieldDescriptor& field, const Value& value)
+    {
+        switch(field.type())
+        {
+            case FieldDescriptor::TYPE_INT32:
+            case FieldDescriptor::TYPE_INT64:
+            case FieldDescriptor::TYPE_ENUM:
+            case FieldDescriptor::TYPE_SFIXED64:
+                appendSigned(key, static_cast<int64_t>(value.number));
+                break;
+            case FieldDescriptor::TYPE_SFIXED32:
+                appendSigned(key, static_cast<int32_t>(static_cast<uint32_t>(value.number)));
+                break;
+            case FieldDescriptor::TYPE_SINT32:
+            case FieldDescriptor::TYPE_SINT64:
+                appendSigned(key, static_cast<int64_t>((value.number >> 1) ^ (~(value.number & 1) + 1)));
+                break;
+            case FieldDescriptor::TYPE_UINT32:
+            case FieldDescriptor::TYPE_UINT64:
+            case FieldDescriptor::TYPE_FIXED32:
+            case FieldDescriptor::TYPE_FIXED64:
+                appendBigEndian(key, value.number);
+                break;
+            case FieldDescriptor::TYPE_BOOL:
+                key.push_back(value.number != 0 ? '\x01' : '\0');
+                break;
+            case FieldDescriptor::TYPE_DOUBLE:
+                appendDouble(key, std::bit_cast<double>(value.number));
+                break;
+            case FieldDescriptor::TYPE_FLOAT:
+                appendDouble(key, std::bit_cast<float>(static_cast<uint32_t>(value.number)));
+                break;
+            case FieldDescriptor::TYPE_STRING:
+            case FieldDescriptor::TYPE_BYTES:
+                appendString(key, value.bytes);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+rogue::driver::KeyLayout::KeyLayout(std::vector<const google::protobuf::FieldDescriptor*> fields) :
+    m_fields{ std::move(fields) }
+{
+    if(m_fields.empty())
+    {
+        throw std::invalid_argument{ "A key needs at least one field." };
+    }
+    for(const FieldDescriptor* field : m_fields)
+    {
+        if(field->is_repeated() || field->type() == FieldDescriptor::TYPE_MESSAGE || field->type() == FieldDescriptor::TYPE_GROUP)
+        {
+            throw std::invalid_argument{ std::format("{} cannot be part of a key.", field->full_name()) };
+        }
+    }
+}
+
+std::string rogue::driver::KeyLayout::key(const std::string_view serialized) const
+{
+    std::vector<Value> values(m_fields.size());
+    google::protobuf::io::CodedInputStream input{
+        reinterpret_cast<const uint8_t*>(serialized.data()), static_cast<int>(serialized.size()) };
+    for(uint32_t tag{ input.ReadTag() }; tag != 0; tag = input.ReadTag())
+    {
+        const uint32_t number{ tag >> 3 };
+        const uint32_t type{ tag & 0x7 };
+        uint64_t index{ 0 };
+        while(index < m_fields.size() && static_cast<uint32_t>(m_fields[index]->number()) != number)
+        {
+            ++index;
+        }
+        const bool keyed{ index < m_fields.size() && wireType(m_fields[index]->type()) == type };
+
+        uint64_t number64{ 0 };
+        uint32_t number32{ 0 };
+        uint32_t length{ 0 };
+        bool read{ true };
+        switch(type)
+        {
+            case VARINT:
+                read = input.ReadVarint64(&number64);
+                break;
+            case FIXED64:
+                read = input.ReadLittleEndian64(&number64);
+                break;
+            case FIXED32:
+                read = input.ReadLittleEndian32(&number32);
+                number64 = number32;
+                break;
+            case LENGTH_DELIMITED:
+            {
+                read = input.ReadVarint32(&length);
+                const int position{ input.CurrentPosition() };
+                read = read && input.Skip(static_cast<int>(length));
+                if(read && keyed)
+                {
+                    values[index].bytes = serialized.substr(position, length);
+                }
+                break;
+            }
+            default:
+                read = false;
+        }
+        if(!read)
+        {
+            throw std::invalid_argument{ "Malformed message." };
+        }
+        if(keyed && type != LENGTH_DELIMITED)
+        {
+            values[index].number = number64;
+        }
+    }
+    if(!input.ConsumedEntireMessage())
+    {
+        throw std::invalid_argument{ "Malformed message." };
+    }
+
+    std::string key{};
+    for(uint64_t index{ 0 }; index < m_fields.size(); ++index)
+    {
+        appendValue(key, *m_fields[index], values[index]);
+    }
+    return key;
+}
+
+bool rogue::driver::KeyLayout::matches(const KeyLayout& other) const
+{
+    if(m_fields.size() != other.m_fields.size())
+    {
+        return false;
+    }
+    for(uint64_t index{ 0 }; index < m_fields.size(); ++index)
+    {
+        if(m_fields[index]->number() != other.m_fields[index]->number() || m_fields[index]->type() != other.m_fields[index]->type())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool rogue::driver::KeyRange::empty() const
+{
+    if(!lower || !upper)
+    {
+        return false;
+    }
+    return *lower > *upper || (*lower == *upper && !(lowerInclusive && upperInclusive));
+}
+
+bool rogue::driver::KeyRange::contains(const std::string& key) const
+{
+    if(lower && (lowerInclusive ? key < *lower : key <= *lower))
+    {
+        return false;
+    }
+    return !upper || (upperInclusive ? key <= *upper : key < *upper);
+}
+
+rogue::driver::OrderedIndex::OrderedIndex(const uint64_t shards) :
+    m_target{ std::max<uint64_t>(shards, 1) }
+{
+    m_bounds.emplace_back();
+    m_shards.push_back(std::make_unique<Shard>());
+}
+
+void rogue::driver::OrderedIndex::put(const std::string& key, std::string row)
+{
+    bool grown{ false };
+    {
+        std::shared_lock shards{ m_mutex };
+        Shard& target{ *m_shards[shardIndex(key)] };
+        std::unique_lock lock{ target.mutex };
+        if(target.rows.insert_or_assign(key, std::move(row)).second)
+        {
+            m_rows.fetch_add(1, std::memory_order_relaxed);
+            grown = oversized(target.rows.size());
+        }
+    }
+    if(grown)
+    {
+        split(key);
+    }
+}
+
+bool rogue::driver::OrderedIndex::replace(const std::string& key, std::string row)
+{
+    std::shared_lock shards{ m_mutex };
+    Shard& target{ *m_shards[shardIndex(key)] };
+    std::unique_lock lock{ target.mutex };
+    const auto position{ target.rows.find(key) };
+    if(position == target.rows.end())
+    {
+        return false;
+    }
+    position->second = std::move(row);
+    return true;
+}
+
+bool rogue::driver::OrderedIndex::remove(const std::string& key)
+{
+    std::shared_lock shards{ m_mutex };
+    Shard& target{ *m_shards[shardIndex(key)] };
+    std::unique_lock lock{ target.mutex };
+    if(target.rows.erase(key) == 0)
+    {
+        return false;
+    }
+    m_rows.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::optional<std::string> rogue::driver::OrderedIndex::find(const std::string& key) const
+{
+    std::shared_lock shards{ m_mutex };
+    const Shard& target{ *m_shards[shardIndex(key)] };
+    std::shared_lock lock{ target.mutex };
+    const auto position{ target.rows.find(key) };
+    if(position == target.rows.end())
+    {
+        return std::nullopt;
+    }
+    return position->second;
+}
+
+uint64_t rogue::driver::OrderedIndex::size() const
+{
+    return m_rows.load(std::memory_order_relaxed);
+}
+
+uint64_t rogue::driver::OrderedIndex::shards() const
+{
+    std::shared_lock shards{ m_mutex };
+    return m_shards.size();
+}
+
+uint64_t rogue::driver::OrderedIndex::shardIndex(const std::string& key) const
+{
+    return static_cast<uint64_t>(std::upper_bound(m_bounds.begin(), m_bounds.end(), key) - m_bounds.begin()) - 1;
+}
+
+bool rogue::driver::OrderedIndex::oversized(const uint64_t rows) const
+{
+    return rows > std::max(MIN_SPLIT_ROWS, 2 * m_rows.load(std::memory_order_relaxed) / m_target);
+}
+
+void rogue::driver::OrderedIndex::split(const std::string& key)
+{
+    std::unique_lock shards{ m_mutex };
+    const uint64_t index{ shardIndex(key) };
+    Shard& full{ *m_shards[index] };
+    if(!oversized(full.rows.size()))
+    {
+        return;
+    }
+    // Moves the upper half node by node, so rows are not copied.
+    std::unique_ptr<Shard> upper{ std::make_unique<Shard>() };
+    auto position{ std::next(full.rows.begin(), static_cast<std::ptrdiff_t>(full.rows.size() / 2)) };
+    while(position != full.rows.end())
+    {
+        upper->rows.insert(upper->rows.end(), full.rows.extract(position++));
+    }
+    m_bounds.insert(m_bounds.begin() + static_cast<std::ptrdiff_t>(index) + 1, upper->rows.begin()->first);
+    m_shards.insert(m_shards.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(upper));
+}
@@ -0,0 +1,140 @@
+#ifndef ORDERED_INDEX_H
+#define ORDERED_INDEX_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <google/protobuf/descriptor.h>
+
+namespace rogue
+{
+    namespace driver
+    {
+        // Fields of a message type that form a key, in order. Keys are encoded so that
+        // comparing them bytewise orders them as their fields would compare, one field after
+        // the other: integers big endian with the sign bit flipped, floating point by their
+        // IEEE bits, strings and bytes escaped and terminated.
+        class KeyLayout
+        {
+        public:
+            // Singular integer, bool, enum, floating point, string, or bytes fields.
+            // Throws std::invalid_argument otherwise.
+            explicit KeyLayout(std::vector<const google::protobuf::FieldDescriptor*> fields);
+
+            // Key of a serialized message, read from its wire bytes without parsing the
+            // message. Absent fields take their default. Throws std::invalid_argument on
+            // malformed bytes.
+            std::string key(std::string_view serialized) const;
+
+            const std::vector<const google::protobuf::FieldDescriptor*>& fields() const { return m_fields; }
+            // Same field numbers and types, so keys of one layout are valid for the other.
+            bool matches(const KeyLayout& other) const;
+
+        private:
+            std::vector<const google::protobuf::FieldDescriptor*> m_fields{};
+        };
+
+        // Bounds of a scan. An absent bound is open.
+        struct KeyRange
+        {
+            std::optional<std::string> lower{};
+            bool lowerInclusive{ true };
+            std::optional<std::string> upper{};
+            bool upperInclusive{ true };
+
+            bool empty() const;
+            bool contains(const std::string& key) const;
+        };
+
+        // Serialized rows of one message type by key. The key space is split into ranges,
+        // each shard an ordered map of one range behind its own reader-writer lock, so writers
+        // of different keys rarely contend and a scan only visits the shards its range
+        // overlaps, in key order. A shard that outgrows twice its share of the rows, and at
+        // least MIN_SPLIT_ROWS, is split at its median key, so about shards shards hold the
+        // rows whatever their key distribution. Splitting briefly blocks every operation.
+        // Shards are never merged, so an index keeps its shards after rows are removed.
+        class OrderedIndex
+        {
+        public:
+            static constexpr uint64_t MIN_SPLIT_ROWS{ 1024 };
+
+            explicit OrderedIndex(const uint64_t shards);
+
+            // Inserts or overwrites.
+            void put(const std::string& key, std::string row);
+            // Overwrites an existing row only. Returns whether it existed.
+            bool replace(const std::string& key, std::string row);
+            bool remove(const std::string& key);
+            std::optional<std::string> find(const std::string& key) const;
+            uint64_t size() const;
+            uint64_t shards() const;
+
+            // Calls visit(key, row) for the rows in range in key order, until it returns false.
+            // Shards are locked shared while they are visited, so keep visit short, eg. copy
+            // a page of rows and resume after its last key.
+            template<typename Visit>
+            void scan(const KeyRange& range, Visit&& visit) const
+            {
+                if(range.empty())
+                {
+                    return;
+                }
+                std::shared_lock shards{ m_mutex };
+                for(uint64_t index{ range.lower ? shardIndex(*range.lower) : 0 }; index < m_shards.size(); ++index)
+                {
+                    if(range.upper && (range.upperInclusive ? m_bounds[index] > *range.upper : m_bounds[index] >= *range.upper))
+                    {
+                        return;
+                    }
+                    const Shard& shard{ *m_shards[index] };
+                    std::shared_lock lock{ shard.mutex };
+                    auto position{ !range.lower
+                        ? shard.rows.begin()
+                        : range.lowerInclusive
+                            ? shard.rows.lower_bound(*range.lower)
+                            : shard.rows.upper_bound(*range.lower) };
+                    for(; position != shard.rows.end(); ++position)
+                    {
+                        if(range.upper && (range.upperInclusive ? position->first > *range.upper : position->first >= *range.upper))
+                        {
+                            return;
+                        }
+                        if(!visit(position->first, position->second))
+                        {
+                            return;
+                        }
+                    }
+                }
+            }
+
+        private:
+            struct Shard
+            {
+                mutable std::shared_mutex mutex{};
+                std::map<std::string, std::string, std::less<>> rows{};
+            };
+
+            // Shard whose range holds key. Call with m_mutex held.
+            uint64_t shardIndex(const std::string& key) const;
+            bool oversized(const uint64_t rows) const;
+            // Splits the shard holding key if it is still oversized.
+            void split(const std::string& key);
+
+            const uint64_t m_target;
+            // Guards the shard list. Shard index holds the keys from m_bounds[index] up to
+            // m_bounds[index + 1], and m_bounds[0] is empty.
+            mutable std::shared_mutex m_mutex{};
+            std::vector<std::string> m_bounds{};
+            std::vector<std::unique_ptr<Shard>> m_shards{};
+            std::atomic<uint64_t> m_rows{ 0 };
+        };
+    }
+}
+
+#endif //ORDERED_INDEX_H
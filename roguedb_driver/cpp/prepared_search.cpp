@@ -0,0 +1,232 @@
+#include <format>
+#include <map>
+#include <stdexcept>
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/support/sync_stream.h>
+
+#include "roguedb_driver/cpp/prepared_search.h"
+
+namespace
+{
+    constexpr char SEARCH_METHOD[]{ "/rogue.services.RogueDB/search" };
+    constexpr uint64_t VARINT_BYTES{ 10 };
+
+    using FieldDescriptor = google::protobuf::FieldDescriptor;
+
+    uint64_t varintSize(const uint64_t value)
+    {
+        return google::protobuf::io::CodedOutputStream::VarintSize64(value);
+    }
+
+    void writeVarint(std::string& destination, uint64_t value)
+    {
+        while(value >= 0x80)
+        {
+            destination.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        destination.push_back(static_cast<char>(value));
+    }
+
+    // Bytes in front of the contents of a length delimited field, or of its element at index
+    // when repeated. Fields are written in field number order, so that is every lower field,
+    // the elements before index, and the field's own tag and length.
+    uint64_t contentOffset(const google::protobuf::Message& message, const int number, const int index = -1)
+    {
+        const FieldDescriptor* field{ message.GetDescriptor()->FindFieldByNumber(number) };
+        const google::protobuf::Reflection* reflection{ message.GetReflection() };
+        const uint64_t contentSize{ field->type() == FieldDescriptor::TYPE_MESSAGE
+            ? (field->is_repeated()
+                ? reflection->GetRepeatedMessage(message, field, index).ByteSizeLong()
+                : reflection->GetMessage(message, field).ByteSizeLong())
+            : reflection->GetString(message, field).size() };
+
+        std::unique_ptr<google::protobuf::Message> prefix{ message.New() };
+        prefix->CopyFrom(message);
+        std::vector<const FieldDescriptor*> fields{};
+        reflection->ListFields(*prefix, &fields);
+        for(const FieldDescriptor* other : fields)
+        {
+            if(other->number() > number || (other == field && !field->is_repeated()))
+            {
+                reflection->ClearField(prefix.get(), other);
+            }
+        }
+        while(field->is_repeated() && reflection->FieldSize(*prefix, field) > index)
+        {
+            reflection->RemoveLast(prefix.get(), field);
+        }
+        return prefix->ByteSizeLong() + varintSize(static_cast<uint64_t>(number) << 3) + varintSize(contentSize);
+    }
+}
+
+rogue::driver::PreparedSearch::PreparedSearch(
+    const rogue::services::Search& search,
+    const std::vector<Parameter>& parameters)
+{
+    rogue::services::Search prepared{ search };
+    m_parameters.resize(parameters.size());
+
+    // Parameters of one operand share its value, so they are gathered before rewriting it.
+    std::map<google::protobuf::Any*, std::vector<uint64_t>> operands{};
+    std::vector<google::protobuf::Any*> locations(parameters.size());
+    for(uint64_t index{ 0 }; index < parameters.size(); ++index)
+    {
+        const Parameter& parameter{ parameters[index] };
+        if(parameter.expression.empty())
+        {
+            throw std::invalid_argument{ "A parameter needs the index of its query." };
+        }
+        rogue::services::Query* query{ prepared.mutable_queries(parameter.expression[0]) };
+        for(uint64_t depth{ 1 }; depth < parameter.expression.size(); ++depth)
+        {
+            query = query->mutable_complex()->mutable_expressions(parameter.expression[depth]);
+        }
+        google::protobuf::Any* operand{ query->mutable_basic()->mutable_operands(parameter.operand) };
+        operands[operand].push_back(index);
+        locations[index] = operand;
+    }
+
+    // An operand's value becomes its parameters, each tag followed by a placeholder, then
+    // every other field as packed.
+    std::vector<uint64_t> valueOffsets(parameters.size());
+    for(auto& [operand, indices] : operands)
+    {
+        const std::string typeName{ operand->type_url().substr(operand->type_url().rfind('/') + 1) };
+        const google::protobuf::Descriptor* descriptor{
+            google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName(typeName) };
+        if(descriptor == nullptr)
+        {
+            throw std::invalid_argument{ std::format("Unknown operand type: {}", operand->type_url()) };
+        }
+        std::unique_ptr<google::protobuf::Message> rest{
+            google::protobuf::MessageFactory::generated_factory()->GetPrototype(descriptor)->New() };
+        if(!rest->ParseFromString(operand->value()))
+        {
+            throw std::invalid_argument{ std::format("Operand is not a valid {}.", typeName) };
+        }
+
+        std::string value{};
+        for(const uint64_t index : indices)
+        {
+            const FieldDescriptor* field{ descriptor->FindFieldByNumber(parameters[index].field) };
+            if(field == nullptr || field->is_repeated())
+            {
+                throw std::invalid_argument{ std::format("{} has no scalar field {}.", typeName, parameters[index].field) };
+            }
+            Slot& slot{ m_parameters[index] };
+            uint32_t wireType{ 0 };
+            uint64_t width{ VARINT_BYTES };
+            switch(field->type())
+            {
+                case FieldDescriptor::TYPE_INT32:
+                case FieldDescriptor::TYPE_INT64:
+                case FieldDescriptor::TYPE_UINT32:
+                case FieldDescriptor::TYPE_UINT64:
+                case FieldDescriptor::TYPE_BOOL:
+                case FieldDescriptor::TYPE_ENUM:
+                    slot.encoding = Encoding::VARINT;
+                    break;
+                case FieldDescriptor::TYPE_SINT32:
+                case FieldDescriptor::TYPE_SINT64:
+                    slot.encoding = Encoding::ZIGZAG;
+                    break;
+                case FieldDescriptor::TYPE_FIXED32:
+                case FieldDescriptor::TYPE_SFIXED32:
+                    slot.encoding = Encoding::FIXED32;
+                    wireType = 5;
+                    width = 4;
+                    break;
+                case FieldDescriptor::TYPE_FIXED64:
+                case FieldDescriptor::TYPE_SFIXED64:
+                    slot.encoding = Encoding::FIXED64;
+                    wireType = 1;
+                    width = 8;
+                    break;
+                default:
+                    throw std::invalid_argument{ std::format("{}.{} is not an integer field.", typeName, field->name()) };
+            }
+            rest->GetReflection()->ClearField(rest.get(), field);
+            writeVarint(value, (static_cast<uint64_t>(field->number()) << 3) | wireType);
+            valueOffsets[index] = value.size();
+            value.append(width, '\0');
+        }
+        value += rest->SerializeAsString();
+        operand->set_value(std::move(value));
+    }
+
+    // Offsets are taken once every operand has its final size.
+    m_bytes = prepared.SerializeAsString();
+    for(uint64_t index{ 0 }; index < parameters.size(); ++index)
+    {
+        const Parameter& parameter{ parameters[index] };
+        uint64_t offset{ contentOffset(prepared, rogue::services::Search::kQueriesFieldNumber, parameter.expression[0]) };
+        const rogue::services::Query* query{ &prepared.queries(parameter.expression[0]) };
+        for(uint64_t depth{ 1 }; depth < parameter.expression.size(); ++depth)
+        {
+            offset += contentOffset(*query, rogue::services::Query::kComplexFieldNumber);
+            offset += contentOffset(query->complex(), rogue::services::Complex::kExpressionsFieldNumber, parameter.expression[depth]);
+            query = &query->complex().expressions(parameter.expression[depth]);
+        }
+        offset += contentOffset(*query, rogue::services::Query::kBasicFieldNumber);
+        offset += contentOffset(query->basic(), rogue::services::Basic::kOperandsFieldNumber, parameter.operand);
+        offset += contentOffset(*locations[index], google::protobuf::Any::kValueFieldNumber);
+        m_parameters[index].offset = offset + valueOffsets[index];
+        set(index, 0);
+    }
+}
+
+void rogue::driver::PreparedSearch::set(const uint64_t parameter, const uint64_t value)
+{
+    const Slot& slot{ m_parameters[parameter] };
+    char* destination{ m_bytes.data() + slot.offset };
+    switch(slot.encoding)
+    {
+        case Encoding::FIXED32:
+        case Encoding::FIXED64:
+        {
+            const uint64_t width{ slot.encoding == Encoding::FIXED32 ? uint64_t{4} : uint64_t{8} };
+            for(uint64_t index{ 0 }; index < width; ++index)
+            {
+                destination[index] = static_cast<char>((value >> (8 * index)) & 0xFF);
+            }
+            return;
+        }
+        case Encoding::ZIGZAG:
+        case Encoding::VARINT:
+        {
+            uint64_t remaining{ slot.encoding == Encoding::ZIGZAG
+                ? (value << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(value) >> 63)
+                : value };
+            // Continuation bits on all but the last byte, which only holds bit 63.
+            for(uint64_t index{ 0 }; index < VARINT_BYTES - 1; ++index)
+            {
+                destination[index] = static_cast<char>((remaining & 0x7F) | 0x80);
+                remaining >>= 7;
+            }
+            destination[VARINT_BYTES - 1] = static_cast<char>(remaining & 0x01);
+            return;
+        }
+    }
+}
+
+grpc::ByteBuffer rogue::driver::PreparedSearch::buffer() const
+{
+    const grpc::Slice slice{ m_bytes.data(), m_bytes.size() };
+    return grpc::ByteBuffer{ &slice, 1 };
+}
+
+std::unique_ptr<rogue::driver::SearchStream> rogue::driver::searchStream(
+    grpc::ChannelInterface& channel,
+    grpc::ClientContext& context)
+{
+    return std::unique_ptr<SearchStream>{
+        grpc::internal::ClientReaderWriterFactory<grpc::ByteBuffer, rogue::services::Response>::Create(
+            &channel,
+            grpc::internal::RpcMethod{ SEARCH_METHOD, grpc::internal::RpcMethod::BIDI_STREAMING },
+            &context) };
+}
@@ -0,0 +1,72 @@
+#ifndef PREPARED_SEARCH_H
+#define PREPARED_SEARCH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <grpcpp/grpcpp.h>
+
+#include "getting_started/roguedb.grpc.pb.h"
+
+namespace rogue
+{
+    namespace driver
+    {
+        // A value of a prepared search. expression indexes Search.queries first, then the
+        // expressions of each Complex below it, and must end at a Basic. operand indexes that
+        // Basic's operands and field is the number of the operand's field that changes.
+        struct Parameter
+        {
+            std::vector<int> expression;
+            int operand;
+            int field;
+        };
+
+        // A Search serialized once. Per request only the parameters are written into the
+        // cached wire bytes, instead of packing every operand and serializing the whole
+        // Search again. Every other field, including the api key, stays as prepared.
+        //
+        // Parameters must be scalar integer, bool, or enum fields. Varints are written ten
+        // bytes wide, which parsers accept for any value, so no length around them changes.
+        class PreparedSearch
+        {
+        public:
+            // Operands holding parameters must already be packed with their message type.
+            PreparedSearch(const rogue::services::Search& search, const std::vector<Parameter>& parameters);
+
+            // Two's complement for signed fields, eg. static_cast<uint64_t>(-1).
+            void set(const uint64_t parameter, const uint64_t value);
+            uint64_t parameters() const { return m_parameters.size(); }
+
+            const std::string& bytes() const { return m_bytes; }
+            // A copy of the bytes, ready for SearchStream::Write.
+            grpc::ByteBuffer buffer() const;
+
+        private:
+            enum class Encoding
+            {
+                VARINT,
+                ZIGZAG,
+                FIXED32,
+                FIXED64
+            };
+
+            struct Slot
+            {
+                uint64_t offset;
+                Encoding encoding;
+            };
+
+            std::string m_bytes{};
+            std::vector<Slot> m_parameters{};
+        };
+
+        // The search stream of a RogueDB channel, written with serialized Searches such as
+        // PreparedSearch::buffer. Responses are parsed as usual.
+        using SearchStream = grpc::ClientReaderWriter<grpc::ByteBuffer, rogue::services::Response>;
+        std::unique_ptr<SearchStream> searchStream(grpc::ChannelInterface& channel, grpc::ClientContext& context);
+    }
+}
+
+#endif //PREPARED_SEARCH_H
@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <string_view>
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/wire_format_lite.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/support/sync_stream.h>
+
+#include "roguedb_driver/cpp/result_reader.h"
+
+namespace
+{
+    constexpr char SEARCH_METHOD[]{ "/rogue.services.RogueDB/search" };
+
+    using CodedInputStream = google::protobuf::io::CodedInputStream;
+
+    constexpr uint32_t VARINT{ 0 };
+    constexpr uint32_t FIXED64{ 1 };
+    constexpr uint32_t LENGTH_DELIMITED{ 2 };
+    constexpr uint32_t FIXED32{ 5 };
+
+    constexpr uint32_t makeTag(const int number, const uint32_t wireType)
+    {
+        return (static_cast<uint32_t>(number) << 3) | wireType;
+    }
+
+    constexpr uint32_t RESULTS_TAG{ makeTag(rogue::services::Response::kResultsFieldNumber, LENGTH_DELIMITED) };
+    // Map entries are messages of a key field 1 and a value field 2.
+    constexpr uint32_t ENTRY_KEY_TAG{ makeTag(1, VARINT) };
+    constexpr uint32_t ENTRY_VALUE_TAG{ makeTag(2, LENGTH_DELIMITED) };
+    constexpr uint32_t MESSAGE_TAG{ makeTag(rogue::services::Messages::kMessagesFieldNumber, LENGTH_DELIMITED) };
+    constexpr uint32_t TYPE_URL_TAG{ makeTag(google::protobuf::Any::kTypeUrlFieldNumber, LENGTH_DELIMITED) };
+    constexpr uint32_t VALUE_TAG{ makeTag(google::protobuf::Any::kValueFieldNumber, LENGTH_DELIMITED) };
+
+    void writeVarint(std::string& destination, uint64_t value)
+    {
+        while(value >= 0x80)
+        {
+            destination.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        destination.push_back(static_cast<char>(value));
+    }
+
+    bool skipField(CodedInputStream& input, const uint32_t tag)
+    {
+        return google::protobuf::internal::WireFormatLite::SkipField(&input, tag);
+    }
+
+    // Appends one field as read, tag included, so the kept fields can be parsed on their own.
+    bool copyField(CodedInputStream& input, const uint32_t tag, std::string& destination)
+    {
+        uint32_t width{ 0 };
+        switch(tag & 7)
+        {
+            case VARINT:
+            {
+                uint64_t value{ 0 };
+                if(!input.ReadVarint64(&value))
+                {
+                    return false;
+                }
+                writeVarint(destination, tag);
+                writeVarint(destination, value);
+                return true;
+            }
+            case FIXED64:
+                width = 8;
+                break;
+            case FIXED32:
+                width = 4;
+                break;
+            case LENGTH_DELIMITED:
+                if(!input.ReadVarint32(&width))
+                {
+                    return false;
+                }
+                writeVarint(destination, tag);
+                writeVarint(destination, width);
+                break;
+            default:
+                return false;
+        }
+        if((tag & 7) != LENGTH_DELIMITED)
+        {
+            writeVarint(destination, tag);
+        }
+        const uint64_t offset{ destination.size() };
+        destination.resize(offset + width);
+        return input.ReadRaw(destination.data() + offset, static_cast<int>(width));
+    }
+}
+
+rogue::driver::ResultReader::ResultReader(Stream& stream, google::protobuf::Message& row, const uint64_t queries, std::vector<int> fields) :
+    m_stream{ stream },
+    m_row{ row },
+    m_typeName{ row.GetDescriptor()->full_name() },
+    m_queries{ queries },
+    m_fields{ std::move(fields) },
+    m_done{ queries == 0 }
+{}
+
+bool rogue::driver::ResultReader::next()
+{
+    while(!m_done)
+    {
+        if(m_inMessages)
+        {
+            CodedInputStream& input{ m_entry ? *m_entry : *m_input };
+            if(readRow(input))
+            {
+                return true;
+            }
+            if(m_done)
+            {
+                return false;
+            }
+            input.PopLimit(m_messagesLimit);
+            m_inMessages = false;
+        }
+        else if(m_inEntry)
+        {
+            CodedInputStream& input{ m_entry ? *m_entry : *m_input };
+            const uint32_t tag{ input.ReadTag() };
+            uint32_t length{ 0 };
+            if(tag == ENTRY_VALUE_TAG)
+            {
+                if(!input.ReadVarint32(&length))
+                {
+                    return fail();
+                }
+                m_messagesLimit = input.PushLimit(static_cast<int>(length));
+                m_inMessages = true;
+            }
+            else if(tag == 0)
+            {
+                if(!input.ConsumedEntireMessage())
+                {
+                    return fail();
+                }
+                if(m_entry)
+                {
+                    m_entry.reset();
+                }
+                else
+                {
+                    m_input->PopLimit(m_entryLimit);
+                }
+                m_inEntry = false;
+            }
+            else if(!skipField(input, tag))
+            {
+                return fail();
+            }
+        }
+        else if(m_input)
+        {
+            const uint32_t tag{ m_input->ReadTag() };
+            if(tag == RESULTS_TAG)
+            {
+                if(!openEntry())
+                {
+                    return fail();
+                }
+            }
+            else if(tag >> 3 == rogue::services::Response::kFinishedFieldNumber)
+            {
+                if(!readFinished(tag))
+                {
+                    return fail();
+                }
+            }
+            else if(tag == 0)
+            {
+                if(!m_input->ConsumedEntireMessage())
+                {
+                    return fail();
+                }
+                release();
+                m_done = m_finished >= m_queries;
+            }
+            else if(!skipField(*m_input, tag))
+            {
+                return fail();
+            }
+        }
+        else if(!receive())
+        {
+            m_status = grpc::Status{ grpc::StatusCode::UNAVAILABLE, "Search stream ended before its queries finished." };
+            m_done = true;
+        }
+    }
+    return false;
+}
+
+bool rogue::driver::ResultReader::receive()
+{
+    if(!m_stream.Read(&m_response))
+    {
+        return false;
+    }
+    m_bytes.emplace(&m_response);
+    m_input.emplace(&*m_bytes);
+    return true;
+}
+
+void rogue::driver::ResultReader::release()
+{
+    m_entry.reset();
+    m_input.reset();
+    m_bytes.reset();
+    m_response.Clear();
+    m_inEntry = false;
+    m_inMessages = false;
+}
+
+// The query id of an entry comes first as protobuf writes it, and is checked on the next byte
+// without consuming anything.
+bool rogue::driver::ResultReader::openEntry()
+{
+    uint32_t length{ 0 };
+    if(!m_input->ReadVarint32(&length))
+    {
+        return false;
+    }
+    m_query = 0;
+    const void* data{ nullptr };
+    int size{ 0 };
+    if(length > 0 && m_input->GetDirectBufferPointer(&data, &size) && *static_cast<const uint8_t*>(data) == ENTRY_KEY_TAG)
+    {
+        m_entryLimit = m_input->PushLimit(static_cast<int>(length));
+        m_inEntry = m_input->ReadTag() == ENTRY_KEY_TAG && m_input->ReadVarint64(&m_query);
+        return m_inEntry;
+    }
+
+    if(!m_input->ReadString(&m_entryBytes, static_cast<int>(length)))
+    {
+        return false;
+    }
+    const auto* bytes{ reinterpret_cast<const uint8_t*>(m_entryBytes.data()) };
+    CodedInputStream scan{ bytes, static_cast<int>(m_entryBytes.size()) };
+    for(uint32_t tag{ scan.ReadTag() }; tag != 0; tag = scan.ReadTag())
+    {
+        if(!(tag == ENTRY_KEY_TAG ? scan.ReadVarint64(&m_query) : skipField(scan, tag)))
+        {
+            return false;
+        }
+    }
+    m_entry.emplace(bytes, static_cast<int>(m_entryBytes.size()));
+    m_inEntry = true;
+    return scan.ConsumedEntireMessage();
+}
+
+// Returns false at the end of the current Messages, or when a result is malformed.
+bool rogue::driver::ResultReader::readRow(CodedInputStream& input)
+{
+    while(true)
+    {
+        const uint32_t tag{ input.ReadTag() };
+        if(tag == 0)
+        {
+            if(!input.ConsumedEntireMessage())
+            {
+                fail();
+            }
+            return false;
+        }
+        if(tag != MESSAGE_TAG)
+        {
+            if(!skipField(input, tag))
+            {
+                return fail();
+            }
+            continue;
+        }
+
+        uint32_t length{ 0 };
+        if(!input.ReadVarint32(&length))
+        {
+            return fail();
+        }
+        const CodedInputStream::Limit limit{ input.PushLimit(static_cast<int>(length)) };
+        m_typeUrl.clear();
+        m_row.Clear();
+        bool hasTypeUrl{ false };
+        bool buffered{ false };
+        bool parsed{ false };
+        for(uint32_t field{ input.ReadTag() }; field != 0; field = input.ReadTag())
+        {
+            uint32_t size{ 0 };
+            bool read{ false };
+            if(field == TYPE_URL_TAG)
+            {
+                read = input.ReadVarint32(&size) && input.ReadString(&m_typeUrl, static_cast<int>(size));
+                hasTypeUrl = read;
+            }
+            else if(field == VALUE_TAG && !hasTypeUrl)
+            {
+                read = input.ReadVarint32(&size) && input.ReadString(&m_value, static_cast<int>(size));
+                buffered = read;
+            }
+            else if(field == VALUE_TAG && typed())
+            {
+                read = input.ReadVarint32(&size) && parseValue(input, size);
+                parsed = read;
+            }
+            else
+            {
+                read = skipField(input, field);
+            }
+            if(!read)
+            {
+                return fail();
+            }
+        }
+        if(!input.ConsumedEntireMessage())
+        {
+            return fail();
+        }
+        input.PopLimit(limit);
+
+        if(!typed())
+        {
+            continue;
+        }
+        if(buffered && !parsed)
+        {
+            CodedInputStream value{ reinterpret_cast<const uint8_t*>(m_value.data()), static_cast<int>(m_value.size()) };
+            if(!parseValue(value, static_cast<uint32_t>(m_value.size())))
+            {
+                return fail();
+            }
+        }
+        return true;
+    }
+}
+
+// Whether the type_url of the current result names the row's type. Rows of other types are
+// skipped without parsing their value, as their fields may not match the row's.
+bool rogue::driver::ResultReader::typed() const
+{
+    const std::string_view typeUrl{ m_typeUrl };
+    return typeUrl.substr(typeUrl.rfind('/') + 1) == m_typeName;
+}
+
+// Parses in place from the received bytes, unless only some fields are kept. Those are copied
+// out first and parsed together, which only costs their own bytes.
+bool rogue::driver::ResultReader::parseValue(CodedInputStream& input, const uint32_t length)
+{
+    const CodedInputStream::Limit limit{ input.PushLimit(static_cast<int>(length)) };
+    bool parsed{ true };
+    if(m_fields.empty())
+    {
+        parsed = m_row.MergePartialFromCodedStream(&input) && input.ConsumedEntireMessage();
+    }
+    else
+    {
+        m_partial.clear();
+        for(uint32_t tag{ input.ReadTag() }; tag != 0 && parsed; tag = input.ReadTag())
+        {
+            parsed = std::find(m_fields.begin(), m_fields.end(), static_cast<int>(tag >> 3)) == m_fields.end()
+                ? skipField(input, tag)
+                : copyField(input, tag, m_partial);
+        }
+        parsed = parsed && input.ConsumedEntireMessage()
+            && m_row.ParsePartialFromArray(m_partial.data(), static_cast<int>(m_partial.size()));
+    }
+    input.PopLimit(limit);
+    return parsed;
+}
+
+bool rogue::driver::ResultReader::readFinished(const uint32_t tag)
+{
+    uint64_t id{ 0 };
+    if((tag & 7) == VARINT)
+    {
+        m_finished += 1;
+        return m_input->ReadVarint64(&id);
+    }
+    uint32_t length{ 0 };
+    if((tag & 7) != LENGTH_DELIMITED || !m_input->ReadVarint32(&length))
+    {
+        return false;
+    }
+    const CodedInputStream::Limit limit{ m_input->PushLimit(static_cast<int>(length)) };
+    while(m_input->BytesUntilLimit() > 0)
+    {
+        if(!m_input->ReadVarint64(&id))
+        {
+            return false;
+        }
+        m_finished += 1;
+    }
+    m_input->PopLimit(limit);
+    return true;
+}
+
+bool rogue::driver::ResultReader::fail()
+{
+    m_status = grpc::Status{ grpc::StatusCode::INTERNAL, "Malformed search response." };
+    m_done = true;
+    release();
+    return false;
+}
+
+std::unique_ptr<rogue::driver::ResultStream> rogue::driver::resultStream(
+    grpc::ChannelInterface& channel,
+    grpc::ClientContext& context)
+{
+    return std::unique_ptr<ResultStream>{
+        grpc::internal::ClientReaderWriterFactory<rogue::services::Search, grpc::ByteBuffer>::Create(
+            &channel,
+            grpc::internal::RpcMethod{ SEARCH_METHOD, grpc::internal::RpcMethod::BIDI_STREAMING },
+            &context) };
+}
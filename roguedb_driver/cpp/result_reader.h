@@ -0,0 +1,160 @@
+#ifndef RESULT_READER_H
+#define RESULT_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <google/protobuf/message.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/support/proto_buffer_reader.h>
+
+#include "getting_started/roguedb.grpc.pb.h"
+
+namespace rogue
+{
+    namespace driver
+    {
+        // Reads the results of one written Search as rows of a single type, straight from the
+        // received Response bytes. No Response, Any, or value string is built: each Any's value
+        // is parsed into the same row object in place, so only the Response being read is held
+        // and it is released before the next one is received. Rows whose Any holds another
+        // type are skipped.
+        //
+        // With fields, only those top-level fields of the row are parsed, eg. its index fields,
+        // and the rest are skipped over on the wire.
+        class ResultReader
+        {
+        public:
+            using Stream = grpc::internal::ReaderInterface<grpc::ByteBuffer>;
+
+            // queries is the number of queries of the Search, which is read until all of them
+            // are finished. row receives each result in turn.
+            ResultReader(Stream& stream, google::protobuf::Message& row, const uint64_t queries, std::vector<int> fields = {});
+            ResultReader(const ResultReader&) = delete;
+            ResultReader& operator=(const ResultReader&) = delete;
+
+            // Parses the next result into the row. False once every query finished, or when the
+            // stream ended early or a Response was malformed, see status.
+            bool next();
+            // Query id of the current row.
+            uint64_t query() const { return m_query; }
+            uint64_t finished() const { return m_finished; }
+            // UNAVAILABLE when the stream ended before every query finished. Finish the stream
+            // for the status the server closed it with.
+            const grpc::Status& status() const { return m_status; }
+
+        private:
+            bool receive();
+            void release();
+            bool openEntry();
+            bool readRow(google::protobuf::io::CodedInputStream& input);
+            bool parseValue(google::protobuf::io::CodedInputStream& input, const uint32_t length);
+            bool typed() const;
+            bool readFinished(const uint32_t tag);
+            bool fail();
+
+            Stream& m_stream;
+            google::protobuf::Message& m_row;
+            const std::string m_typeName;
+            const uint64_t m_queries;
+            const std::vector<int> m_fields;
+
+            grpc::ByteBuffer m_response{};
+            // Declared after the buffer they read, so they are destroyed first.
+            std::optional<grpc::ProtoBufferReader> m_bytes{};
+            std::optional<google::protobuf::io::CodedInputStream> m_input{};
+            // A map entry with its value written before its key is copied here, as its query
+            // id is only known at its end.
+            std::string m_entryBytes{};
+            std::optional<google::protobuf::io::CodedInputStream> m_entry{};
+            google::protobuf::io::CodedInputStream::Limit m_entryLimit{};
+            google::protobuf::io::CodedInputStream::Limit m_messagesLimit{};
+            bool m_inEntry{ false };
+            bool m_inMessages{ false };
+
+            std::string m_typeUrl{};
+            // A value written before its type_url is copied here, as its type is only known
+            // once the Any ends.
+            std::string m_value{};
+            std::string m_partial{};
+            uint64_t m_query{ 0 };
+            uint64_t m_finished{ 0 };
+            bool m_done{ false };
+            grpc::Status m_status{ grpc::Status::OK };
+        };
+
+        // A range over a ResultReader of Row, eg.
+        //
+        //     stream->Write(search);
+        //     rogue::driver::Results<rogue::services::Test> results{ *stream, search.queries_size() };
+        //     for(const rogue::services::Test& row : results) { ... results.query() ... }
+        //
+        // Each row is only valid until the iterator advances. Iterate once.
+        template<typename Row>
+        class Results
+        {
+        public:
+            class Iterator
+            {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = Row;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const Row*;
+                using reference = const Row&;
+
+                Iterator() = default;
+                explicit Iterator(Results* results) :
+                    m_results{ results }
+                {
+                    ++*this;
+                }
+
+                reference operator*() const { return m_results->m_row; }
+                pointer operator->() const { return &m_results->m_row; }
+                Iterator& operator++()
+                {
+                    if(!m_results->m_reader.next())
+                    {
+                        m_results = nullptr;
+                    }
+                    return *this;
+                }
+                void operator++(int) { ++*this; }
+                bool operator==(std::default_sentinel_t) const { return m_results == nullptr; }
+
+            private:
+                Results* m_results{ nullptr };
+            };
+
+            Results(ResultReader::Stream& stream, const uint64_t queries, std::vector<int> fields = {}) :
+                m_reader{ stream, m_row, queries, std::move(fields) }
+            {}
+
+            Results(const Results&) = delete;
+            Results& operator=(const Results&) = delete;
+
+            Iterator begin() { return Iterator{ this }; }
+            std::default_sentinel_t end() const { return {}; }
+
+            uint64_t query() const { return m_reader.query(); }
+            const grpc::Status& status() const { return m_reader.status(); }
+
+        private:
+            Row m_row{};
+            ResultReader m_reader;
+        };
+
+        // The search stream of a RogueDB channel, read as serialized Responses for a ResultReader.
+        // Searches are written as usual.
+        using ResultStream = grpc::ClientReaderWriter<rogue::services::Search, grpc::ByteBuffer>;
+        std::unique_ptr<ResultStream> resultStream(grpc::ChannelInterface& channel, grpc::ClientContext& context);
+    }
+}
+
+#endif //RESULT_READER_H
@@ -0,0 +1,93 @@
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/io/coded_stream.h>
+
+#include "getting_started/roguedb.pb.h"
+#include "roguedb_driver/cpp/row_encoder.h"
+
+namespace
+{
+    using CodedOutputStream = google::protobuf::io::CodedOutputStream;
+
+    constexpr uint32_t LENGTH_DELIMITED{ 2 };
+    // PackFrom's prefix.
+    constexpr char TYPE_URL_PREFIX[]{ "type.googleapis.com/" };
+
+    constexpr uint32_t makeTag(const int number)
+    {
+        return (static_cast<uint32_t>(number) << 3) | LENGTH_DELIMITED;
+    }
+
+    constexpr uint32_t API_KEY_TAG{ makeTag(rogue::services::Insert::kApiKeyFieldNumber) };
+    constexpr uint32_t MESSAGES_TAG{ makeTag(rogue::services::Insert::kMessagesFieldNumber) };
+    constexpr uint32_t TYPE_URL_TAG{ makeTag(google::protobuf::Any::kTypeUrlFieldNumber) };
+    constexpr uint32_t VALUE_TAG{ makeTag(google::protobuf::Any::kValueFieldNumber) };
+
+    // Bytes of a length delimited field with a one byte tag. Empty fields are left out, as
+    // proto3 serializes them.
+    uint64_t fieldSize(const uint64_t size)
+    {
+        return size == 0 ? 0 : 1 + CodedOutputStream::VarintSize64(size) + size;
+    }
+
+    uint8_t* writeHeader(const uint32_t tag, const uint64_t size, uint8_t* target)
+    {
+        target = CodedOutputStream::WriteTagToArray(tag, target);
+        return CodedOutputStream::WriteVarint64ToArray(size, target);
+    }
+}
+
+rogue::driver::RowEncoder::RowEncoder(const std::string& apiKey)
+{
+    if(!apiKey.empty())
+    {
+        m_header.resize(fieldSize(apiKey.size()));
+        auto* target{ reinterpret_cast<uint8_t*>(m_header.data()) };
+        target = writeHeader(API_KEY_TAG, apiKey.size(), target);
+        CodedOutputStream::WriteStringToArray(apiKey, target);
+    }
+    m_bytes = m_header;
+}
+
+void rogue::driver::RowEncoder::add(const google::protobuf::Message& row)
+{
+    if(row.GetDescriptor() != m_type)
+    {
+        m_type = row.GetDescriptor();
+        m_typeUrl = TYPE_URL_PREFIX;
+        m_typeUrl += m_type->full_name();
+    }
+
+    // Sizes are cached in the row, so serializing below does not compute them again.
+    const uint64_t rowSize{ row.ByteSizeLong() };
+    const uint64_t anySize{ fieldSize(m_typeUrl.size()) + fieldSize(rowSize) };
+    const uint64_t offset{ m_bytes.size() };
+    m_bytes.resize(offset + 1 + CodedOutputStream::VarintSize64(anySize) + anySize);
+
+    auto* target{ reinterpret_cast<uint8_t*>(m_bytes.data() + offset) };
+    target = writeHeader(MESSAGES_TAG, anySize, target);
+    target = writeHeader(TYPE_URL_TAG, m_typeUrl.size(), target);
+    target = CodedOutputStream::WriteStringToArray(m_typeUrl, target);
+    if(rowSize > 0)
+    {
+        target = writeHeader(VALUE_TAG, rowSize, target);
+        row.SerializeWithCachedSizesToArray(target);
+    }
+    ++m_messages;
+}
+
+grpc::ByteBuffer rogue::driver::RowEncoder::release()
+{
+    auto* bytes{ new std::string{ std::move(m_bytes) } };
+    const grpc::Slice slice{ bytes->data(), bytes->size(), [](void* owner){ delete static_cast<std::string*>(owner); }, bytes };
+    m_bytes.clear();
+    m_bytes.reserve(bytes->size());
+    m_bytes = m_header;
+    m_messages = 0;
+    return grpc::ByteBuffer{ &slice, 1 };
+}
+
+void rogue::driver::RowEncoder::clear()
+{
+    m_bytes = m_header;
+    m_messages = 0;
+}
@@ -0,0 +1,46 @@
+#ifndef ROW_ENCODER_H
+#define ROW_ENCODER_H
+
+#include <cstdint>
+#include <string>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include <grpcpp/grpcpp.h>
+
+namespace rogue
+{
+    namespace driver
+    {
+        // Serializes typed rows into the wire bytes of an Insert, Update, or Remove, which
+        // share their layout. PackFrom serializes each row into a string of its Any, and
+        // serializing the request copies that string again. add sizes the row once and writes
+        // its Any framing and fields straight into the request bytes instead, which release
+        // hands to gRPC without a copy. The bytes match a request built with PackFrom.
+        class RowEncoder
+        {
+        public:
+            explicit RowEncoder(const std::string& apiKey);
+            RowEncoder(const RowEncoder&) = delete;
+            RowEncoder& operator=(const RowEncoder&) = delete;
+
+            void add(const google::protobuf::Message& row);
+            // The request as a ByteBuffer for Client::insert, update, or remove. The encoder
+            // starts over with the same api key and the capacity of this request.
+            grpc::ByteBuffer release();
+            void clear();
+
+            uint64_t messages() const { return m_messages; }
+            uint64_t size() const { return m_bytes.size(); }
+            const std::string& bytes() const { return m_bytes; }
+
+        private:
+            std::string m_header{};
+            std::string m_bytes{};
+            uint64_t m_messages{ 0 };
+            const google::protobuf::Descriptor* m_type{ nullptr };
+            std::string m_typeUrl{};
+        };
+    }
+}
+
+#endif //ROW_ENCODER_H